@@ -0,0 +1,112 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "BipartiteComponents.hpp"
+
+namespace Algorithms
+{
+    BipartiteComponents::BipartiteComponents(int rows, int cols) : 
+        mRows(rows), 
+        mCols(cols),
+        mParent(rows + cols)
+    {
+        for(int n = 0; n < rows + cols; ++n)
+        {
+            this->mParent[n] = n;
+        }
+    }
+    
+    int BipartiteComponents::find(int node)
+    {
+        // path halving
+        while(this->mParent[node] != node)
+        {
+            this->mParent[node] = this->mParent[this->mParent[node]];
+            node = this->mParent[node];
+        }
+        return node;
+    }
+    
+    void BipartiteComponents::addEdge(int row, int col)
+    {
+        if(row < 0 || row >= this->mRows || col < 0 || col >= this->mCols)
+        {
+            return;
+        }
+        
+        int a = this->find(row);
+        int b = this->find(this->mRows + col);
+        if(a != b)
+        {
+            // the smaller node becomes the root, thus a row is the root of every component containing a row
+            if(a < b)
+            {
+                this->mParent[b] = a;
+            }
+            else
+            {
+                this->mParent[a] = b;
+            }
+        }
+    }
+    
+    void BipartiteComponents::compute()
+    {
+        this->mComponentRows.clear();
+        this->mComponentCols.clear();
+        
+        std::vector<int> componentOfRoot(this->mRows, -1);
+        
+        for(int r = 0; r < this->mRows; ++r)
+        {
+            int root = this->find(r);
+            if(componentOfRoot[root] < 0)
+            {
+                componentOfRoot[root] = static_cast<int>(this->mComponentRows.size());
+                this->mComponentRows.push_back(std::vector<int>());
+                this->mComponentCols.push_back(std::vector<int>());
+            }
+            this->mComponentRows[componentOfRoot[root]].push_back(r);
+        }
+        
+        for(int c = 0; c < this->mCols; ++c)
+        {
+            int root = this->find(this->mRows + c);
+            // columns without any row are skipped
+            if(root < this->mRows)
+            {
+                this->mComponentCols[componentOfRoot[root]].push_back(c);
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef BIPARTITECOMPONENTS_HPP
+#define BIPARTITECOMPONENTS_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace Algorithms
+{
+    /**
+     * @brief The BipartiteComponents class splits a bipartite graph (e.g. the assignable pairs of an assignment problem)
+     *        into its connected components using a union-find structure.
+     *
+     * Since no edge connects two components, an assignment problem can be solved for every component independently and
+     * the union of the solutions is optimal for the whole problem. Only components containing at least one row are
+     * reported; they are ordered by their smallest row and their rows and columns are sorted in ascending order.
+     */
+    class BipartiteComponents
+    {
+    public:
+        /**
+         * @brief BipartiteComponents creates a graph without edges
+         * @param rows number of rows
+         * @param cols number of columns
+         */
+        BipartiteComponents(int rows, int cols);
+        
+        /**
+         * @brief addEdge connects a row and a column (out of range indices are ignored)
+         */
+        void addEdge(int row, int col);
+        
+        /**
+         * @brief compute collects the connected components (must be called after adding all edges)
+         */
+        void compute();
+        
+        std::size_t getNumberOfComponents() const {return this->mComponentRows.size();}
+        std::vector<int> const& getRows(std::size_t component) const {return this->mComponentRows.at(component);}
+        std::vector<int> const& getCols(std::size_t component) const {return this->mComponentCols.at(component);}
+        
+    private:
+        int find(int node);
+        
+        int                             mRows;
+        int                             mCols;
+        
+        /**
+         * @brief mParent union-find forest over rows [0, mRows) and columns [mRows, mRows + mCols)
+         */
+        std::vector<int>                mParent;
+        
+        std::vector<std::vector<int> >  mComponentRows;
+        std::vector<std::vector<int> >  mComponentCols;
+    };
+}
+
+#endif // BIPARTITECOMPONENTS_HPP
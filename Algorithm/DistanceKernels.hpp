@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef DISTANCEKERNELS_HPP
+#define DISTANCEKERNELS_HPP
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DISTANCEKERNELS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Algorithms
+{
+    /**
+     * @brief squaredDistances computes the squared euclidean distances of n points (given as coordinate arrays) to a
+     *        center point. Four points are processed per instruction if SSE2 is available.
+     *
+     * For integer coordinates the result is exact as long as the squared distance is below 2^24.
+     *
+     * @param cx x-coordinate of the center
+     * @param cy y-coordinate of the center
+     * @param xs x-coordinates of the points
+     * @param ys y-coordinates of the points
+     * @param n number of points
+     * @param out squared distances (at least n elements; may not alias xs or ys)
+     */
+    inline void squaredDistances(float const cx, float const cy, float const* xs, float const* ys, std::size_t const n, float* out)
+    {
+        std::size_t i = 0;
+        
+#ifdef DISTANCEKERNELS_USE_SSE2
+        __m128 const vcx = _mm_set1_ps(cx);
+        __m128 const vcy = _mm_set1_ps(cy);
+        for(; i + 4 <= n; i += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vcx);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vcy);
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        }
+#endif
+        
+        for(; i < n; ++i)
+        {
+            float dx = xs[i] - cx;
+            float dy = ys[i] - cy;
+            out[i] = dx * dx + dy * dy;
+        }
+    }
+}
+
+#endif // DISTANCEKERNELS_HPP
@@ -0,0 +1,324 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "SparseLAP.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <functional>
+#include <utility>
+
+namespace Algorithms
+{
+    namespace
+    {
+        const double INF = std::numeric_limits<double>::max();
+    }
+    
+    SparseLAP::SparseLAP(int rows, int cols) : 
+        mRows(rows), 
+        mCols(cols),
+        mRowAssignment(rows, -1),
+        mColAssignment(cols, -1),
+        mRowAssignmentCost(rows, 0.0),
+        mCost(0.0),
+        mColumnPrices(cols, 0.0),
+        mSourcePotential(0.0),
+        mSinkPotential(0.0)
+    {
+    }
+    
+    void SparseLAP::addEdge(int row, int col, double cost)
+    {
+        if(row < 0 || row >= this->mRows || col < 0 || col >= this->mCols || cost != cost 
+                || std::abs(cost) == std::numeric_limits<double>::infinity())
+        {
+            return;
+        }
+        
+        Edge e;
+        e.row = row;
+        e.col = col;
+        e.cost = cost;
+        this->mEdges.push_back(e);
+    }
+    
+    void SparseLAP::buildRows()
+    {
+        // counting sort of the edges by row
+        this->mRowStart.assign(this->mRows + 1, 0);
+        for(auto const& e : this->mEdges)
+        {
+            ++this->mRowStart[e.row + 1];
+        }
+        
+        for(int i = 1; i <= this->mRows; ++i)
+        {
+            this->mRowStart[i] += this->mRowStart[i - 1];
+        }
+        
+        this->mEdgeCols.resize(this->mEdges.size());
+        this->mEdgeCosts.resize(this->mEdges.size());
+        std::vector<int> fill(this->mRowStart.begin(), this->mRowStart.end() - 1);
+        for(auto const& e : this->mEdges)
+        {
+            int k = fill[e.row]++;
+            this->mEdgeCols[k] = e.col;
+            this->mEdgeCosts[k] = e.cost;
+        }
+        
+        this->mEdges.clear();
+    }
+    
+    void SparseLAP::initPotentials()
+    {
+        // feasible potentials: every column potential is at most the cost of each of its edges (row potentials are 0)
+        std::vector<double> minColCost(this->mCols, INF);
+        for(size_t k = 0; k < this->mEdgeCols.size(); ++k)
+        {
+            minColCost[this->mEdgeCols[k]] = std::min(minColCost[this->mEdgeCols[k]], this->mEdgeCosts[k]);
+        }
+        
+        this->mRowPotentials.assign(this->mRows, 0.0);
+        this->mSourcePotential = 0.0;
+        this->mSinkPotential = INF;
+        
+        for(int j = 0; j < this->mCols; ++j)
+        {
+            // columns without edges are never reached
+            this->mColumnPrices[j] = (minColCost[j] == INF) ? 0.0 : minColCost[j];
+            if(minColCost[j] != INF)
+            {
+                this->mSinkPotential = std::min(this->mSinkPotential, this->mColumnPrices[j]);
+            }
+        }
+    }
+    
+    void SparseLAP::solve()
+    {
+        this->buildRows();
+        this->initPotentials();
+        
+        this->mRowDist.assign(this->mRows, INF);
+        this->mColDist.assign(this->mCols, INF);
+        this->mRowPred.assign(this->mRows, -1);
+        this->mColPred.assign(this->mCols, -1);
+        
+        if(!this->mEdgeCols.empty())
+        {
+            while(this->augment())
+            {
+            }
+        }
+        
+        this->mCost = 0.0;
+        for(int r = 0; r < this->mRows; ++r)
+        {
+            if(this->mRowAssignment[r] >= 0)
+            {
+                this->mCost += this->mRowAssignmentCost[r];
+            }
+        }
+    }
+    
+    bool SparseLAP::augment()
+    {
+        // nodes: rows [0, mRows), columns [mRows, mRows + mCols), sink mRows + mCols
+        typedef std::pair<double, int> HeapEntry;
+        std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry> > heap;
+        
+        int const sinkNode = this->mRows + this->mCols;
+        std::vector<double>& piRow = this->mRowPotentials;
+        std::vector<double>& piCol = this->mColumnPrices;
+        
+        // the source is connected to all unassigned rows
+        for(int i = 0; i < this->mRows; ++i)
+        {
+            if(this->mRowAssignment[i] < 0 && this->mRowStart[i] < this->mRowStart[i + 1])
+            {
+                this->mRowDist[i] = std::max(this->mSourcePotential - piRow[i], 0.0);
+                this->mRowPred[i] = -1;
+                this->mTouchedRows.push_back(i);
+                heap.push(HeapEntry(this->mRowDist[i], i));
+            }
+        }
+        
+        double sinkDist = INF;
+        int sinkPred = -1;
+        std::vector<int> finalRows;
+        std::vector<int> finalCols;
+        
+        while(!heap.empty())
+        {
+            HeapEntry top = heap.top();
+            heap.pop();
+            
+            double d = top.first;
+            int node = top.second;
+            
+            if(node == sinkNode)
+            {
+                break;
+            }
+            
+            if(node < this->mRows)
+            {
+                int i = node;
+                if(d > this->mRowDist[i])
+                {
+                    continue;
+                }
+                finalRows.push_back(i);
+                
+                // unassigned edges of row i
+                for(int k = this->mRowStart[i]; k < this->mRowStart[i + 1]; ++k)
+                {
+                    int j = this->mEdgeCols[k];
+                    if(j == this->mRowAssignment[i])
+                    {
+                        continue;
+                    }
+                    
+                    double nd = d + std::max(this->mEdgeCosts[k] + piRow[i] - piCol[j], 0.0);
+                    if(nd < this->mColDist[j])
+                    {
+                        if(this->mColDist[j] == INF)
+                        {
+                            this->mTouchedCols.push_back(j);
+                        }
+                        this->mColDist[j] = nd;
+                        this->mColPred[j] = i;
+                        heap.push(HeapEntry(nd, this->mRows + j));
+                    }
+                }
+            }
+            else
+            {
+                int j = node - this->mRows;
+                if(d > this->mColDist[j])
+                {
+                    continue;
+                }
+                finalCols.push_back(j);
+                
+                int i = this->mColAssignment[j];
+                if(i < 0)
+                {
+                    // unassigned column is connected to the sink
+                    double nd = d + std::max(piCol[j] - this->mSinkPotential, 0.0);
+                    if(nd < sinkDist)
+                    {
+                        sinkDist = nd;
+                        sinkPred = j;
+                        heap.push(HeapEntry(nd, sinkNode));
+                    }
+                }
+                else
+                {
+                    // reverse edge of the assignment
+                    double nd = d + std::max(-this->mRowAssignmentCost[i] + piCol[j] - piRow[i], 0.0);
+                    if(nd < this->mRowDist[i])
+                    {
+                        if(this->mRowDist[i] == INF)
+                        {
+                            this->mTouchedRows.push_back(i);
+                        }
+                        this->mRowDist[i] = nd;
+                        this->mRowPred[i] = j;
+                        heap.push(HeapEntry(nd, i));
+                    }
+                }
+            }
+        }
+        
+        bool const found = (sinkPred >= 0);
+        
+        if(found)
+        {
+            // potential update (shifted by -sinkDist, thus only the finalized nodes change)
+            for(int i : finalRows)
+            {
+                piRow[i] += this->mRowDist[i] - sinkDist;
+            }
+            for(int j : finalCols)
+            {
+                piCol[j] += this->mColDist[j] - sinkDist;
+            }
+            this->mSourcePotential -= sinkDist;
+            
+            // augment along the shortest path
+            int j = sinkPred;
+            while(true)
+            {
+                int i = this->mColPred[j];
+                
+                double cost = INF;
+                for(int k = this->mRowStart[i]; k < this->mRowStart[i + 1]; ++k)
+                {
+                    if(this->mEdgeCols[k] == j)
+                    {
+                        cost = std::min(cost, this->mEdgeCosts[k]);
+                    }
+                }
+                
+                this->mRowAssignment[i] = j;
+                this->mRowAssignmentCost[i] = cost;
+                this->mColAssignment[j] = i;
+                
+                if(this->mRowPred[i] < 0)
+                {
+                    break;
+                }
+                j = this->mRowPred[i];
+            }
+        }
+        
+        // reset the workspace
+        for(int i : this->mTouchedRows)
+        {
+            this->mRowDist[i] = INF;
+            this->mRowPred[i] = -1;
+        }
+        for(int j : this->mTouchedCols)
+        {
+            this->mColDist[j] = INF;
+            this->mColPred[j] = -1;
+        }
+        this->mTouchedRows.clear();
+        this->mTouchedCols.clear();
+        
+        return found;
+    }
+}
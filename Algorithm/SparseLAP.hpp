@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef SPARSELAP_HPP
+#define SPARSELAP_HPP
+
+#include <vector>
+
+namespace Algorithms
+{
+    /**
+     * @brief The SparseLAP class solves rectangular linear assignment problems on sparse cost input using successive
+     *        shortest augmenting paths (Jonker-Volgenant style, Dijkstra on reduced costs with node potentials).
+     *
+     * Only the given (row, column, cost) edges are assignable, thus gated or unassignable pairs are simply omitted.
+     * Rows and columns may differ in number and no padding is required. The solver computes a minimum cost matching
+     * among all matchings with maximal cardinality; rows (and columns) without feasible partner stay unassigned.
+     */
+    class SparseLAP
+    {
+    public:
+        /**
+         * @brief SparseLAP creates an empty problem
+         * @param rows number of rows
+         * @param cols number of columns
+         */
+        SparseLAP(int rows, int cols);
+        
+        /**
+         * @brief addEdge adds an assignable pair (must be called before solve)
+         * @param row row index
+         * @param col column index
+         * @param cost cost of assigning row to col (non-finite costs are ignored, i.e. unassignable)
+         */
+        void addEdge(int row, int col, double cost);
+        
+        /**
+         * @brief solve computes the assignment
+         */
+        void solve();
+        
+        /**
+         * @brief getAssignedColumn
+         * @param row row index
+         * @return column assigned to row, -1 if the row is unassigned
+         */
+        int getAssignedColumn(int row) const {return this->mRowAssignment.at(row);}
+        
+        std::vector<int> const& getRowAssignment() const {return this->mRowAssignment;}
+        std::vector<double> const& getColumnPrices() const {return this->mColumnPrices;}
+        double getCost() const {return this->mCost;}
+        
+    private:
+        struct Edge
+        {
+            int row;
+            int col;
+            double cost;
+        };
+        
+        void buildRows();
+        void initPotentials();
+        bool augment();
+        
+        int                     mRows;
+        int                     mCols;
+        std::vector<Edge>       mEdges;
+        
+        /**
+         * @brief mRowStart edges of row i are mEdgeCols/mEdgeCosts[mRowStart[i]..mRowStart[i+1]-1]
+         */
+        std::vector<int>        mRowStart;
+        std::vector<int>        mEdgeCols;
+        std::vector<double>     mEdgeCosts;
+        
+        std::vector<int>        mRowAssignment;
+        std::vector<int>        mColAssignment;
+        /**
+         * @brief mRowAssignmentCost cost of the edge assigned to each row
+         */
+        std::vector<double>     mRowAssignmentCost;
+        double                  mCost;
+        
+        /**
+         * @brief node potentials of rows, columns, source and sink (reduced cost of x->y is c + pi(x) - pi(y));
+         *        the column prices are the column potentials
+         */
+        std::vector<double>     mRowPotentials;
+        std::vector<double>     mColumnPrices;
+        double                  mSourcePotential;
+        double                  mSinkPotential;
+        
+        // shortest path workspace (reset sparsely after every augmentation)
+        std::vector<double>     mRowDist;
+        std::vector<double>     mColDist;
+        std::vector<int>        mRowPred;
+        std::vector<int>        mColPred;
+        std::vector<int>        mTouchedRows;
+        std::vector<int>        mTouchedCols;
+    };
+}
+
+#endif // SPARSELAP_HPP
@@ -0,0 +1,206 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "SpatialGrid.hpp"
+#include "DistanceKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Algorithms
+{
+    SpatialGrid::SpatialGrid() : mCellSize(1.0), mOrigin(0, 0), mCols(0), mRows(0)
+    {
+    }
+    
+    void SpatialGrid::build(std::vector<cv::Point> const& points, double cellSize)
+    {
+        this->clear();
+        
+        if(points.empty())
+        {
+            return;
+        }
+        
+        this->mPoints = points;
+        this->mCellSize = std::max(cellSize, 1.0);
+        
+        cv::Rect bb = cv::boundingRect(points);
+        this->mOrigin = bb.tl();
+        
+        // limit the number of (mostly empty) cells for small cell sizes
+        double const maxCells = static_cast<double>(std::max<size_t>(4 * points.size(), 1024));
+        double const nCells = (bb.width / this->mCellSize + 1) * (bb.height / this->mCellSize + 1);
+        if(nCells > maxCells)
+        {
+            this->mCellSize *= std::sqrt(nCells / maxCells);
+        }
+        
+        this->mCols = static_cast<int>(bb.width / this->mCellSize) + 1;
+        this->mRows = static_cast<int>(bb.height / this->mCellSize) + 1;
+        
+        // counting sort of the points into the cells
+        std::vector<int> cellOfPoint(points.size());
+        this->mCellStart.assign(this->mCols * this->mRows + 1, 0);
+        for(size_t i = 0; i < points.size(); ++i)
+        {
+            cellOfPoint[i] = this->cellY(points[i].y) * this->mCols + this->cellX(points[i].x);
+            ++this->mCellStart[cellOfPoint[i] + 1];
+        }
+        
+        for(size_t c = 1; c < this->mCellStart.size(); ++c)
+        {
+            this->mCellStart[c] += this->mCellStart[c - 1];
+        }
+        
+        this->mCellItems.resize(points.size());
+        this->mCellX.resize(points.size());
+        this->mCellY.resize(points.size());
+        std::vector<int> fill(this->mCellStart.begin(), this->mCellStart.end() - 1);
+        for(size_t i = 0; i < points.size(); ++i)
+        {
+            int k = fill[cellOfPoint[i]]++;
+            this->mCellItems[k] = static_cast<int>(i);
+            this->mCellX[k] = static_cast<float>(points[i].x);
+            this->mCellY[k] = static_cast<float>(points[i].y);
+        }
+    }
+    
+    void SpatialGrid::clear()
+    {
+        this->mPoints.clear();
+        this->mCellStart.clear();
+        this->mCellItems.clear();
+        this->mCellX.clear();
+        this->mCellY.clear();
+        this->mCols = 0;
+        this->mRows = 0;
+    }
+    
+    void SpatialGrid::query(cv::Point const& center, double radius, std::vector<int>& indices) const
+    {
+        indices.clear();
+        
+        if(this->mPoints.empty() || radius < 0)
+        {
+            return;
+        }
+        
+        int x0 = this->cellX(static_cast<int>(std::floor(center.x - radius)));
+        int x1 = this->cellX(static_cast<int>(std::ceil(center.x + radius)));
+        int y0 = this->cellY(static_cast<int>(std::floor(center.y - radius)));
+        int y1 = this->cellY(static_cast<int>(std::ceil(center.y + radius)));
+        double radius2 = radius * radius;
+        
+        for(int cy = y0; cy <= y1; ++cy)
+        {
+            for(int cx = x0; cx <= x1; ++cx)
+            {
+                int c = cy * this->mCols + cx;
+                for(int k = this->mCellStart[c]; k < this->mCellStart[c + 1]; ++k)
+                {
+                    int i = this->mCellItems[k];
+                    double dx = this->mPoints[i].x - center.x;
+                    double dy = this->mPoints[i].y - center.y;
+                    if(dx * dx + dy * dy <= radius2)
+                    {
+                        indices.push_back(i);
+                    }
+                }
+            }
+        }
+        
+        std::sort(indices.begin(), indices.end());
+    }
+    
+    void SpatialGrid::query(cv::Point const& center, double radius, std::vector<int>& indices, std::vector<float>& squaredDistances) const
+    {
+        indices.clear();
+        squaredDistances.clear();
+        
+        if(this->mPoints.empty() || radius < 0)
+        {
+            return;
+        }
+        
+        int x0 = this->cellX(static_cast<int>(std::floor(center.x - radius)));
+        int x1 = this->cellX(static_cast<int>(std::ceil(center.x + radius)));
+        int y0 = this->cellY(static_cast<int>(std::floor(center.y - radius)));
+        int y1 = this->cellY(static_cast<int>(std::ceil(center.y + radius)));
+        double const radius2 = radius * radius;
+        
+        for(int cy = y0; cy <= y1; ++cy)
+        {
+            // the cells x0..x1 of a grid row are consecutive in mCellItems
+            int begin = this->mCellStart[cy * this->mCols + x0];
+            int end = this->mCellStart[cy * this->mCols + x1 + 1];
+            if(begin == end)
+            {
+                continue;
+            }
+            
+            size_t offset = squaredDistances.size();
+            squaredDistances.resize(offset + (end - begin));
+            Algorithms::squaredDistances(static_cast<float>(center.x), 
+                                         static_cast<float>(center.y), 
+                                         &this->mCellX[begin], 
+                                         &this->mCellY[begin], 
+                                         end - begin, 
+                                         &squaredDistances[offset]);
+            
+            // keep the points within the radius (in place)
+            for(int k = begin; k < end; ++k)
+            {
+                float d2 = squaredDistances[offset + (k - begin)];
+                if(static_cast<double>(d2) <= radius2)
+                {
+                    squaredDistances[indices.size()] = d2;
+                    indices.push_back(this->mCellItems[k]);
+                }
+            }
+            squaredDistances.resize(indices.size());
+        }
+    }
+    
+    int SpatialGrid::cellX(int x) const
+    {
+        int c = static_cast<int>(std::floor((x - this->mOrigin.x) / this->mCellSize));
+        return std::min(std::max(c, 0), this->mCols - 1);
+    }
+    
+    int SpatialGrid::cellY(int y) const
+    {
+        int c = static_cast<int>(std::floor((y - this->mOrigin.y) / this->mCellSize));
+        return std::min(std::max(c, 0), this->mRows - 1);
+    }
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef SPATIALGRID_HPP
+#define SPATIALGRID_HPP
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+namespace Algorithms
+{
+    /**
+     * @brief The SpatialGrid class is a uniform grid index over a set of points, used to find all points within a
+     *        given radius without testing every point.
+     *
+     * The points are bucketed (counting sort) into square cells of the given size. A radius query only tests the
+     * points of the cells overlapping the query square. If the cell size is in the order of the query radius, a
+     * query touches a constant number of cells and building the grid is linear in the number of points.
+     */
+    class SpatialGrid
+    {
+    public:
+        SpatialGrid();
+        
+        /**
+         * @brief build indexes the given points (replacing the previously indexed points)
+         * @param points points to index; query results refer to the indices of this vector
+         * @param cellSize edge length of the grid cells (in pixels)
+         */
+        void build(std::vector<cv::Point> const& points, double cellSize);
+        
+        /**
+         * @brief clear removes all points
+         */
+        void clear();
+        
+        /**
+         * @brief query collects the indices of all points p with |p - center| <= radius
+         * @param center query center
+         * @param radius query radius
+         * @param indices indices of the found points (in ascending order)
+         */
+        void query(cv::Point const& center, double radius, std::vector<int>& indices) const;
+        
+        /**
+         * @brief query collects the indices and squared distances of all points p with |p - center| <= radius. The
+         *        points of consecutive cells are stored contiguously, thus the distances are computed in vectorized
+         *        runs over the cells of each grid row.
+         * @param center query center
+         * @param radius query radius
+         * @param indices indices of the found points (in cell order, i.e. not sorted)
+         * @param squaredDistances squared distances of the found points to the center
+         */
+        void query(cv::Point const& center, double radius, std::vector<int>& indices, std::vector<float>& squaredDistances) const;
+        
+        bool isEmpty() const {return this->mPoints.empty();}
+        
+    private:
+        int cellX(int x) const;
+        int cellY(int y) const;
+        
+        double                  mCellSize;
+        cv::Point               mOrigin;
+        int                     mCols;
+        int                     mRows;
+        /**
+         * @brief mCellStart start of the points of cell c in mCellItems (cell c contains mCellItems[mCellStart[c]..mCellStart[c+1]-1])
+         */
+        std::vector<int>        mCellStart;
+        std::vector<int>        mCellItems;
+        /**
+         * @brief mCellX, mCellY coordinates of the points in the order of mCellItems
+         */
+        std::vector<float>      mCellX;
+        std::vector<float>      mCellY;
+        std::vector<cv::Point>  mPoints;
+    };
+}
+
+#endif // SPATIALGRID_HPP
@@ -1,6 +1,13 @@
 HEADERS += \
-    Algorithm/Hungarian.hpp
+    Algorithm/BipartiteComponents.hpp \
+    Algorithm/DistanceKernels.hpp \
+    Algorithm/Hungarian.hpp \
+    Algorithm/SparseLAP.hpp \
+    Algorithm/SpatialGrid.hpp
 
 SOURCES += \
-    Algorithm/Hungarian.cpp
+    Algorithm/BipartiteComponents.cpp \
+    Algorithm/Hungarian.cpp \
+    Algorithm/SparseLAP.cpp \
+    Algorithm/SpatialGrid.cpp
 
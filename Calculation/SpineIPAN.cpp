@@ -631,26 +631,21 @@ void SpineIPAN::calcDiscreteSpine(int nPoints, double &spineLength){
         // guarantee odd number of points
         nPoints = (nPoints % 2 == 0) ? nPoints+1 : nPoints;
 
-        // reserve memory for the discrete spine
-        discreteSpine->reserve(nPoints);
+        // the discrete spine and the radii are stored inline for up to maxInlineSpinePoints points,
+        // thus the usual spine sizes are sampled without any heap allocation
+        discreteSpine->clear();
+        animalRadii->clear();
 
-        // reserve memory for the radii vector
-        animalRadii->reserve(nPoints);
-        // add the first radius (which is 0)
-        animalRadii->push_back(0.0);
-
-        // add the first point to the discrete spine
+        // add the first point (with radius 0) to the discrete spine
         discreteSpine->push_back(contour->at(maxCurvatureIndex));
+        animalRadii->push_back(0.0);
 
-        // first, calculate total length of spine and store lengths of segments
+        // first, calculate total length of spine (the segment lengths are recalculated
+        // below instead of being stored, which would need a buffer of the spine size)
         spineLength = 0.0;
-        vector<double> segLengths;
-        segLengths.reserve(spine->size()-1);
         for(uint i = 1; i < spine->size(); i++)
         {
-            double segLength = Calc::normL2(spine->at(i)-spine->at(i-1));
-            spineLength += segLength;
-            segLengths.push_back(segLength);
+            spineLength += Calc::normL2(spine->at(i)-spine->at(i-1));
         }
 
         // distance between two points on discrete spine
@@ -659,20 +654,25 @@ void SpineIPAN::calcDiscreteSpine(int nPoints, double &spineLength){
         double cumLength = 0.0;
         double neededLength = dist; // length of spine until next discrete spine point
         int pointsAdded = 0; // count points added in for loop
+        double segLength = (spine->size() > 1) ? Calc::normL2(spine->at(1)-spine->at(0)) : 0.0;
 
         for(uint i = 1; i < spine->size() && pointsAdded < nPoints-2;)
         {
             // check if next discrete point lies between (i-1). and (i). spine point
-            if(cumLength + segLengths.at(i-1) <= neededLength)
+            if(cumLength + segLength <= neededLength)
             {
-                cumLength += segLengths.at(i-1);
+                cumLength += segLength;
                 i++;
+                if(i < spine->size())
+                {
+                    segLength = Calc::normL2(spine->at(i)-spine->at(i-1));
+                }
                 continue;
             }
             // cumulated length up to i-th point sufficient, so add the point
             // lying at cumLength + fraction on the spine (relative to first spine point)
             double neededLengthOnCurSegment = neededLength - cumLength;
-            double fraction = neededLengthOnCurSegment / segLengths.at(i-1);
+            double fraction = neededLengthOnCurSegment / segLength;
 
             Point2f dirVector = spine->at(i) - spine->at(i-1);
             Point2f discreteSpinePoint = spine->at(i) + fraction * dirVector;
@@ -690,10 +690,8 @@ void SpineIPAN::calcDiscreteSpine(int nPoints, double &spineLength){
             pointsAdded++;
         }
 
-        // add the last point to the discrete spine
+        // add the last point (with radius 0) to the discrete spine
         discreteSpine->push_back(contour->at(secondMaxCurvatureIndex));
-
-        // add the last radius (which is 0.0)
         animalRadii->push_back(0.0);
 
     }catch(std::exception e){
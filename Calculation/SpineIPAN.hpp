@@ -127,19 +127,19 @@ private:
     /**
      * @brief firstHalf stores the points of the first half
      */
-    FIMTypes::spine_t firstHalf;
+    FIMTypes::contour_t firstHalf;
     /**
      * @brief reverseSecondHalf stores the points of the second half
      */
-    FIMTypes::spine_t reverseSecondHalf;
+    FIMTypes::contour_t reverseSecondHalf;
     /**
      * @brief firstDiscreteHalf stores the discrete points of the first half
      */
-    FIMTypes::spine_t firstDiscreteHalf;
+    FIMTypes::contour_t firstDiscreteHalf;
     /**
      * @brief reverseSecondDiscreteHalf stores the points of the second discrete half
      */
-    FIMTypes::spine_t reverseSecondDiscreteHalf;
+    FIMTypes::contour_t reverseSecondDiscreteHalf;
     /**
      * @brief animalRadii stores the radii of the discrete spine points. First (head) and last (tail) radii are 0;
      *          radii inbetween are >0.
@@ -0,0 +1,263 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef INLINEVECTOR_HPP
+#define INLINEVECTOR_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+namespace FIMTypes
+{
+    /**
+     * @brief The InlineVector class is a sequence container which stores up to Capacity elements
+     *        inline (i.e. inside the object itself, without any heap allocation).
+     *
+     * If more than Capacity elements are inserted, all elements are moved into a std::vector
+     * which serves as runtime-sized fallback. The interface follows std::vector as far as it is
+     * needed for discrete spines and spine radii (see spine_t and radii_t).
+     */
+    template<class T, unsigned int Capacity>
+    class InlineVector
+    {
+    public:
+        typedef T                                       value_type;
+        typedef size_t                                  size_type;
+        typedef T&                                      reference;
+        typedef T const&                                const_reference;
+        typedef T*                                      iterator;
+        typedef T const*                                const_iterator;
+        typedef std::reverse_iterator<iterator>         reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>   const_reverse_iterator;
+
+        InlineVector() : mSize(0), mOnHeap(false) {}
+
+        InlineVector(std::vector<T> const& v) : mSize(0), mOnHeap(false)
+        {
+            this->assign(v.begin(), v.end());
+        }
+
+        InlineVector(InlineVector const& other) : mSize(0), mOnHeap(false)
+        {
+            this->assign(other.begin(), other.end());
+        }
+
+        InlineVector(InlineVector&& other) : mSize(0), mOnHeap(false)
+        {
+            this->moveFrom(other);
+        }
+
+        InlineVector& operator=(InlineVector const& other)
+        {
+            if(this != &other)
+            {
+                this->assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        InlineVector& operator=(InlineVector&& other)
+        {
+            if(this != &other)
+            {
+                this->moveFrom(other);
+            }
+            return *this;
+        }
+
+        template<class InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            this->clear();
+            for(; first != last; ++first)
+            {
+                this->push_back(*first);
+            }
+        }
+
+        size_type       size()      const {return this->mSize;}
+        bool            empty()     const {return this->mSize == 0;}
+        size_type       capacity()  const {return this->mOnHeap ? this->mHeap.capacity() : Capacity;}
+
+        /**
+         * @brief isInline returns true as long as the elements are stored without heap allocation
+         */
+        bool            isInline()  const {return !this->mOnHeap;}
+
+        T*              data()            {return this->mOnHeap ? this->mHeap.data() : this->mInline;}
+        T const*        data()      const {return this->mOnHeap ? this->mHeap.data() : this->mInline;}
+
+        iterator        begin()           {return this->data();}
+        const_iterator  begin()     const {return this->data();}
+        iterator        end()             {return this->data() + this->mSize;}
+        const_iterator  end()       const {return this->data() + this->mSize;}
+
+        reverse_iterator        rbegin()        {return reverse_iterator(this->end());}
+        const_reverse_iterator  rbegin() const  {return const_reverse_iterator(this->end());}
+        reverse_iterator        rend()          {return reverse_iterator(this->begin());}
+        const_reverse_iterator  rend()   const  {return const_reverse_iterator(this->begin());}
+
+        reference       operator[](size_type i)         {return this->data()[i];}
+        const_reference operator[](size_type i) const   {return this->data()[i];}
+
+        reference at(size_type i)
+        {
+            if(i >= this->mSize)
+                throw std::out_of_range("InlineVector::at");
+            return this->data()[i];
+        }
+
+        const_reference at(size_type i) const
+        {
+            if(i >= this->mSize)
+                throw std::out_of_range("InlineVector::at");
+            return this->data()[i];
+        }
+
+        reference       front()         {return this->at(0);}
+        const_reference front()   const {return this->at(0);}
+        reference       back()          {return this->at(this->mSize - 1);}
+        const_reference back()    const {return this->at(this->mSize - 1);}
+
+        void reserve(size_type n)
+        {
+            if(n > Capacity)
+            {
+                this->spill();
+                this->mHeap.reserve(n);
+            }
+        }
+
+        void push_back(T const& value)
+        {
+            if(!this->mOnHeap && this->mSize < Capacity)
+            {
+                this->mInline[this->mSize] = value;
+            }
+            else
+            {
+                this->spill();
+                this->mHeap.push_back(value);
+            }
+            ++this->mSize;
+        }
+
+        void pop_back()
+        {
+            if(this->mOnHeap)
+            {
+                this->mHeap.pop_back();
+            }
+            --this->mSize;
+        }
+
+        void resize(size_type n, T const& value = T())
+        {
+            if(!this->mOnHeap && n <= Capacity)
+            {
+                for(size_type i = this->mSize; i < n; ++i)
+                {
+                    this->mInline[i] = value;
+                }
+            }
+            else
+            {
+                this->spill();
+                this->mHeap.resize(n, value);
+            }
+            this->mSize = n;
+        }
+
+        void clear()
+        {
+            this->mHeap.clear();
+            this->mOnHeap = false;
+            this->mSize = 0;
+        }
+
+        /**
+         * @brief toStdVector copies the elements into a std::vector (e.g. to pass them to OpenCV functions)
+         */
+        std::vector<T> toStdVector() const {return std::vector<T>(this->begin(), this->end());}
+
+        bool operator==(InlineVector const& other) const
+        {
+            return this->mSize == other.mSize && std::equal(this->begin(), this->end(), other.begin());
+        }
+
+        bool operator!=(InlineVector const& other) const {return !(*this == other);}
+
+    private:
+        /**
+         * @brief mInline stores the elements as long as there are at most Capacity of them
+         */
+        T               mInline[Capacity];
+        /**
+         * @brief mHeap is the runtime-sized fallback which is used once Capacity is exceeded
+         */
+        std::vector<T>  mHeap;
+        size_type       mSize;
+        bool            mOnHeap;
+
+        /**
+         * @brief spill moves the inline elements into the heap fallback (no-op if already done)
+         */
+        void spill()
+        {
+            if(!this->mOnHeap)
+            {
+                this->mHeap.assign(this->mInline, this->mInline + this->mSize);
+                this->mOnHeap = true;
+            }
+        }
+
+        void moveFrom(InlineVector& other)
+        {
+            if(other.mOnHeap)
+            {
+                this->mHeap.swap(other.mHeap);
+                this->mOnHeap = true;
+                this->mSize = other.mSize;
+            }
+            else
+            {
+                this->assign(other.begin(), other.end());
+            }
+            other.clear();
+        }
+    };
+}
+
+#endif // INLINEVECTOR_HPP
@@ -61,6 +61,33 @@ namespace GeneralParameters
     
     bool     bEnableDetailetOutput                                  = true;
     bool     defaultEnableDetailetOutput                            = bEnableDetailetOutput;
+    
+    bool     bStreamCSVOutput                                       = false;
+    bool     defaultStreamCSVOutput                                 = bStreamCSVOutput;
+    
+    int      iDistanceOutputMode                                    = 0;
+    int      defaultDistanceOutputMode                              = iDistanceOutputMode;
+    
+    int      iDistanceOutputFormat                                  = 0;
+    int      defaultDistanceOutputFormat                            = iDistanceOutputFormat;
+    
+    int      iDistanceNeighbours                                    = 3;
+    int      defaultDistanceNeighbours                              = iDistanceNeighbours;
+    
+    double   dDistanceRadius                                        = 100.0;
+    double   defaultDistanceRadius                                  = dDistanceRadius;
+    
+    double   dGroupNeighbourRadius                                  = 100.0;
+    double   defaultGroupNeighbourRadius                            = dGroupNeighbourRadius;
+    
+    bool     bSaveHeatMaps                                          = false;
+    bool     defaultSaveHeatMaps                                    = bSaveHeatMaps;
+    
+    int      iHeatMapBinSize                                        = 4;
+    int      defaultHeatMapBinSize                                  = iHeatMapBinSize;
+    
+    bool     bSaveOverlayVideo                                      = false;
+    bool     defaultSaveOverlayVideo                                = bSaveOverlayVideo;
 
 	// all pixel neighbourhoods go counter-clockwise like contours! (remark: Point(0,0) lies in the top left corner of the image)
 	std::vector<cv::Vec2i> pixelNeighbourhood8 = std::vector<cv::Vec2i>({
@@ -152,6 +179,12 @@ namespace LarvaeExtractionParameters
     int      iNumerOfSpinePoints                                    = 9;
     int      defaultiNumerOfSpinePoints                             = iNumerOfSpinePoints;
 
+    bool     bUseLazySpineCalculation                               = false;
+    bool     defaultUseLazySpineCalculation                         = bUseLazySpineCalculation;
+
+    int      iMinTrackLengthForSpineCalculation                     = 0;
+    int      defaultMinTrackLengthForSpineCalculation               = iMinTrackLengthForSpineCalculation;
+
     namespace IPANContourCurvatureParameters
     {
         bool     bUseDynamicIpanParameterCalculation                = true;
@@ -228,6 +261,83 @@ namespace LarvaeExtractionParameters
 
         double dOverlapThreshold = 0.5;
         double defaultOverlapThreshold = dOverlapThreshold;
+
+        bool bUseMotionPrediction = false;
+        bool defaultUseMotionPrediction = bUseMotionPrediction;
+
+        double dMotionProcessNoise = 1.0;
+        double defaultMotionProcessNoise = dMotionProcessNoise;
+
+        double dMotionMeasurementNoise = 2.0;
+        double defaultMotionMeasurementNoise = dMotionMeasurementNoise;
+
+        double dMotionGatingSigma = 3.0;
+        double defaultMotionGatingSigma = dMotionGatingSigma;
+    }
+}
+
+namespace FeatureParameters
+{
+    int iFeatureSet                                                 = ALL_FEATURES & ~GROUP_BEHAVIOUR;
+    int defaultFeatureSet                                           = iFeatureSet;
+    
+    namespace
+    {
+        struct FeatureName
+        {
+            Feature     feature;
+            const char* name;
+        };
+        
+        const FeatureName featureNames[] = {
+            { AREA,                 "area" },
+            { PERIMETER,            "perimeter" },
+            { MOMENTUM_DISTANCE,    "momentumDistance" },
+            { DISTANCE_TO_ORIGIN,   "distanceToOrigin" },
+            { SPINE,                "spine" },
+            { BENDING,              "bending" },
+            { COILED,               "coiled" },
+            { ORIENTATION,          "orientation" },
+            { GO_PHASE,             "goPhase" },
+            { MOVEMENT_DIRECTION,   "movementDirection" },
+            { VELOCITY,             "velocity" },
+            { GROUP_BEHAVIOUR,      "groupBehaviour" }
+        };
+        
+        const size_t nFeatureNames = sizeof(featureNames) / sizeof(featureNames[0]);
+    }
+    
+    bool isEnabled(Feature const f)
+    {
+        return (iFeatureSet & f) != 0;
+    }
+    
+    std::vector<std::string> getEnabledFeatureNames()
+    {
+        std::vector<std::string> names;
+        for(size_t i = 0; i < nFeatureNames; ++i)
+        {
+            if(isEnabled(featureNames[i].feature))
+            {
+                names.push_back(featureNames[i].name);
+            }
+        }
+        return names;
+    }
+    
+    void setEnabledFeatures(std::vector<std::string> const& names)
+    {
+        iFeatureSet = 0;
+        for(auto const& n : names)
+        {
+            for(size_t i = 0; i < nFeatureNames; ++i)
+            {
+                if(n == featureNames[i].name)
+                {
+                    iFeatureSet |= featureNames[i].feature;
+                }
+            }
+        }
     }
 }
 
@@ -242,6 +352,15 @@ namespace TrackerConfig
         GeneralParameters::bShowTrackingProgress                                                                    = GeneralParameters::defaultShowTrackingProgress;
         GeneralParameters::bSaveLog                                                                                 = GeneralParameters::defaultSaveLog;
         GeneralParameters::bEnableDetailetOutput                                                                    = GeneralParameters::defaultEnableDetailetOutput;
+        GeneralParameters::bStreamCSVOutput                                                                         = GeneralParameters::defaultStreamCSVOutput;
+        GeneralParameters::iDistanceOutputMode                                                                      = GeneralParameters::defaultDistanceOutputMode;
+        GeneralParameters::iDistanceOutputFormat                                                                    = GeneralParameters::defaultDistanceOutputFormat;
+        GeneralParameters::iDistanceNeighbours                                                                      = GeneralParameters::defaultDistanceNeighbours;
+        GeneralParameters::dDistanceRadius                                                                          = GeneralParameters::defaultDistanceRadius;
+        GeneralParameters::dGroupNeighbourRadius                                                                    = GeneralParameters::defaultGroupNeighbourRadius;
+        GeneralParameters::bSaveHeatMaps                                                                            = GeneralParameters::defaultSaveHeatMaps;
+        GeneralParameters::iHeatMapBinSize                                                                          = GeneralParameters::defaultHeatMapBinSize;
+        GeneralParameters::bSaveOverlayVideo                                                                        = GeneralParameters::defaultSaveOverlayVideo;
     
         CameraParameter::File                                                                                       = CameraParameter::defaultFile;
         CameraParameter::dFPS                                                                                       = CameraParameter::defaultFSP;
@@ -254,6 +373,8 @@ namespace TrackerConfig
     
         LarvaeExtractionParameters::bUseDefault                                                                     = LarvaeExtractionParameters::defaultUseDefault;
         LarvaeExtractionParameters::iNumerOfSpinePoints                                                             = LarvaeExtractionParameters::defaultiNumerOfSpinePoints;
+        LarvaeExtractionParameters::bUseLazySpineCalculation                                                        = LarvaeExtractionParameters::defaultUseLazySpineCalculation;
+        LarvaeExtractionParameters::iMinTrackLengthForSpineCalculation                                              = LarvaeExtractionParameters::defaultMinTrackLengthForSpineCalculation;
     
         LarvaeExtractionParameters::IPANContourCurvatureParameters::bUseDynamicIpanParameterCalculation             = LarvaeExtractionParameters::IPANContourCurvatureParameters::defaultUseDynamicIpanParameterCalculation;
         LarvaeExtractionParameters::IPANContourCurvatureParameters::iMinimalTriangelSideLenght                      = LarvaeExtractionParameters::IPANContourCurvatureParameters::defaultMinimalTriangelSideLenght;
@@ -280,5 +401,11 @@ namespace TrackerConfig
         LarvaeExtractionParameters::AssignmentParameters::eCostMeasure                                              = LarvaeExtractionParameters::AssignmentParameters::defaultCostMeasure;
         LarvaeExtractionParameters::AssignmentParameters::dDistanceThreshold                                        = LarvaeExtractionParameters::AssignmentParameters::defaultDistanceThreshold;
         LarvaeExtractionParameters::AssignmentParameters::dOverlapThreshold                                         = LarvaeExtractionParameters::AssignmentParameters::defaultOverlapThreshold;
+        LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction                                      = LarvaeExtractionParameters::AssignmentParameters::defaultUseMotionPrediction;
+        LarvaeExtractionParameters::AssignmentParameters::dMotionProcessNoise                                       = LarvaeExtractionParameters::AssignmentParameters::defaultMotionProcessNoise;
+        LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise                                   = LarvaeExtractionParameters::AssignmentParameters::defaultMotionMeasurementNoise;
+        LarvaeExtractionParameters::AssignmentParameters::dMotionGatingSigma                                        = LarvaeExtractionParameters::AssignmentParameters::defaultMotionGatingSigma;
+
+        FeatureParameters::iFeatureSet                                                                              = FeatureParameters::defaultFeatureSet;
     }
 }
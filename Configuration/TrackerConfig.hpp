@@ -37,10 +37,18 @@
 #include <QString>
 #include <QStringList>
 #include <vector>
+#include <string>
 #include <opencv2/opencv.hpp>
 
+#include "InlineVector.hpp"
+
 namespace FIMTypes
 {
+    /**
+     * @brief maxInlineSpinePoints is the maximal number of spine points (and radii) which are stored
+     *        without heap allocation. Longer spines are supported, but fall back to heap storage.
+     */
+    static const unsigned int maxInlineSpinePoints = 11;
     /**
      * @brief contourType is used to store contour points
      */
@@ -60,7 +68,7 @@ namespace FIMTypes
     /**
      * @brief spineType is used to store spine points
      */
-    typedef std::vector<cv::Point> spine_t;
+    typedef InlineVector<cv::Point, maxInlineSpinePoints> spine_t;
     /**
      * @brief spineTypeF is used to store spine points with float coordinates
      */
@@ -76,7 +84,7 @@ namespace FIMTypes
     /**
      * @brief radiiType is used to store the radii of the discrete spine points
      */
-    typedef std::vector<double> radii_t;
+    typedef InlineVector<double, maxInlineSpinePoints> radii_t;
     /**
      * @brief BezierCurve contains control points of a Bezier Curve
      */
@@ -114,6 +122,39 @@ namespace GeneralParameters
     extern bool     bShowTrackingProgress;
     extern bool     bSaveLog;
     extern bool     bEnableDetailetOutput;
+    /**
+     * @brief bStreamCSVOutput if true, the features are appended to a long format csv file while tracking (see CSVStreamWriter)
+     */
+    extern bool     bStreamCSVOutput;
+    /**
+     * @brief iDistanceOutputMode, iDistanceOutputFormat selected pairs and layout of the distance export (see DistanceWriter::Mode and DistanceWriter::Format)
+     */
+    extern int      iDistanceOutputMode;
+    extern int      iDistanceOutputFormat;
+    /**
+     * @brief iDistanceNeighbours number of nearest neighbours per larva (DistanceWriter::K_NEAREST)
+     */
+    extern int      iDistanceNeighbours;
+    /**
+     * @brief dDistanceRadius maximal distance of the exported pairs in pixels (DistanceWriter::RADIUS)
+     */
+    extern double   dDistanceRadius;
+    /**
+     * @brief dGroupNeighbourRadius neighbourhood radius in pixels of the group behaviour values (see FeatureParameters::GROUP_BEHAVIOUR)
+     */
+    extern double   dGroupNeighbourRadius;
+    /**
+     * @brief bSaveHeatMaps if true, occupancy and trajectory heat maps are accumulated while tracking (see HeatMapAccumulator)
+     */
+    extern bool     bSaveHeatMaps;
+    /**
+     * @brief iHeatMapBinSize edge length of the heat map bins in pixels
+     */
+    extern int      iHeatMapBinSize;
+    /**
+     * @brief bSaveOverlayVideo if true, a video of the images annotated with the tracking results is written (see TrackRenderer)
+     */
+    extern bool     bSaveOverlayVideo;
 
 	extern std::vector<cv::Vec2i> pixelNeighbourhood8;
 	extern std::vector<cv::Vec2i> pixelNeighbourhood12;
@@ -148,6 +189,17 @@ namespace LarvaeExtractionParameters
 {
     extern bool     bUseDefault;
     extern int      iNumerOfSpinePoints;
+    /**
+     * @brief bUseLazySpineCalculation defers the (expensive) spine calculation of the detected larvae.
+     *        The association is based on momentum/contour only and the spines are calculated after tracking
+     *        for the remaining tracks (not applicable for the MID_SPINE_POINT cost measure).
+     */
+    extern bool     bUseLazySpineCalculation;
+    /**
+     * @brief iMinTrackLengthForSpineCalculation tracks with at most this many time steps are removed before
+     *        the deferred spine calculation (only used if bUseLazySpineCalculation is set; 0 keeps all tracks)
+     */
+    extern int      iMinTrackLengthForSpineCalculation;
     
     namespace IPANContourCurvatureParameters 
     {
@@ -191,7 +243,8 @@ namespace LarvaeExtractionParameters
         enum AssignmentMethod 
         {
             HUNGARIAN, 
-            GREEDY
+            GREEDY,
+            SPARSE_LAP
         };
         
         enum CostMeasure
@@ -201,13 +254,86 @@ namespace LarvaeExtractionParameters
             MID_SPINE_POINT
         };
         
+        /**
+         * @brief eAssignmentMethod assignment of raw larvae to larvae. With the distance based cost measures, the
+         *        hungarian and the sparse assignment only evaluate pairs within the gate around each larva (the
+         *        footprints of both larvae without motion prediction). Pairs outside the gate can never pass the
+         *        point-in-contour check, but they are no longer part of the optimized cost, thus the assignment of
+         *        the remaining pairs can differ from solving the full cost matrix.
+         */
         extern AssignmentMethod eAssignmentMethod;
         extern CostMeasure eCostMeasure;
         extern double dDistanceThreshold;
         extern double dOverlapThreshold;
+        
+        /**
+         * @brief bUseMotionPrediction predicts the position of every larva with a constant velocity kalman filter
+         *        (see MotionModel). The distance based cost measures use the distance to the predicted position
+         *        (normalized by the prediction uncertainty) and the gating radius is limited to
+         *        dMotionGatingSigma standard deviations of the prediction.
+         */
+        extern bool   bUseMotionPrediction;
+        /**
+         * @brief dMotionProcessNoise standard deviation of the acceleration in pixel per frame^2
+         */
+        extern double dMotionProcessNoise;
+        /**
+         * @brief dMotionMeasurementNoise standard deviation of the measured position in pixel
+         */
+        extern double dMotionMeasurementNoise;
+        extern double dMotionGatingSigma;
     }
 }
 
+/**
+ * @brief FeatureParameters declares which larval features are calculated (during tracking and in the
+ *        post-processing) and written to the CSV/YAML results. The momentum (i.e. position) and the spine are
+ *        always calculated, since they are required for the tracking and for the results viewer.
+ */
+namespace FeatureParameters
+{
+    enum Feature
+    {
+        AREA                = 0x0001,
+        PERIMETER           = 0x0002,
+        MOMENTUM_DISTANCE   = 0x0004, /**< momentum distance and accumulated distance */
+        DISTANCE_TO_ORIGIN  = 0x0008,
+        SPINE               = 0x0010, /**< spine length, spine points and radii (CSV columns and spine length in YAML) */
+        BENDING             = 0x0020, /**< main body bending angle and left/right bending indicators */
+        COILED              = 0x0040,
+        ORIENTATION         = 0x0080, /**< head/tail correction over time and the is well oriented indicator */
+        GO_PHASE            = 0x0100,
+        MOVEMENT_DIRECTION  = 0x0200,
+        VELOCITY            = 0x0400, /**< velocity and acceleration */
+        GROUP_BEHAVIOUR     = 0x0800, /**< nearest neighbour distance and neighbour count per larva, group values per frame (not enabled by default) */
+        ALL_FEATURES        = 0x0FFF
+    };
+    
+    /**
+     * @brief iFeatureSet bit set of the enabled features (see Feature)
+     */
+    extern int iFeatureSet;
+    
+    /**
+     * @brief isEnabled checks if the given feature is part of the current feature set
+     * @param f feature
+     * @return true if the feature is calculated and exported
+     */
+    bool isEnabled(Feature const f);
+    
+    /**
+     * @brief getEnabledFeatureNames returns the names (as used in the configuration file) of all enabled features
+     * @return feature names
+     */
+    std::vector<std::string> getEnabledFeatureNames();
+    
+    /**
+     * @brief setEnabledFeatures sets the feature set to the given feature names. Unknown names are ignored.
+     * @param names feature names (as used in the configuration file)
+     */
+    void setEnabledFeatures(std::vector<std::string> const& names);
+}
+
 namespace TrackerConfig
 {
     void reset();
@@ -1,5 +1,6 @@
 HEADERS += \
     Configuration/TrackerConfig.hpp \
+    Configuration/InlineVector.hpp \
     Configuration/FIMTrack.hpp
 
 SOURCES += \
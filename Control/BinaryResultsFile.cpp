@@ -0,0 +1,686 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "BinaryResultsFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <set>
+
+#include "QtOpencvCore.hpp"
+#include "Utility/ParallelFor.hpp"
+
+namespace BinaryResultsFormat
+{
+    char const magic[8] = {'F', 'I', 'M', 'T', 'R', 'E', 'S', '\0'};
+    
+    // the structs are written as they are, thus their layout must not contain padding
+    static_assert(sizeof(FileHeader) == 64, "unexpected size of BinaryResultsFormat::FileHeader");
+    static_assert(sizeof(TrackEntry) == 24, "unexpected size of BinaryResultsFormat::TrackEntry");
+    static_assert(sizeof(ColumnEntry) == 32, "unexpected size of BinaryResultsFormat::ColumnEntry");
+    
+    size_t typeSize(const uint32_t type)
+    {
+        switch(type)
+        {
+            case UINT8:     return 1;
+            case UINT16:    return 2;
+            case INT32:     return 4;
+            case FLOAT32:   return 4;
+            case FLOAT64:   return 8;
+        }
+        return 0;
+    }
+}
+
+using namespace BinaryResultsFormat;
+
+namespace
+{
+    /**
+     * @brief writeBufferSize rows are collected up to this size before they are written
+     */
+    size_t const writeBufferSize = 1 << 22;
+    
+    uint64_t align8(uint64_t const value)
+    {
+        return (value + 7) & ~static_cast<uint64_t>(7);
+    }
+    
+    template<class T>
+    void appendValue(std::vector<char>& buffer, T const& value)
+    {
+        char const* p = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+    
+    void appendString(std::vector<char>& buffer, std::string const& str)
+    {
+        appendValue(buffer, static_cast<uint32_t>(str.size()));
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+    
+    /**
+     * @brief The ColumnSource struct describes a column for the writer; fill writes the components of a row
+     *        (only called for existing time points, the row is zero initialized)
+     */
+    struct ColumnSource
+    {
+        ColumnEntry entry;
+        std::function<void(Larva const& larva, unsigned int const timePoint, char* out)> fill;
+    };
+    
+    template<class T, class Func>
+    ColumnSource makeColumn(uint32_t const id, uint32_t const type, uint32_t const components, Func f)
+    {
+        ColumnSource c;
+        std::memset(&c.entry, 0, sizeof(c.entry));
+        c.entry.id = id;
+        c.entry.type = type;
+        c.entry.components = components;
+        c.fill = [f](Larva const& larva, unsigned int const timePoint, char* out)
+        {
+            f(larva, timePoint, reinterpret_cast<T*>(out));
+        };
+        return c;
+    }
+    
+    template<class T>
+    T valueAt(T const* data, uint32_t const components, uint64_t const row, uint32_t const component = 0)
+    {
+        return (data != nullptr && component < components) ? data[row * components + component] : T();
+    }
+    
+    /**
+     * @brief The MetaReader class reads the length-prefixed meta data with bounds checks
+     */
+    class MetaReader
+    {
+    public:
+        MetaReader(uchar const* data, uint64_t const size) : mData(data), mSize(size), mPos(0), mOk(true) {}
+        
+        uint32_t readUInt32()
+        {
+            uint32_t value = 0;
+            if(this->mOk && this->mSize - this->mPos >= sizeof(value))
+            {
+                std::memcpy(&value, this->mData + this->mPos, sizeof(value));
+                this->mPos += sizeof(value);
+            }
+            else
+            {
+                this->mOk = false;
+            }
+            return value;
+        }
+        
+        std::string readString()
+        {
+            uint32_t const length = this->readUInt32();
+            if(!this->mOk || this->mSize - this->mPos < length)
+            {
+                this->mOk = false;
+                return std::string();
+            }
+            std::string str(reinterpret_cast<char const*>(this->mData + this->mPos), length);
+            this->mPos += length;
+            return str;
+        }
+        
+        bool ok() const {return this->mOk;}
+        
+    private:
+        uchar const*    mData;
+        uint64_t        mSize;
+        uint64_t        mPos;
+        bool            mOk;
+    };
+}
+
+bool BinaryResultsWriter::write(const std::string &path,
+                                const std::vector<Larva> &larvae,
+                                const std::vector<std::string> &imgPaths,
+                                const bool useUndist,
+                                const std::string &embeddedYML)
+{
+    // track index and the maximal number of spine points (the spine columns have a fixed width)
+    std::vector<TrackEntry> tracks(larvae.size());
+    uint64_t numberOfRows = 0;
+    size_t maxSpineSize = 0;
+    size_t maxRadiiSize = 0;
+    std::set<int> landmarkIDs;
+    for(size_t i = 0; i < larvae.size(); ++i)
+    {
+        Larva const& l = larvae.at(i);
+        TrackEntry& track = tracks.at(i);
+        std::memset(&track, 0, sizeof(track));
+        track.larvaID = l.getID();
+        track.nSpinePoints = l.getNSpinePoints();
+        track.rowOffset = numberOfRows;
+        if(!l.parameters.empty())
+        {
+            track.firstTimePoint = l.getFirstTimePoint();
+            track.span = static_cast<uint32_t>(l.parameters.getSpan());
+        }
+        numberOfRows += track.span;
+        
+        for(Larva::ParameterMap::const_iterator it = l.parameters.begin(); it != l.parameters.end(); ++it)
+        {
+            maxSpineSize = std::max(maxSpineSize, l.parameters.getSpineSize(*it));
+            maxRadiiSize = std::max(maxRadiiSize, l.parameters.getSpineRadiiSize(*it));
+        }
+        for(size_t landmarkID = 0; landmarkID < l.landmarks.size(); ++landmarkID)
+        {
+            if(!l.landmarks.at(landmarkID).empty())
+            {
+                landmarkIDs.insert(static_cast<int>(landmarkID));
+            }
+        }
+    }
+    
+    uint32_t const spineComponents = static_cast<uint32_t>(2 * maxSpineSize);
+    uint32_t const radiiComponents = static_cast<uint32_t>(maxRadiiSize);
+    std::vector<ColumnSource> columns;
+    columns.push_back(makeColumn<uint8_t>(VALID, UINT8, 1, [](Larva const&, unsigned int, uint8_t* out) {*out = 1;}));
+    columns.push_back(makeColumn<int32_t>(MOMENTUM, INT32, 2, [](Larva const& l, unsigned int t, int32_t* out) {cv::Point const p = l.parameters.getMomentum(t); out[0] = p.x; out[1] = p.y;}));
+    columns.push_back(makeColumn<double>(AREA, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::AREA, t);}));
+    columns.push_back(makeColumn<uint16_t>(SPINE_SIZE, UINT16, 1, [](Larva const& l, unsigned int t, uint16_t* out) {*out = static_cast<uint16_t>(l.parameters.getSpineSize(t));}));
+    columns.push_back(makeColumn<int32_t>(SPINE, INT32, spineComponents, [](Larva const& l, unsigned int t, int32_t* out)
+    {
+        for(size_t j = 0; j < l.parameters.getSpineSize(t); ++j)
+        {
+            cv::Point const p = l.parameters.getSpinePoint(t, j);
+            out[2 * j] = p.x;
+            out[2 * j + 1] = p.y;
+        }
+    }));
+    columns.push_back(makeColumn<uint16_t>(SPINE_RADII_SIZE, UINT16, 1, [](Larva const& l, unsigned int t, uint16_t* out) {*out = static_cast<uint16_t>(l.parameters.getSpineRadiiSize(t));}));
+    columns.push_back(makeColumn<double>(SPINE_RADII, FLOAT64, radiiComponents, [](Larva const& l, unsigned int t, double* out)
+    {
+        for(size_t j = 0; j < l.parameters.getSpineRadiiSize(t); ++j)
+        {
+            out[j] = l.parameters.getSpineRadius(t, j);
+        }
+    }));
+    columns.push_back(makeColumn<double>(MAIN_BODY_BENDING_ANGLE, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, t);}));
+    columns.push_back(makeColumn<double>(SPINE_LENGTH, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::SPINE_LENGTH, t);}));
+    columns.push_back(makeColumn<double>(PERIMETER, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::PERIMETER, t);}));
+    columns.push_back(makeColumn<uint8_t>(IS_COILED, UINT8, 1, [](Larva const& l, unsigned int t, uint8_t* out) {*out = l.parameters.getIndicator(TrackColumns::IS_COILED, t) ? 1 : 0;}));
+    columns.push_back(makeColumn<uint8_t>(IS_WELL_ORIENTED, UINT8, 1, [](Larva const& l, unsigned int t, uint8_t* out) {*out = l.parameters.getIndicator(TrackColumns::IS_WELL_ORIENTED, t) ? 1 : 0;}));
+    columns.push_back(makeColumn<double>(DIST_TO_ORIGIN, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::DIST_TO_ORIGIN, t);}));
+    columns.push_back(makeColumn<double>(MOMENTUM_DIST, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::MOMENTUM_DIST, t);}));
+    columns.push_back(makeColumn<double>(ACC_DIST, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::ACC_DIST, t);}));
+    columns.push_back(makeColumn<int32_t>(GO_PHASE, INT32, 1, [](Larva const& l, unsigned int t, int32_t* out) {*out = l.parameters.getGoPhase(t);}));
+    columns.push_back(makeColumn<uint8_t>(IS_LEFT_BENDED, UINT8, 1, [](Larva const& l, unsigned int t, uint8_t* out) {*out = l.parameters.getIndicator(TrackColumns::IS_LEFT_BENDED, t) ? 1 : 0;}));
+    columns.push_back(makeColumn<uint8_t>(IS_RIGHT_BENDED, UINT8, 1, [](Larva const& l, unsigned int t, uint8_t* out) {*out = l.parameters.getIndicator(TrackColumns::IS_RIGHT_BENDED, t) ? 1 : 0;}));
+    columns.push_back(makeColumn<double>(MOVEMENT_DIRECTION, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::MOVEMENT_DIRECTION, t);}));
+    columns.push_back(makeColumn<double>(VELOCITY, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::VELOSITY, t);}));
+    columns.push_back(makeColumn<double>(ACCELERATION, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::ACCELERATION, t);}));
+    columns.push_back(makeColumn<double>(NEAREST_NEIGHBOUR_DIST, FLOAT64, 1, [](Larva const& l, unsigned int t, double* out) {*out = l.parameters.getValue(TrackColumns::NEAREST_NEIGHBOUR_DIST, t);}));
+    columns.push_back(makeColumn<int32_t>(NEIGHBOUR_COUNT, INT32, 1, [](Larva const& l, unsigned int t, int32_t* out) {*out = l.parameters.getNeighbourCount(t);}));
+    
+    std::vector<std::string> landmarkNames;
+    for(int landmarkID : landmarkIDs)
+    {
+        uint32_t const base = LANDMARK_COLUMNS + 3 * static_cast<uint32_t>(landmarkNames.size());
+        landmarkNames.push_back(LandmarkRegistry::getName(landmarkID));
+        
+        columns.push_back(makeColumn<float>(base + LANDMARK_DISTANCE, FLOAT32, 1, [landmarkID](Larva const& l, unsigned int t, float* out)
+        {
+            double distance;
+            if(static_cast<size_t>(landmarkID) < l.landmarks.size() && l.landmarks[landmarkID].getDistance(t, distance))
+            {
+                *out = static_cast<float>(distance);
+            }
+        }));
+        columns.push_back(makeColumn<float>(base + LANDMARK_BEARING_ANGLE, FLOAT32, 1, [landmarkID](Larva const& l, unsigned int t, float* out)
+        {
+            double bearingAngle;
+            if(static_cast<size_t>(landmarkID) < l.landmarks.size() && l.landmarks[landmarkID].getBearingAngle(t, bearingAngle))
+            {
+                *out = static_cast<float>(bearingAngle);
+            }
+        }));
+        columns.push_back(makeColumn<uint8_t>(base + LANDMARK_FLAGS, UINT8, 1, [landmarkID](Larva const& l, unsigned int t, uint8_t* out)
+        {
+            if(static_cast<size_t>(landmarkID) >= l.landmarks.size())
+            {
+                return;
+            }
+            LandmarkSeries const& series = l.landmarks[landmarkID];
+            double value;
+            bool isInLandmark;
+            if(series.getDistance(t, value))
+            {
+                *out |= HAS_DISTANCE;
+            }
+            if(series.getIsInLandmark(t, isInLandmark) && isInLandmark)
+            {
+                *out |= IS_IN_LANDMARK;
+            }
+            if(series.getBearingAngle(t, value))
+            {
+                *out |= HAS_BEARING_ANGLE;
+            }
+        }));
+    }
+    
+    // meta data
+    std::vector<char> meta;
+    appendValue(meta, static_cast<uint32_t>(useUndist ? 1 : 0));
+    appendValue(meta, static_cast<uint32_t>(imgPaths.size()));
+    for(auto const& p : imgPaths)
+    {
+        appendString(meta, p);
+    }
+    appendValue(meta, static_cast<uint32_t>(landmarkNames.size()));
+    for(auto const& name : landmarkNames)
+    {
+        appendString(meta, name);
+    }
+    appendString(meta, embeddedYML);
+    
+    // layout
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.byteOrderMark = byteOrderMark;
+    header.numberOfTracks = static_cast<uint32_t>(tracks.size());
+    header.numberOfColumns = static_cast<uint32_t>(columns.size());
+    header.numberOfRows = numberOfRows;
+    header.metaOffset = sizeof(FileHeader);
+    header.metaSize = meta.size();
+    header.trackIndexOffset = align8(header.metaOffset + header.metaSize);
+    header.columnDirectoryOffset = header.trackIndexOffset + tracks.size() * sizeof(TrackEntry);
+    
+    uint64_t offset = header.columnDirectoryOffset + columns.size() * sizeof(ColumnEntry);
+    for(auto& c : columns)
+    {
+        c.entry.offset = align8(offset);
+        c.entry.size = numberOfRows * c.entry.components * typeSize(c.entry.type);
+        offset = c.entry.offset + c.entry.size;
+    }
+    
+    std::ofstream ofs(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!ofs.is_open())
+    {
+        return false;
+    }
+    
+    uint64_t position = 0;
+    auto writeBytes = [&ofs, &position](void const* data, size_t const size)
+    {
+        ofs.write(static_cast<char const*>(data), size);
+        position += size;
+    };
+    auto padTo = [&ofs, &position](uint64_t const target)
+    {
+        static char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        ofs.write(zeros, static_cast<std::streamsize>(target - position));
+        position = target;
+    };
+    
+    writeBytes(&header, sizeof(header));
+    writeBytes(meta.data(), meta.size());
+    padTo(header.trackIndexOffset);
+    writeBytes(tracks.data(), tracks.size() * sizeof(TrackEntry));
+    for(auto const& c : columns)
+    {
+        writeBytes(&c.entry, sizeof(c.entry));
+    }
+    
+    std::vector<char> buffer;
+    buffer.reserve(writeBufferSize);
+    for(auto const& c : columns)
+    {
+        padTo(c.entry.offset);
+        size_t const rowSize = c.entry.components * typeSize(c.entry.type);
+        if(rowSize == 0)
+        {
+            continue;
+        }
+        
+        for(size_t i = 0; i < larvae.size(); ++i)
+        {
+            Larva const& l = larvae.at(i);
+            for(uint32_t r = 0; r < tracks.at(i).span; ++r)
+            {
+                if(buffer.size() + rowSize > writeBufferSize)
+                {
+                    writeBytes(buffer.data(), buffer.size());
+                    buffer.clear();
+                }
+                
+                size_t const rowBegin = buffer.size();
+                buffer.resize(rowBegin + rowSize, 0);
+                unsigned int const timePoint = tracks.at(i).firstTimePoint + r;
+                if(l.parameters.count(timePoint) > 0)
+                {
+                    c.fill(l, timePoint, &buffer[rowBegin]);
+                }
+            }
+        }
+        writeBytes(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    
+    ofs.flush();
+    bool const ok = ofs.good();
+    ofs.close();
+    return ok;
+}
+
+BinaryResultsReader::BinaryResultsReader() : 
+    mData(nullptr), 
+    mNumberOfRows(0), 
+    mUseUndist(false)
+{
+}
+
+BinaryResultsReader::~BinaryResultsReader()
+{
+    this->close();
+}
+
+bool BinaryResultsReader::isBinaryResultsFile(const std::string &path)
+{
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    char fileMagic[sizeof(magic)];
+    return ifs.read(fileMagic, sizeof(fileMagic)) && std::memcmp(fileMagic, magic, sizeof(magic)) == 0;
+}
+
+bool BinaryResultsReader::open(const std::string &path)
+{
+    this->close();
+    
+    this->mFile.setFileName(QtOpencvCore::str2qstr(path));
+    if(!this->mFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    
+    uint64_t const fileSize = static_cast<uint64_t>(this->mFile.size());
+    if(fileSize < sizeof(FileHeader))
+    {
+        this->close();
+        return false;
+    }
+    
+    this->mData = this->mFile.map(0, this->mFile.size());
+    if(this->mData == nullptr)
+    {
+        this->close();
+        return false;
+    }
+    
+    auto inFile = [fileSize](uint64_t const offset, uint64_t const size)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    };
+    
+    FileHeader header;
+    std::memcpy(&header, this->mData, sizeof(header));
+    if(std::memcmp(header.magic, magic, sizeof(magic)) != 0
+            || header.version == 0 
+            || header.version > static_cast<uint32_t>(version)
+            || header.byteOrderMark != static_cast<uint32_t>(byteOrderMark)
+            || !inFile(header.metaOffset, header.metaSize)
+            || !inFile(header.trackIndexOffset, static_cast<uint64_t>(header.numberOfTracks) * sizeof(TrackEntry))
+            || !inFile(header.columnDirectoryOffset, static_cast<uint64_t>(header.numberOfColumns) * sizeof(ColumnEntry)))
+    {
+        this->close();
+        return false;
+    }
+    this->mNumberOfRows = header.numberOfRows;
+    
+    MetaReader meta(this->mData + header.metaOffset, header.metaSize);
+    this->mUseUndist = meta.readUInt32() != 0;
+    uint32_t const nImgPaths = meta.readUInt32();
+    for(uint32_t i = 0; i < nImgPaths && meta.ok(); ++i)
+    {
+        this->mImgPaths.push_back(meta.readString());
+    }
+    uint32_t const nLandmarks = meta.readUInt32();
+    for(uint32_t i = 0; i < nLandmarks && meta.ok(); ++i)
+    {
+        this->mLandmarkNames.push_back(meta.readString());
+    }
+    this->mEmbeddedYML = meta.readString();
+    if(!meta.ok())
+    {
+        this->close();
+        return false;
+    }
+    
+    this->mTracks.resize(header.numberOfTracks);
+    if(!this->mTracks.empty())
+    {
+        std::memcpy(&this->mTracks[0], this->mData + header.trackIndexOffset, this->mTracks.size() * sizeof(TrackEntry));
+    }
+    for(auto const& track : this->mTracks)
+    {
+        if(track.rowOffset > this->mNumberOfRows || track.span > this->mNumberOfRows - track.rowOffset)
+        {
+            this->close();
+            return false;
+        }
+    }
+    
+    // columns of unknown types are ignored, columns outside of the file (e.g. truncated files) are rejected
+    for(uint32_t i = 0; i < header.numberOfColumns; ++i)
+    {
+        ColumnEntry column;
+        std::memcpy(&column, this->mData + header.columnDirectoryOffset + i * sizeof(ColumnEntry), sizeof(column));
+        size_t const size = typeSize(column.type);
+        if(size == 0)
+        {
+            continue;
+        }
+        if(column.offset % 8 != 0
+                || column.size != this->mNumberOfRows * column.components * size
+                || !inFile(column.offset, column.size))
+        {
+            this->close();
+            return false;
+        }
+        this->mColumns.push_back(column);
+    }
+    
+    for(auto const& name : this->mLandmarkNames)
+    {
+        this->mLandmarkIDs.push_back(LandmarkRegistry::registerLandmark(name));
+    }
+    
+    return true;
+}
+
+void BinaryResultsReader::close()
+{
+    if(this->mData != nullptr)
+    {
+        this->mFile.unmap(const_cast<uchar*>(this->mData));
+        this->mData = nullptr;
+    }
+    if(this->mFile.isOpen())
+    {
+        this->mFile.close();
+    }
+    this->mNumberOfRows = 0;
+    this->mTracks.clear();
+    this->mColumns.clear();
+    this->mImgPaths.clear();
+    this->mUseUndist = false;
+    this->mLandmarkNames.clear();
+    this->mLandmarkIDs.clear();
+    this->mEmbeddedYML.clear();
+}
+
+void const* BinaryResultsReader::getColumnData(const uint32_t id, const uint32_t type, uint32_t &components) const
+{
+    for(auto const& column : this->mColumns)
+    {
+        if(column.id == id && column.type == type)
+        {
+            components = column.components;
+            return this->mData + column.offset;
+        }
+    }
+    components = 0;
+    return nullptr;
+}
+
+void BinaryResultsReader::readLarva(const size_t index, Larva &larva) const
+{
+    TrackEntry const& track = this->mTracks.at(index);
+    larva.setID(track.larvaID);
+    larva.setNSpinePoints(track.nSpinePoints);
+    
+    uint32_t n = 0;
+    uint8_t const* valid = static_cast<uint8_t const*>(this->getColumnData(VALID, UINT8, n));
+    if(valid == nullptr || n != 1)
+    {
+        return;
+    }
+    
+    uint32_t nMomentum, nArea, nSpineSize, nSpine, nRadiiSize, nRadii, nBending, nSpineLength, nPerimeter, nCoiled, nOriented,
+            nDistToOrigin, nMomentumDist, nAccDist, nGoPhase, nLeft, nRight, nDirection, nVelocity, nAcceleration,
+            nNearestNeighbourDist, nNeighbourCount;
+    int32_t const*  momentum            = static_cast<int32_t const*>(this->getColumnData(MOMENTUM, INT32, nMomentum));
+    double const*   area                = static_cast<double const*>(this->getColumnData(AREA, FLOAT64, nArea));
+    uint16_t const* spineSize           = static_cast<uint16_t const*>(this->getColumnData(SPINE_SIZE, UINT16, nSpineSize));
+    int32_t const*  spine               = static_cast<int32_t const*>(this->getColumnData(SPINE, INT32, nSpine));
+    uint16_t const* radiiSize           = static_cast<uint16_t const*>(this->getColumnData(SPINE_RADII_SIZE, UINT16, nRadiiSize));
+    double const*   radii               = static_cast<double const*>(this->getColumnData(SPINE_RADII, FLOAT64, nRadii));
+    double const*   bending             = static_cast<double const*>(this->getColumnData(MAIN_BODY_BENDING_ANGLE, FLOAT64, nBending));
+    double const*   spineLength         = static_cast<double const*>(this->getColumnData(SPINE_LENGTH, FLOAT64, nSpineLength));
+    double const*   perimeter           = static_cast<double const*>(this->getColumnData(PERIMETER, FLOAT64, nPerimeter));
+    uint8_t const*  isCoiled            = static_cast<uint8_t const*>(this->getColumnData(IS_COILED, UINT8, nCoiled));
+    uint8_t const*  isWellOriented      = static_cast<uint8_t const*>(this->getColumnData(IS_WELL_ORIENTED, UINT8, nOriented));
+    double const*   distToOrigin        = static_cast<double const*>(this->getColumnData(DIST_TO_ORIGIN, FLOAT64, nDistToOrigin));
+    double const*   momentumDist        = static_cast<double const*>(this->getColumnData(MOMENTUM_DIST, FLOAT64, nMomentumDist));
+    double const*   accDist             = static_cast<double const*>(this->getColumnData(ACC_DIST, FLOAT64, nAccDist));
+    int32_t const*  goPhase             = static_cast<int32_t const*>(this->getColumnData(GO_PHASE, INT32, nGoPhase));
+    uint8_t const*  isLeftBended        = static_cast<uint8_t const*>(this->getColumnData(IS_LEFT_BENDED, UINT8, nLeft));
+    uint8_t const*  isRightBended       = static_cast<uint8_t const*>(this->getColumnData(IS_RIGHT_BENDED, UINT8, nRight));
+    double const*   movementDirection   = static_cast<double const*>(this->getColumnData(MOVEMENT_DIRECTION, FLOAT64, nDirection));
+    double const*   velocity            = static_cast<double const*>(this->getColumnData(VELOCITY, FLOAT64, nVelocity));
+    double const*   acceleration        = static_cast<double const*>(this->getColumnData(ACCELERATION, FLOAT64, nAcceleration));
+    double const*   nearestNeighbourDist = static_cast<double const*>(this->getColumnData(NEAREST_NEIGHBOUR_DIST, FLOAT64, nNearestNeighbourDist));
+    int32_t const*  neighbourCount      = static_cast<int32_t const*>(this->getColumnData(NEIGHBOUR_COUNT, INT32, nNeighbourCount));
+    
+    for(uint32_t r = 0; r < track.span; ++r)
+    {
+        uint64_t const row = track.rowOffset + r;
+        if(!valid[row])
+        {
+            continue;
+        }
+        
+        Larva::ValuesType values;
+        values.momentum             = cv::Point(valueAt(momentum, nMomentum, row, 0), valueAt(momentum, nMomentum, row, 1));
+        values.area                 = valueAt(area, nArea, row);
+        uint32_t const nPoints      = std::min<uint32_t>(valueAt(spineSize, nSpineSize, row), nSpine / 2);
+        for(uint32_t j = 0; j < nPoints; ++j)
+        {
+            values.spine.push_back(cv::Point(valueAt(spine, nSpine, row, 2 * j), valueAt(spine, nSpine, row, 2 * j + 1)));
+        }
+        uint32_t const nRadiiValues = std::min<uint32_t>(valueAt(radiiSize, nRadiiSize, row), nRadii);
+        for(uint32_t j = 0; j < nRadiiValues; ++j)
+        {
+            values.spineRadii.push_back(valueAt(radii, nRadii, row, j));
+        }
+        values.mainBodyBendingAngle = valueAt(bending, nBending, row);
+        values.spineLength          = valueAt(spineLength, nSpineLength, row);
+        values.perimeter            = valueAt(perimeter, nPerimeter, row);
+        values.isCoiled             = valueAt(isCoiled, nCoiled, row) != 0;
+        values.isWellOriented       = valueAt(isWellOriented, nOriented, row) != 0;
+        values.distToOrigin         = valueAt(distToOrigin, nDistToOrigin, row);
+        values.momentumDist         = valueAt(momentumDist, nMomentumDist, row);
+        values.accDist              = valueAt(accDist, nAccDist, row);
+        values.goPhase              = valueAt(goPhase, nGoPhase, row);
+        values.isLeftBended         = valueAt(isLeftBended, nLeft, row) != 0;
+        values.isRightBended        = valueAt(isRightBended, nRight, row) != 0;
+        values.movementDirection    = valueAt(movementDirection, nDirection, row);
+        values.velosity             = valueAt(velocity, nVelocity, row);
+        values.acceleration         = valueAt(acceleration, nAcceleration, row);
+        values.nearestNeighbourDist = valueAt(nearestNeighbourDist, nNearestNeighbourDist, row);
+        values.neighbourCount       = valueAt(neighbourCount, nNeighbourCount, row);
+        
+        larva.setValuesAt(track.firstTimePoint + r, values);
+    }
+    
+    for(size_t i = 0; i < this->mLandmarkIDs.size(); ++i)
+    {
+        uint32_t const base = LANDMARK_COLUMNS + 3 * static_cast<uint32_t>(i);
+        uint32_t nDistance, nBearingAngle, nFlags;
+        float const*    distance        = static_cast<float const*>(this->getColumnData(base + LANDMARK_DISTANCE, FLOAT32, nDistance));
+        float const*    bearingAngle    = static_cast<float const*>(this->getColumnData(base + LANDMARK_BEARING_ANGLE, FLOAT32, nBearingAngle));
+        uint8_t const*  flags           = static_cast<uint8_t const*>(this->getColumnData(base + LANDMARK_FLAGS, UINT8, nFlags));
+        if(flags == nullptr)
+        {
+            continue;
+        }
+        
+        for(uint32_t r = 0; r < track.span; ++r)
+        {
+            uint64_t const row = track.rowOffset + r;
+            uint8_t const f = valueAt(flags, nFlags, row);
+            if(!valid[row] || f == 0)
+            {
+                continue;
+            }
+            unsigned int const timePoint = track.firstTimePoint + r;
+            if(f & HAS_DISTANCE)
+            {
+                larva.setLandmarkDistanceAt(timePoint, this->mLandmarkIDs.at(i), valueAt(distance, nDistance, row), (f & IS_IN_LANDMARK) != 0);
+            }
+            if(f & HAS_BEARING_ANGLE)
+            {
+                larva.setLandmarkBearingAngleAt(timePoint, this->mLandmarkIDs.at(i), valueAt(bearingAngle, nBearingAngle, row));
+            }
+        }
+    }
+}
+
+void BinaryResultsReader::readAllLarvae(std::vector<Larva> &larvae) const
+{
+    size_t const first = larvae.size();
+    larvae.resize(first + this->mTracks.size());
+    Parallel::parallelFor(this->mTracks.size(), [this, &larvae, first](size_t const i)
+    {
+        this->readLarva(i, larvae[first + i]);
+    });
+}
@@ -0,0 +1,253 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef BINARYRESULTSFILE_HPP
+#define BINARYRESULTSFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <QFile>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Data/Larva.hpp"
+
+/**
+ * @brief The BinaryResultsFormat namespace defines the versioned binary results file (*.fimb)
+ *
+ * The file stores the same larvae as the yml results file, but column by column (one array per feature over the
+ * rows of all tracks) so it can be memory-mapped and read without parsing:
+ *
+ * FileHeader | meta data | TrackEntry[numberOfTracks] | ColumnEntry[numberOfColumns] | columns (8 byte aligned)
+ *
+ * The rows of track i are [rowOffset, rowOffset + span) and row r belongs to the time point firstTimePoint + r;
+ * the VALID column marks the gaps. The meta data consists of length-prefixed strings: the image paths (with the
+ * undistortion flag), the landmark names and an embedded yml document with the remaining sections of the yml
+ * results file (ROIContainer, LandmarkContainer). All values are stored in the byte order of the writing machine
+ * (see FileHeader::byteOrderMark). Readers ignore unknown columns and use 0 for missing ones, thus columns can be
+ * added without breaking older files; incompatible layout changes increase the version.
+ */
+namespace BinaryResultsFormat
+{
+    enum
+    {
+        version         = 1,
+        byteOrderMark   = 0x01020304
+    };
+    
+    extern char const magic[8];
+    
+    enum ColumnType
+    {
+        UINT8       = 0,
+        UINT16      = 1,
+        INT32       = 2,
+        FLOAT32     = 3,
+        FLOAT64     = 4
+    };
+    
+    enum ColumnID
+    {
+        VALID = 0,
+        MOMENTUM,
+        AREA,
+        SPINE_SIZE,
+        SPINE,
+        SPINE_RADII_SIZE,
+        SPINE_RADII,
+        MAIN_BODY_BENDING_ANGLE,
+        SPINE_LENGTH,
+        PERIMETER,
+        IS_COILED,
+        IS_WELL_ORIENTED,
+        DIST_TO_ORIGIN,
+        MOMENTUM_DIST,
+        ACC_DIST,
+        GO_PHASE,
+        IS_LEFT_BENDED,
+        IS_RIGHT_BENDED,
+        MOVEMENT_DIRECTION,
+        VELOCITY,
+        ACCELERATION,
+        NEAREST_NEIGHBOUR_DIST,
+        NEIGHBOUR_COUNT,
+        /**
+         * @brief LANDMARK_COLUMNS the columns of landmark i start at LANDMARK_COLUMNS + 3 * i (see LandmarkColumn)
+         */
+        LANDMARK_COLUMNS = 1024
+    };
+    
+    enum LandmarkColumn
+    {
+        LANDMARK_DISTANCE       = 0,
+        LANDMARK_BEARING_ANGLE  = 1,
+        LANDMARK_FLAGS          = 2
+    };
+    
+    /**
+     * @brief The LandmarkFlags enum marks the existing landmark values of a row
+     */
+    enum LandmarkFlags
+    {
+        HAS_DISTANCE        = 1,
+        IS_IN_LANDMARK      = 2,
+        HAS_BEARING_ANGLE   = 4
+    };
+    
+    struct FileHeader
+    {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    byteOrderMark;
+        uint32_t    numberOfTracks;
+        uint32_t    numberOfColumns;
+        uint64_t    numberOfRows;
+        uint64_t    metaOffset;
+        uint64_t    metaSize;
+        uint64_t    trackIndexOffset;
+        uint64_t    columnDirectoryOffset;
+    };
+    
+    struct TrackEntry
+    {
+        uint32_t    larvaID;
+        uint32_t    firstTimePoint;
+        uint32_t    span;
+        uint32_t    nSpinePoints;
+        uint64_t    rowOffset;
+    };
+    
+    struct ColumnEntry
+    {
+        uint32_t    id;
+        uint32_t    type;
+        uint32_t    components;
+        uint32_t    reserved;
+        uint64_t    offset;
+        uint64_t    size;
+    };
+    
+    /**
+     * @brief typeSize size of a single component of the given column type in bytes
+     */
+    size_t typeSize(uint32_t const type);
+}
+
+/**
+ * @brief The BinaryResultsWriter class writes larvae to a binary results file (see BinaryResultsFormat)
+ */
+class BinaryResultsWriter
+{
+public:
+    /**
+     * @brief write writes the larvae to path
+     * @param embeddedYML yml document with further sections of the results (e.g. ROIContainer), may be empty
+     * @return true on success
+     */
+    static bool write(std::string const& path,
+                      std::vector<Larva> const& larvae,
+                      std::vector<std::string> const& imgPaths,
+                      bool const useUndist,
+                      std::string const& embeddedYML);
+};
+
+/**
+ * @brief The BinaryResultsReader class memory-maps a binary results file (see BinaryResultsFormat)
+ *
+ * Opening a file only validates the header and reads the meta data and the track index. The columns stay in the
+ * mapped file and are only touched when a track is read (readLarva) or a column is accessed (getColumnData).
+ *
+ * The results viewer (via InputGenerator::readOutputLarvae) builds all tracks at once and closes the file, thus the
+ * larvae need the same memory as after reading the yml file; the file only saves the parsing.
+ */
+class BinaryResultsReader
+{
+public:
+    BinaryResultsReader();
+    ~BinaryResultsReader();
+    
+    /**
+     * @brief isBinaryResultsFile checks the magic bytes of the file at path
+     */
+    static bool isBinaryResultsFile(std::string const& path);
+    
+    /**
+     * @brief open maps the file at path and validates its layout
+     * @return false if the file could not be mapped or is no valid binary results file
+     */
+    bool open(std::string const& path);
+    void close();
+    bool isOpen() const {return this->mData != nullptr;}
+    
+    size_t getNumberOfTracks() const {return this->mTracks.size();}
+    BinaryResultsFormat::TrackEntry const& getTrack(size_t const index) const {return this->mTracks.at(index);}
+    
+    std::vector<std::string> const& getImgPaths() const {return this->mImgPaths;}
+    bool getUseUndist() const {return this->mUseUndist;}
+    std::vector<std::string> const& getLandmarkNames() const {return this->mLandmarkNames;}
+    std::string const& getEmbeddedYML() const {return this->mEmbeddedYML;}
+    
+    /**
+     * @brief getColumnData returns the mapped data of a column (numberOfRows * components values of the given type)
+     * @return nullptr if the column does not exist or has another type
+     */
+    void const* getColumnData(uint32_t const id, uint32_t const type, uint32_t& components) const;
+    
+    /**
+     * @brief readLarva reads the track with the given index into the (empty) larva
+     */
+    void readLarva(size_t const index, Larva& larva) const;
+    
+    /**
+     * @brief readAllLarvae appends all tracks to larvae (the tracks are read in parallel)
+     */
+    void readAllLarvae(std::vector<Larva>& larvae) const;
+    
+private:
+    QFile                                       mFile;
+    uchar const*                                mData;
+    uint64_t                                    mNumberOfRows;
+    std::vector<BinaryResultsFormat::TrackEntry> mTracks;
+    std::vector<BinaryResultsFormat::ColumnEntry> mColumns;
+    std::vector<std::string>                    mImgPaths;
+    bool                                        mUseUndist;
+    std::vector<std::string>                    mLandmarkNames;
+    /**
+     * @brief mLandmarkIDs registry IDs of the landmark names (see LandmarkRegistry)
+     */
+    std::vector<int>                            mLandmarkIDs;
+    std::string                                 mEmbeddedYML;
+};
+
+#endif // BINARYRESULTSFILE_HPP
@@ -0,0 +1,505 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "CSVWriter.hpp"
+#include "LarvaeContainer.hpp"
+
+#include <algorithm>
+
+#include "Utility/NumberFormat.hpp"
+#include "Utility/ParallelFor.hpp"
+
+namespace
+{
+    /**
+     * @brief rowsPerChunk number of consecutive time points formatted by one task
+     */
+    size_t const rowsPerChunk = 64;
+
+    /**
+     * @brief streamBufferSize the stream writer flushes its buffer when it exceeds this size
+     */
+    size_t const streamBufferSize = 1 << 20;
+
+    void appendCell(std::string& buffer,
+                    CSVWriter::Column const& column,
+                    Larva const& larva,
+                    unsigned int const timePoint)
+    {
+        char cell[NumberFormat::maxLength];
+        buffer.append(cell, column.format(larva, timePoint, cell));
+    }
+
+    void formatRows(CSVWriter::Column const& column,
+                    std::vector<Larva> const& larvae,
+                    size_t const fromTimePoint,
+                    size_t const toTimePoint,
+                    std::string& buffer)
+    {
+        buffer.clear();
+        char number[NumberFormat::maxLength];
+        for(size_t t = fromTimePoint; t < toTimePoint; ++t)
+        {
+            unsigned int const timePoint = static_cast<unsigned int>(t);
+            buffer.append(column.name);
+            buffer.push_back('(');
+            buffer.append(number, NumberFormat::formatInt(timePoint, number));
+            buffer.push_back(')');
+            
+            for(auto const& l : larvae)
+            {
+                buffer.push_back(',');
+                if(l.parameters.count(timePoint) > 0)
+                {
+                    appendCell(buffer, column, l, timePoint);
+                }
+            }
+            
+            buffer.push_back('\n');
+        }
+    }
+}
+
+std::vector<CSVWriter::Column> CSVWriter::getColumns(const unsigned int nSpinePoints,
+                                                     const LandmarkContainer *landmarkContainer)
+{
+    return CSVWriter::getColumns(nSpinePoints, CSVWriter::getLandmarkNames(landmarkContainer));
+}
+
+std::vector<std::string> CSVWriter::getLandmarkNames(const LandmarkContainer *landmarkContainer)
+{
+    std::vector<std::string> names;
+    if(landmarkContainer != nullptr)
+    {
+        int const numberOfLandmarks = landmarkContainer->getSize();
+        for(int i = 0; i < numberOfLandmarks; ++i)
+        {
+            names.push_back(landmarkContainer->getLandmarkName(i).toStdString());
+        }
+    }
+    return names;
+}
+
+std::vector<CSVWriter::Column> CSVWriter::getColumns(const unsigned int nSpinePoints,
+                                                     const std::vector<std::string> &landmarkNames)
+{
+    std::vector<Column> columns;
+    
+    auto add = [&columns](std::string const& name, CellFormatter const& format)
+    {
+        Column c;
+        c.name = name;
+        c.format = format;
+        columns.push_back(c);
+    };
+    
+    // the cells of a column only read the column of their feature (see TrackColumns)
+    auto feature = [](TrackColumns::Feature const f) -> CellFormatter
+    {
+        return [f](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatDouble(l.parameters.getValue(f, t), out);};
+    };
+    auto indicator = [](TrackColumns::Indicator const i) -> CellFormatter
+    {
+        return [i](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatBool(l.parameters.getIndicator(i, t), out);};
+    };
+    
+    add("mom_x", [](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatInt(l.parameters.getMomentum(t).x, out);});
+    add("mom_y", [](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatInt(l.parameters.getMomentum(t).y, out);});
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::MOMENTUM_DISTANCE))
+    {
+        add("mom_dst", feature(TrackColumns::MOMENTUM_DIST));
+        add("acc_dst", feature(TrackColumns::ACC_DIST));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::DISTANCE_TO_ORIGIN))
+    {
+        add("dst_to_origin", feature(TrackColumns::DIST_TO_ORIGIN));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::AREA))
+    {
+        add("area", feature(TrackColumns::AREA));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::PERIMETER))
+    {
+        add("perimeter", feature(TrackColumns::PERIMETER));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::SPINE))
+    {
+        add("spine_length", feature(TrackColumns::SPINE_LENGTH));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+    {
+        add("bending", feature(TrackColumns::MAIN_BODY_BENDING_ANGLE));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::SPINE) && nSpinePoints > 0)
+    {
+        // spine point coordinates; larvae without spine at a time point get empty cells
+        auto spinePoint = [](unsigned int const index, unsigned int const dimension) -> CellFormatter
+        {
+            return [index, dimension](Larva const& l, unsigned int t, char* out) -> char*
+            {
+                if(l.parameters.getSpineSize(t) <= index)
+                {
+                    return out;
+                }
+                cv::Point const p = l.parameters.getSpinePoint(t, index);
+                return NumberFormat::formatInt(dimension == 0 ? p.x : p.y, out);
+            };
+        };
+        
+        add("head_x", spinePoint(0, 0));
+        add("head_y", spinePoint(0, 1));
+        
+        for(unsigned int i = 1; i + 1 < nSpinePoints; ++i)
+        {
+            std::string const name = "spinepoint_" + std::to_string(i);
+            add(name + "_x", spinePoint(i, 0));
+            add(name + "_y", spinePoint(i, 1));
+        }
+        
+        unsigned int const tailPos = nSpinePoints - 1;
+        add("tail_x", spinePoint(tailPos, 0));
+        add("tail_y", spinePoint(tailPos, 1));
+        
+        for(unsigned int i = 1; i + 1 < nSpinePoints; ++i)
+        {
+            add("radius_" + std::to_string(i), [i](Larva const& l, unsigned int t, char* out) -> char*
+            {
+                if(l.parameters.getSpineRadiiSize(t) <= i)
+                {
+                    return out;
+                }
+                return NumberFormat::formatDouble(l.parameters.getSpineRadius(t, i), out);
+            });
+        }
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::COILED))
+    {
+        add("is_coiled", indicator(TrackColumns::IS_COILED));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::ORIENTATION))
+    {
+        add("is_well_oriented", indicator(TrackColumns::IS_WELL_ORIENTED));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::GO_PHASE))
+    {
+        add("go_phase", [](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatInt(l.parameters.getGoPhase(t), out);});
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+    {
+        add("left_bended", indicator(TrackColumns::IS_LEFT_BENDED));
+        add("right_bended", indicator(TrackColumns::IS_RIGHT_BENDED));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION))
+    {
+        add("mov_direction", feature(TrackColumns::MOVEMENT_DIRECTION));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::VELOCITY))
+    {
+        add("velocity", feature(TrackColumns::VELOSITY));
+        add("acceleration", feature(TrackColumns::ACCELERATION));
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::GROUP_BEHAVIOUR))
+    {
+        add("nn_dist", feature(TrackColumns::NEAREST_NEIGHBOUR_DIST));
+        add("neighbour_count", [](Larva const& l, unsigned int t, char* out) {return NumberFormat::formatInt(l.parameters.getNeighbourCount(t), out);});
+    }
+    
+    if(!landmarkNames.empty())
+    {
+        int const numberOfLandmarks = static_cast<int>(landmarkNames.size());
+        std::vector<int> ids;
+        for(int i = 0; i < numberOfLandmarks; ++i)
+        {
+            ids.push_back(LandmarkRegistry::getID(landmarkNames.at(i)));
+        }
+        
+        for(int i = 0; i < numberOfLandmarks; ++i)
+        {
+            int const landmarkID = ids.at(i);
+            add("dist_to_" + landmarkNames.at(i), [landmarkID](Larva const& l, unsigned int t, char* out)
+            {
+                double distance;
+                return l.getDistanceToLandmark(t, landmarkID, distance) ? NumberFormat::formatDouble(distance, out) : out;
+            });
+        }
+        
+        for(int i = 0; i < numberOfLandmarks; ++i)
+        {
+            int const landmarkID = ids.at(i);
+            add("is_in_" + landmarkNames.at(i), [landmarkID](Larva const& l, unsigned int t, char* out)
+            {
+                bool isInLandmark;
+                return l.getIsInLandmarkIndicator(t, landmarkID, isInLandmark) ? NumberFormat::formatBool(isInLandmark, out) : out;
+            });
+        }
+        
+        for(int i = 0; i < numberOfLandmarks; ++i)
+        {
+            int const landmarkID = ids.at(i);
+            add("bearing_angle_to_" + landmarkNames.at(i), [landmarkID](Larva const& l, unsigned int t, char* out)
+            {
+                double bearingAngle;
+                return l.getBearingAngleToLandmark(t, landmarkID, bearingAngle) ? NumberFormat::formatDouble(bearingAngle, out) : out;
+            });
+        }
+    }
+    
+    return columns;
+}
+
+bool CSVWriter::writeTable(const std::string &path,
+                           const std::vector<Larva> &larvae,
+                           const size_t movieLength,
+                           const LandmarkContainer *landmarkContainer)
+{
+    return CSVWriter::writeTable(path, larvae, movieLength, CSVWriter::getLandmarkNames(landmarkContainer));
+}
+
+bool CSVWriter::writeTable(const std::string &path,
+                           const std::vector<Larva> &larvae,
+                           const size_t movieLength,
+                           const std::vector<std::string> &landmarkNames)
+{
+    std::ofstream ofs;
+    ofs.open(path.c_str());
+    
+    std::string header;
+    char number[NumberFormat::maxLength];
+    for(auto const& l : larvae)
+    {
+        header.append(",fish(");
+        header.append(number, NumberFormat::formatInt(l.getID(), number));
+        header.push_back(')');
+    }
+    header.push_back('\n');
+    ofs.write(header.data(), header.size());
+    
+    unsigned int const nSpinePoints = larvae.empty() ? 0 : larvae.at(0).getNSpinePoints();
+    std::vector<Column> const columns = CSVWriter::getColumns(nSpinePoints, landmarkNames);
+    
+    // every task formats a chunk of consecutive rows of one column; the tasks of a batch
+    // are formatted in parallel and written in order, thus the memory is bounded by the batch size
+    size_t const chunksPerColumn = (movieLength + rowsPerChunk - 1) / rowsPerChunk;
+    size_t const nTasks = columns.size() * chunksPerColumn;
+    size_t const tasksPerBatch = 4 * Parallel::numberOfThreads();
+    std::vector<std::string> buffers(std::min(tasksPerBatch, nTasks));
+    
+    for(size_t batchBegin = 0; batchBegin < nTasks; batchBegin += tasksPerBatch)
+    {
+        size_t const batchSize = std::min(tasksPerBatch, nTasks - batchBegin);
+        Parallel::parallelFor(batchSize, [&](size_t const i)
+        {
+            size_t const task = batchBegin + i;
+            size_t const from = (task % chunksPerColumn) * rowsPerChunk;
+            size_t const to = std::min(from + rowsPerChunk, movieLength);
+            formatRows(columns.at(task / chunksPerColumn), larvae, from, to, buffers.at(i));
+        });
+        
+        for(size_t i = 0; i < batchSize; ++i)
+        {
+            ofs.write(buffers.at(i).data(), buffers.at(i).size());
+        }
+    }
+    
+    ofs.flush();
+    bool const success = ofs.good();
+    ofs.close();
+    return success;
+}
+
+CSVStreamWriter::CSVStreamWriter()
+{
+}
+
+CSVStreamWriter::~CSVStreamWriter()
+{
+    if(this->mStream.is_open())
+    {
+        this->flush(true);
+        this->mStream.close();
+    }
+}
+
+bool CSVStreamWriter::open(const std::string &path,
+                           const unsigned int nSpinePoints,
+                           const LandmarkContainer *landmarkContainer)
+{
+    if(this->mStream.is_open())
+    {
+        this->mStream.close();
+    }
+    this->mColumns = CSVWriter::getColumns(nSpinePoints, landmarkContainer);
+    this->mPending.clear();
+    this->mFinished.clear();
+    this->mBuffer.clear();
+    
+    this->mStream.open(path.c_str());
+    if(!this->mStream.is_open())
+    {
+        return false;
+    }
+    
+    this->mBuffer.append("frame,fish");
+    for(auto const& c : this->mColumns)
+    {
+        this->mBuffer.push_back(',');
+        this->mBuffer.append(c.name);
+    }
+    this->mBuffer.push_back('\n');
+    this->flush(true);
+    
+    return true;
+}
+
+void CSVStreamWriter::append(const LarvaeContainer &larvaeContainer, const unsigned int timePoint)
+{
+    // without online post-processing the values change after the tracking (see finish)
+    if(!this->mStream.is_open() || !larvaeContainer.usesOnlinePostProcessing())
+    {
+        return;
+    }
+    
+    larvaeContainer.getLarvaeAt(timePoint, this->mCurrentLarvae);
+    for(Larva const* l : this->mCurrentLarvae)
+    {
+        if(this->mFinished.count(l->getID()) == 0)
+        {
+            // no-op for larvae which are already pending
+            this->mPending.insert(std::make_pair(l->getID(), l->getFirstTimePoint()));
+        }
+    }
+    
+    for(auto it = this->mPending.begin(); it != this->mPending.end();)
+    {
+        Larva const* larva = larvaeContainer.findLarva(it->first);
+        if(larva == nullptr || larva->parameters.empty())
+        {
+            it = this->mPending.erase(it);
+            continue;
+        }
+        
+        unsigned int const endTimePoint = larva->getLastTimePoint() + 1;
+        unsigned int finalEnd = it->second;
+        while(finalEnd < endTimePoint && larva->isFinalAt(finalEnd))
+        {
+            ++finalEnd;
+        }
+        this->writeRows(*larva, it->second, finalEnd);
+        
+        if(it->second == endTimePoint && larva->postProcessing.isClosed)
+        {
+            this->mFinished.insert(it->first);
+            it = this->mPending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    
+    this->flush(false);
+}
+
+void CSVStreamWriter::finish(const LarvaeContainer &larvaeContainer)
+{
+    if(!this->mStream.is_open())
+    {
+        return;
+    }
+    
+    for(Larva const& larva : larvaeContainer)
+    {
+        if(larva.parameters.empty() || this->mFinished.count(larva.getID()) > 0)
+        {
+            continue;
+        }
+        
+        auto it = this->mPending.find(larva.getID());
+        unsigned int nextTimePoint = (it != this->mPending.end()) ? it->second : larva.getFirstTimePoint();
+        this->writeRows(larva, nextTimePoint, larva.getLastTimePoint() + 1);
+    }
+    
+    this->mPending.clear();
+    this->mFinished.clear();
+    this->flush(true);
+    this->mStream.close();
+}
+
+void CSVStreamWriter::writeRows(const Larva &larva, unsigned int &nextTimePoint, const unsigned int endTimePoint)
+{
+    char number[NumberFormat::maxLength];
+    for(; nextTimePoint < endTimePoint; ++nextTimePoint)
+    {
+        if(larva.parameters.count(nextTimePoint) == 0)
+        {
+            continue;
+        }
+        
+        this->mBuffer.append(number, NumberFormat::formatInt(nextTimePoint, number));
+        this->mBuffer.push_back(',');
+        this->mBuffer.append(number, NumberFormat::formatInt(larva.getID(), number));
+        for(auto const& c : this->mColumns)
+        {
+            this->mBuffer.push_back(',');
+            appendCell(this->mBuffer, c, larva, nextTimePoint);
+        }
+        this->mBuffer.push_back('\n');
+    }
+}
+
+void CSVStreamWriter::flush(const bool force)
+{
+    if(force || this->mBuffer.size() >= streamBufferSize)
+    {
+        this->mStream.write(this->mBuffer.data(), this->mBuffer.size());
+        this->mBuffer.clear();
+        if(force)
+        {
+            this->mStream.flush();
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef CSVWRITER_HPP
+#define CSVWRITER_HPP
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Configuration/TrackerConfig.hpp"
+#include "Data/Larva.hpp"
+#include "GUI/LandmarkContainer.hpp"
+
+class LarvaeContainer;
+
+/**
+ * @brief The CSVWriter class writes the feature table (see OutputGenerator::writeCSVFile)
+ *
+ * The table consists of one block per feature column; each block has one row per time point and one cell per larva.
+ * Rows are formatted in chunks of consecutive time points in parallel into reusable text buffers, which are written
+ * to the file in order. Cells are read directly from the feature columns (see TrackColumns) and formatted without
+ * allocations.
+ */
+class CSVWriter
+{
+public:
+    /**
+     * @brief CellFormatter writes the value of a column for the larva at timePoint to out (see NumberFormat) and returns
+     *        the pointer behind the written characters; returning out leaves the cell empty
+     */
+    typedef std::function<char*(Larva const& larva, unsigned int const timePoint, char* out)> CellFormatter;
+
+    /**
+     * @brief The Column struct describes one feature column (e.g. mom_x or radius_3)
+     */
+    struct Column
+    {
+        std::string name;
+        CellFormatter format;
+    };
+
+    /**
+     * @brief getColumns returns all columns of the enabled features (see FeatureParameters) in the order of the table
+     *
+     * @param nSpinePoints number of spine points of the larvae
+     * @param landmarkContainer landmarks for the landmark related columns (may be nullptr)
+     */
+    static std::vector<Column> getColumns(unsigned int const nSpinePoints,
+                                          LandmarkContainer const* landmarkContainer = nullptr);
+
+    /**
+     * @brief getColumns returns all columns of the enabled features with the landmark related columns of the
+     *        given landmark names (allows to build the columns without access to the landmark container)
+     */
+    static std::vector<Column> getColumns(unsigned int const nSpinePoints,
+                                          std::vector<std::string> const& landmarkNames);
+
+    /**
+     * @brief getLandmarkNames returns the names of all landmarks of landmarkContainer (empty for nullptr)
+     */
+    static std::vector<std::string> getLandmarkNames(LandmarkContainer const* landmarkContainer);
+
+    /**
+     * @brief writeTable writes the feature table of the larvae for the time points [0, movieLength) to path
+     * @return false if the file could not be written
+     */
+    static bool writeTable(std::string const& path,
+                           std::vector<Larva> const& larvae,
+                           size_t const movieLength,
+                           LandmarkContainer const* landmarkContainer = nullptr);
+
+    static bool writeTable(std::string const& path,
+                           std::vector<Larva> const& larvae,
+                           size_t const movieLength,
+                           std::vector<std::string> const& landmarkNames);
+};
+
+/**
+ * @brief The CSVStreamWriter class appends one row per larva and time point to a csv file while the tracking runs
+ *
+ * The feature table stores time points along the rows of every feature block and thus can only be written after
+ * the tracking. The stream file stores the same columns in long format (frame, fish, features) instead. Rows are
+ * appended as soon as the values of a time point are final (see Larva::isFinalAt), thus rows of different larvae
+ * are not ordered by frame. Larvae which are post-processed after the tracking are written by finish().
+ */
+class CSVStreamWriter
+{
+public:
+    CSVStreamWriter();
+    ~CSVStreamWriter();
+
+    /**
+     * @brief open creates the file at path and writes the header
+     * @return true if the file could be opened
+     */
+    bool open(std::string const& path,
+              unsigned int const nSpinePoints,
+              LandmarkContainer const* landmarkContainer = nullptr);
+
+    bool isOpen() const {return this->mStream.is_open();}
+
+    /**
+     * @brief append writes all rows which became final after the tracking of timePoint
+     */
+    void append(LarvaeContainer const& larvaeContainer, unsigned int const timePoint);
+
+    /**
+     * @brief finish writes all remaining rows (after the post-processing) and closes the file
+     */
+    void finish(LarvaeContainer const& larvaeContainer);
+
+private:
+    /**
+     * @brief writeRows writes the rows of the larva from nextTimePoint up to (excluding) endTimePoint and advances nextTimePoint
+     */
+    void writeRows(Larva const& larva, unsigned int& nextTimePoint, unsigned int const endTimePoint);
+
+    void flush(bool const force);
+
+    std::ofstream mStream;
+    std::vector<CSVWriter::Column> mColumns;
+    std::string mBuffer;
+
+    /**
+     * @brief mPending maps the ids of all larvae with unwritten time points to the next time point to write
+     */
+    std::map<unsigned int, unsigned int> mPending;
+    /**
+     * @brief mFinished ids of all larvae which are completely written
+     */
+    std::set<unsigned int> mFinished;
+    std::vector<Larva const*> mCurrentLarvae;
+};
+
+#endif // CSVWRITER_HPP
@@ -318,9 +318,14 @@ namespace Calc
         return centerOfMass;
     }
 
-    double calcSpineLength(std::vector<Point> const& spine)
+    double calcSpineLength(FIMTypes::spine_t const& spine)
     {
-        return cv::arcLength(spine, false);
+        double length = 0.0;
+        for(size_t i = 1; i < spine.size(); ++i)
+        {
+            length += normL2(cv::Point2d(spine[i] - spine[i-1]));
+        }
+        return length;
     }
 
     double calcPerimeter(QPolygonF const& polygon)
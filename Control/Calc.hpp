@@ -160,7 +160,7 @@ namespace Calc
      * @param spine
      * @return
      */
-    double calcSpineLength(std::vector<cv::Point> const& spine);
+    double calcSpineLength(FIMTypes::spine_t const& spine);
 
     /**
      * @brief calcPerimeter
@@ -0,0 +1,467 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "DistanceWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "Configuration/TrackerConfig.hpp"
+#include "Data/MidPointGrid.hpp"
+#include "Utility/NumberFormat.hpp"
+#include "Utility/ParallelFor.hpp"
+
+namespace DistanceBinaryFormat
+{
+    char const magic[8] = {'F', 'I', 'M', 'T', 'D', 'S', 'T', '\0'};
+    
+    // the structs are written as they are, thus their layout must not contain padding
+    static_assert(sizeof(FileHeader) == 40, "unexpected padding in DistanceBinaryFormat::FileHeader");
+    static_assert(sizeof(DistanceRecord) == 16, "unexpected padding in DistanceBinaryFormat::DistanceRecord");
+}
+
+namespace
+{
+    /**
+     * @brief framesPerChunk number of consecutive time points processed by one task
+     */
+    size_t const framesPerChunk = 64;
+    
+    /**
+     * @brief The MidPointTable class stores the spine mid points of all larvae densely over their time spans and the
+     *        larvae present in every frame
+     */
+    class MidPointTable
+    {
+    public:
+        explicit MidPointTable(std::vector<Larva> const& larvae) : 
+            mFirstTimePoints(larvae.size(), 0),
+            mPoints(larvae.size()),
+            mValid(larvae.size())
+        {
+            Parallel::parallelFor(larvae.size(), [&](size_t const i)
+            {
+                Larva const& l = larvae[i];
+                if(l.parameters.empty())
+                {
+                    return;
+                }
+                
+                unsigned int const first = l.getFirstTimePoint();
+                size_t const midPointIndex = l.getSpineMidPointIndex();
+                this->mFirstTimePoints[i] = first;
+                this->mPoints[i].resize(l.parameters.getSpan());
+                this->mValid[i].assign(l.parameters.getSpan(), 0);
+                for(auto it = l.parameters.begin(); it != l.parameters.end(); ++it)
+                {
+                    if(midPointIndex < l.parameters.getSpineSize(*it))
+                    {
+                        this->mPoints[i][*it - first] = l.parameters.getSpinePoint(*it, midPointIndex);
+                        this->mValid[i][*it - first] = 1;
+                    }
+                }
+            });
+            
+            // larvae of every frame in a single traversal of the tracks (in ascending larva order)
+            for(size_t i = 0; i < larvae.size(); ++i)
+            {
+                size_t const first = this->mFirstTimePoints[i];
+                for(size_t k = 0; k < this->mValid[i].size(); ++k)
+                {
+                    if(this->mValid[i][k])
+                    {
+                        if(first + k >= this->mFrameLarvae.size())
+                        {
+                            this->mFrameLarvae.resize(first + k + 1);
+                        }
+                        this->mFrameLarvae[first + k].push_back(static_cast<unsigned int>(i));
+                    }
+                }
+            }
+        }
+        
+        bool get(size_t const larva, size_t const timePoint, cv::Point& p) const
+        {
+            size_t const first = this->mFirstTimePoints[larva];
+            if(timePoint < first || timePoint - first >= this->mValid[larva].size() || !this->mValid[larva][timePoint - first])
+            {
+                return false;
+            }
+            p = this->mPoints[larva][timePoint - first];
+            return true;
+        }
+        
+        size_t size() const {return this->mPoints.size();}
+        
+        /**
+         * @brief getFrameLarvae indices of the larvae with a mid point at timePoint
+         */
+        std::vector<unsigned int> const& getFrameLarvae(size_t const timePoint) const
+        {
+            return (timePoint < this->mFrameLarvae.size()) ? this->mFrameLarvae[timePoint] : this->mNoLarvae;
+        }
+        
+    private:
+        std::vector<unsigned int> mFirstTimePoints;
+        std::vector<std::vector<cv::Point> > mPoints;
+        std::vector<std::vector<char> > mValid;
+        std::vector<std::vector<unsigned int> > mFrameLarvae;
+        std::vector<unsigned int> const mNoLarvae;
+    };
+    
+    /**
+     * @brief The FrameNeighbours class finds the selected neighbours of all larvae present in a frame
+     */
+    class FrameNeighbours
+    {
+    public:
+        explicit FrameNeighbours(DistanceWriter::Options const& options) : mOptions(options) {}
+        
+        void setFrame(MidPointTable const& table, size_t const timePoint)
+        {
+            this->mLarvae = table.getFrameLarvae(timePoint);
+            this->mPoints.resize(this->mLarvae.size());
+            for(size_t k = 0; k < this->mLarvae.size(); ++k)
+            {
+                table.get(this->mLarvae[k], timePoint, this->mPoints[k]);
+            }
+            
+            if(this->mOptions.mode == DistanceWriter::RADIUS)
+            {
+                this->mGrid.build(this->mPoints, this->mOptions.radius);
+            }
+            else if(this->mOptions.mode == DistanceWriter::K_NEAREST)
+            {
+                this->mGrid.build(this->mPoints, MidPointGrid::getCellSize(this->mPoints, this->mOptions.nNeighbours));
+            }
+        }
+        
+        size_t size() const {return this->mPoints.size();}
+        
+        /**
+         * @brief getLarva index (in the larvae vector) of the k-th larva of the frame
+         */
+        unsigned int getLarva(size_t const k) const {return this->mLarvae[k];}
+        
+        /**
+         * @brief find finds the neighbours of the k-th larva of the frame (the indices refer to the larvae of the frame)
+         */
+        void find(unsigned int const k, std::vector<MidPointGrid::Neighbour>& neighbours) const
+        {
+            switch(this->mOptions.mode)
+            {
+                case DistanceWriter::K_NEAREST:
+                    this->mGrid.findKNearest(k, this->mOptions.nNeighbours, neighbours);
+                    break;
+                case DistanceWriter::RADIUS:
+                    this->mGrid.findInRadius(k, this->mOptions.radius, neighbours);
+                    break;
+                default:
+                    neighbours.clear();
+                    for(unsigned int j = 0; j < this->mPoints.size(); ++j)
+                    {
+                        if(j != k)
+                        {
+                            double const dx = static_cast<double>(this->mPoints[k].x - this->mPoints[j].x);
+                            double const dy = static_cast<double>(this->mPoints[k].y - this->mPoints[j].y);
+                            MidPointGrid::Neighbour neighbour = {j, std::sqrt(dx * dx + dy * dy)};
+                            neighbours.push_back(neighbour);
+                        }
+                    }
+                    break;
+            }
+        }
+        
+    private:
+        DistanceWriter::Options const& mOptions;
+        std::vector<cv::Point> mPoints;
+        std::vector<unsigned int> mLarvae;
+        MidPointGrid mGrid;
+    };
+    
+    /**
+     * @brief formatPairs formats the selected pairs of the time points [from, to) as LONG_CSV rows or BINARY records
+     * @return number of pairs
+     */
+    size_t formatPairs(MidPointTable const& table,
+                       std::vector<unsigned int> const& ids,
+                       DistanceWriter::Options const& options,
+                       size_t const from,
+                       size_t const to,
+                       std::string& buffer)
+    {
+        buffer.clear();
+        size_t nPairs = 0;
+        FrameNeighbours frame(options);
+        std::vector<MidPointGrid::Neighbour> neighbours;
+        char number[NumberFormat::maxLength];
+        
+        for(size_t t = from; t < to; ++t)
+        {
+            frame.setFrame(table, t);
+            for(unsigned int k = 0; k < frame.size(); ++k)
+            {
+                frame.find(k, neighbours);
+                nPairs += neighbours.size();
+                unsigned int const id = ids[frame.getLarva(k)];
+                for(auto const& n : neighbours)
+                {
+                    if(options.format == DistanceWriter::BINARY)
+                    {
+                        DistanceBinaryFormat::DistanceRecord const record = {static_cast<uint32_t>(t),
+                                                                             id,
+                                                                             ids[frame.getLarva(n.index)],
+                                                                             static_cast<float>(n.distance)};
+                        buffer.append(reinterpret_cast<char const*>(&record), sizeof(record));
+                    }
+                    else
+                    {
+                        buffer.append(number, NumberFormat::formatInt(static_cast<long long>(t), number));
+                        buffer.push_back(',');
+                        buffer.append(number, NumberFormat::formatInt(id, number));
+                        buffer.push_back(',');
+                        buffer.append(number, NumberFormat::formatInt(ids[frame.getLarva(n.index)], number));
+                        buffer.push_back(',');
+                        buffer.append(number, NumberFormat::formatDouble(n.distance, number));
+                        buffer.push_back('\n');
+                    }
+                }
+            }
+        }
+        return nPairs;
+    }
+    
+    /**
+     * @brief formatMatrixRows formats the MATRIX_CSV rows of larva i for the time points [from, to)
+     */
+    void formatMatrixRows(MidPointTable const& table,
+                          std::vector<unsigned int> const& ids,
+                          DistanceWriter::Options const& options,
+                          size_t const i,
+                          size_t const from,
+                          size_t const to,
+                          std::string& buffer)
+    {
+        buffer.clear();
+        size_t const n = table.size();
+        std::vector<double> cells(n);
+        std::vector<MidPointGrid::Neighbour> candidates;
+        char number[NumberFormat::maxLength];
+        
+        for(size_t t = from; t < to; ++t)
+        {
+            buffer.append("dst_to_fish[");
+            buffer.append(number, NumberFormat::formatInt(ids[i], number));
+            buffer.append("](");
+            buffer.append(number, NumberFormat::formatInt(static_cast<long long>(t), number));
+            buffer.push_back(')');
+            
+            // a negative distance marks an empty cell
+            std::fill(cells.begin(), cells.end(), -1.0);
+            cv::Point p;
+            if(table.get(i, t, p))
+            {
+                candidates.clear();
+                cv::Point q;
+                for(unsigned int j : table.getFrameLarvae(t))
+                {
+                    if(j != i && table.get(j, t, q))
+                    {
+                        double const dx = static_cast<double>(p.x - q.x);
+                        double const dy = static_cast<double>(p.y - q.y);
+                        MidPointGrid::Neighbour candidate = {static_cast<unsigned int>(j), std::sqrt(dx * dx + dy * dy)};
+                        candidates.push_back(candidate);
+                    }
+                }
+                
+                if(options.mode == DistanceWriter::K_NEAREST && candidates.size() > options.nNeighbours)
+                {
+                    std::nth_element(candidates.begin(), candidates.begin() + options.nNeighbours, candidates.end(),
+                                     [](MidPointGrid::Neighbour const& a, MidPointGrid::Neighbour const& b)
+                    {
+                        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+                    });
+                    candidates.resize(options.nNeighbours);
+                }
+                for(auto const& c : candidates)
+                {
+                    if(options.mode != DistanceWriter::RADIUS || c.distance <= options.radius)
+                    {
+                        cells[c.index] = c.distance;
+                    }
+                }
+            }
+            
+            for(size_t j = 0; j < n; ++j)
+            {
+                buffer.push_back(',');
+                if(cells[j] >= 0.0)
+                {
+                    buffer.append(number, NumberFormat::formatDouble(cells[j], number));
+                }
+            }
+            buffer.push_back('\n');
+        }
+    }
+}
+
+DistanceWriter::Options DistanceWriter::getDefaultOptions()
+{
+    Options options;
+    options.mode = ALL_PAIRS;
+    options.format = MATRIX_CSV;
+    options.nNeighbours = 1;
+    options.radius = 0.0;
+    return options;
+}
+
+DistanceWriter::Options DistanceWriter::getConfiguredOptions()
+{
+    Options options = getDefaultOptions();
+    if(GeneralParameters::iDistanceOutputMode >= ALL_PAIRS && GeneralParameters::iDistanceOutputMode <= RADIUS)
+    {
+        options.mode = static_cast<Mode>(GeneralParameters::iDistanceOutputMode);
+    }
+    if(GeneralParameters::iDistanceOutputFormat >= MATRIX_CSV && GeneralParameters::iDistanceOutputFormat <= BINARY)
+    {
+        options.format = static_cast<Format>(GeneralParameters::iDistanceOutputFormat);
+    }
+    options.nNeighbours = static_cast<unsigned int>(std::max(0, GeneralParameters::iDistanceNeighbours));
+    options.radius = GeneralParameters::dDistanceRadius;
+    return options;
+}
+
+char const* DistanceWriter::getFileExtension(const Format format)
+{
+    return (format == BINARY) ? ".fimd" : ".csv";
+}
+
+bool DistanceWriter::write(const std::string &path,
+                           const std::vector<Larva> &larvae,
+                           const size_t movieLength,
+                           const Options &options)
+{
+    std::ofstream ofs;
+    ofs.open(path.c_str(), (options.format == BINARY) ? std::ios::out | std::ios::binary : std::ios::out);
+    if(!ofs.is_open())
+    {
+        return false;
+    }
+    
+    std::vector<unsigned int> ids(larvae.size());
+    for(size_t i = 0; i < larvae.size(); ++i)
+    {
+        ids[i] = larvae[i].getID();
+    }
+    MidPointTable const table(larvae);
+    
+    DistanceBinaryFormat::FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::string buffer;
+    char number[NumberFormat::maxLength];
+    switch(options.format)
+    {
+        case MATRIX_CSV:
+            for(unsigned int id : ids)
+            {
+                buffer.append(",fish(");
+                buffer.append(number, NumberFormat::formatInt(id, number));
+                buffer.push_back(')');
+            }
+            buffer.push_back('\n');
+            break;
+        case LONG_CSV:
+            buffer.append("frame,fish,neighbour,distance\n");
+            break;
+        case BINARY:
+            std::memcpy(header.magic, DistanceBinaryFormat::magic, sizeof(header.magic));
+            header.version = DistanceBinaryFormat::version;
+            header.byteOrderMark = DistanceBinaryFormat::byteOrderMark;
+            header.numberOfLarvae = static_cast<uint32_t>(ids.size());
+            header.mode = static_cast<uint32_t>(options.mode);
+            header.movieLength = movieLength;
+            buffer.append(reinterpret_cast<char const*>(&header), sizeof(header));
+            if(!ids.empty())
+            {
+                buffer.append(reinterpret_cast<char const*>(ids.data()), ids.size() * sizeof(uint32_t));
+            }
+            break;
+    }
+    ofs.write(buffer.data(), buffer.size());
+    
+    // the matrix is ordered by larva (one task per larva and chunk), the pairs by time point (one task per chunk);
+    // the tasks of a batch are formatted in parallel and written in order
+    size_t const chunks = (movieLength + framesPerChunk - 1) / framesPerChunk;
+    size_t const nTasks = (options.format == MATRIX_CSV) ? larvae.size() * chunks : chunks;
+    size_t const tasksPerBatch = 4 * Parallel::numberOfThreads();
+    std::vector<std::string> buffers(std::min(tasksPerBatch, nTasks));
+    std::vector<size_t> nPairs(buffers.size(), 0);
+    
+    for(size_t batchBegin = 0; batchBegin < nTasks; batchBegin += tasksPerBatch)
+    {
+        size_t const batchSize = std::min(tasksPerBatch, nTasks - batchBegin);
+        Parallel::parallelFor(batchSize, [&](size_t const i)
+        {
+            size_t const task = batchBegin + i;
+            size_t const from = (task % chunks) * framesPerChunk;
+            size_t const to = std::min(from + framesPerChunk, movieLength);
+            if(options.format == MATRIX_CSV)
+            {
+                formatMatrixRows(table, ids, options, task / chunks, from, to, buffers[i]);
+            }
+            else
+            {
+                nPairs[i] = formatPairs(table, ids, options, from, to, buffers[i]);
+            }
+        });
+        
+        for(size_t i = 0; i < batchSize; ++i)
+        {
+            ofs.write(buffers[i].data(), buffers[i].size());
+            header.numberOfRecords += nPairs[i];
+        }
+    }
+    
+    if(options.format == BINARY)
+    {
+        ofs.seekp(0);
+        ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    }
+    
+    ofs.flush();
+    bool const ok = ofs.good();
+    ofs.close();
+    return ok;
+}
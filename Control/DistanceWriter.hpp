@@ -0,0 +1,168 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef DISTANCEWRITER_HPP
+#define DISTANCEWRITER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Data/Larva.hpp"
+
+/**
+ * @brief The DistanceBinaryFormat namespace defines the binary distance file (*.fimd)
+ *
+ * FileHeader | uint32_t larvaIDs[numberOfLarvae] | DistanceRecord[numberOfRecords]
+ *
+ * The records are ordered by time point, larva (in the order of larvaIDs) and neighbour (in the order of
+ * larvaIDs or by distance for DistanceWriter::K_NEAREST). All values are stored in the byte order of the
+ * writing machine (see FileHeader::byteOrderMark).
+ */
+namespace DistanceBinaryFormat
+{
+    enum
+    {
+        version         = 1,
+        byteOrderMark   = 0x01020304
+    };
+    
+    extern char const magic[8];
+    
+    struct FileHeader
+    {
+        char        magic[8];
+        uint32_t    version;
+        uint32_t    byteOrderMark;
+        uint32_t    numberOfLarvae;
+        /**
+         * @brief mode the DistanceWriter::Mode used for writing the file
+         */
+        uint32_t    mode;
+        uint64_t    movieLength;
+        uint64_t    numberOfRecords;
+    };
+    
+    struct DistanceRecord
+    {
+        uint32_t    timePoint;
+        uint32_t    larvaID;
+        uint32_t    neighbourID;
+        float       distance;
+    };
+}
+
+/**
+ * @brief The DistanceWriter class exports the distances between the spine mid points of the larvae
+ *
+ * The mid points of all larvae are read once. Time points are processed in chunks in parallel and the formatted
+ * chunks are written in order. For sparse outputs (k nearest neighbours or a maximal distance) every frame is
+ * indexed by a MidPointGrid, thus the costs per frame grow with the number of written pairs instead of the
+ * squared number of larvae.
+ */
+class DistanceWriter
+{
+public:
+    /**
+     * @brief The Mode enum selects the written pairs of every frame
+     */
+    enum Mode
+    {
+        /**
+         * @brief ALL_PAIRS all pairs of larvae
+         */
+        ALL_PAIRS   = 0,
+        /**
+         * @brief K_NEAREST the Options::nNeighbours nearest larvae of every larva
+         */
+        K_NEAREST   = 1,
+        /**
+         * @brief RADIUS all pairs with a distance of at most Options::radius
+         */
+        RADIUS      = 2
+    };
+    
+    /**
+     * @brief The Format enum selects the file layout
+     */
+    enum Format
+    {
+        /**
+         * @brief MATRIX_CSV one row per larva and time point with one cell per larva (unselected pairs are empty)
+         */
+        MATRIX_CSV  = 0,
+        /**
+         * @brief LONG_CSV one row per pair: frame,fish,neighbour,distance
+         */
+        LONG_CSV    = 1,
+        /**
+         * @brief BINARY see DistanceBinaryFormat
+         */
+        BINARY      = 2
+    };
+    
+    struct Options
+    {
+        Mode            mode;
+        Format          format;
+        unsigned int    nNeighbours;
+        double          radius;
+    };
+    
+    /**
+     * @brief getDefaultOptions all pairs in the matrix layout (the layout of the former distance table)
+     */
+    static Options getDefaultOptions();
+    
+    /**
+     * @brief getConfiguredOptions options of the distance export set in GeneralParameters
+     */
+    static Options getConfiguredOptions();
+    
+    /**
+     * @brief getFileExtension file extension (including the dot) for the format
+     */
+    static char const* getFileExtension(Format const format);
+    
+    /**
+     * @brief write writes the distances of the larvae for the time points [0, movieLength) to path
+     * @return false if the file could not be written
+     */
+    static bool write(std::string const& path,
+                      std::vector<Larva> const& larvae,
+                      size_t const movieLength,
+                      Options const& options);
+};
+
+#endif // DISTANCEWRITER_HPP
@@ -0,0 +1,254 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "FrameCache.hpp"
+
+#include <algorithm>
+
+#include "Utility/ParallelFor.hpp"
+
+FrameCache::FrameCache(const size_t byteBudget) 
+    : mUndistorter(nullptr),
+      mByteBudget(byteBudget),
+      mCachedBytes(0),
+      mFrameBytes(0),
+      mStop(false)
+{
+}
+
+FrameCache::~FrameCache()
+{
+    this->clear();
+}
+
+void FrameCache::reset(const std::vector<std::string> &paths, const Undistorter *undistorter)
+{
+    this->clear();
+    
+    this->mPaths = paths;
+    this->mUndistorter = undistorter;
+    this->mStop = false;
+    
+    if(!this->mPaths.empty())
+    {
+        // decoding is dominated by the image io and the remap, a few threads keep ahead of the playback
+        unsigned int const nWorkers = std::max(1u, std::min(4u, Parallel::numberOfThreads() / 2));
+        for(unsigned int i = 0; i < nWorkers; ++i)
+        {
+            this->mWorkers.push_back(std::thread(&FrameCache::runWorker, this));
+        }
+    }
+}
+
+void FrameCache::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStop = true;
+        this->mRequests.clear();
+    }
+    this->mRequestAvailable.notify_all();
+    
+    for(std::thread& worker : this->mWorkers)
+    {
+        worker.join();
+    }
+    this->mWorkers.clear();
+    
+    this->mPaths.clear();
+    this->mUndistorter = nullptr;
+    this->mFrames.clear();
+    this->mLRU.clear();
+    this->mDecoding.clear();
+    this->mCachedBytes = 0;
+    this->mFrameBytes = 0;
+}
+
+cv::Mat FrameCache::get(const size_t index)
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    if(index >= this->mPaths.size())
+    {
+        return cv::Mat();
+    }
+    
+    for(;;)
+    {
+        std::unordered_map<size_t, Entry>::iterator it = this->mFrames.find(index);
+        if(it != this->mFrames.end())
+        {
+            this->mLRU.splice(this->mLRU.begin(), this->mLRU, it->second.lruPosition);
+            return it->second.frame;
+        }
+        
+        // wait for the background thread instead of decoding the frame a second time
+        if(this->mDecoding.count(index) == 0)
+        {
+            break;
+        }
+        this->mFrameDecoded.wait(lock);
+    }
+    
+    this->mDecoding.insert(index);
+    lock.unlock();
+    cv::Mat frame = this->decode(index);
+    lock.lock();
+    
+    this->mDecoding.erase(index);
+    this->insert(index, frame);
+    this->mFrameDecoded.notify_all();
+    
+    return frame;
+}
+
+void FrameCache::prefetch(const size_t index, const int direction)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mRequests.clear();
+        
+        size_t const n = this->mPaths.size();
+        if(n == 0 || this->mStop)
+        {
+            return;
+        }
+        
+        // at most half of the budget is used for the frames ahead (the rest keeps the recently shown frames)
+        size_t nFrames = maxPrefetchFrames;
+        if(this->mFrameBytes > 0)
+        {
+            nFrames = std::min(nFrames, this->mByteBudget / 2 / this->mFrameBytes);
+        }
+        nFrames = std::min(nFrames, n - 1);
+        
+        for(size_t k = 1; k <= nFrames; ++k)
+        {
+            size_t const i = (direction >= 0) ? (index + k) % n : (index + n - k % n) % n;
+            if(this->mFrames.count(i) == 0 && this->mDecoding.count(i) == 0)
+            {
+                this->mRequests.push_back(i);
+            }
+        }
+    }
+    this->mRequestAvailable.notify_all();
+}
+
+size_t FrameCache::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mFrames.size();
+}
+
+size_t FrameCache::getCachedBytes() const
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mCachedBytes;
+}
+
+cv::Mat FrameCache::decode(const size_t index) const
+{
+    cv::Mat img = cv::imread(this->mPaths.at(index), CV_LOAD_IMAGE_GRAYSCALE);
+    if(img.empty())
+    {
+        return img;
+    }
+    
+    if(this->mUndistorter != nullptr && this->mUndistorter->isReady())
+    {
+        cv::Mat tmpImg;
+        this->mUndistorter->getUndistortImage(img, tmpImg);
+        img = tmpImg;
+    }
+    
+    cv::Mat frame;
+    cv::cvtColor(img, frame, CV_GRAY2RGB);
+    return frame;
+}
+
+void FrameCache::insert(const size_t index, const cv::Mat &frame)
+{
+    if(frame.empty() || this->mFrames.count(index) > 0)
+    {
+        return;
+    }
+    
+    size_t const bytes = frame.total() * frame.elemSize();
+    this->mFrameBytes = bytes;
+    
+    while(!this->mLRU.empty() && this->mCachedBytes + bytes > this->mByteBudget)
+    {
+        std::unordered_map<size_t, Entry>::iterator it = this->mFrames.find(this->mLRU.back());
+        this->mCachedBytes -= it->second.frame.total() * it->second.frame.elemSize();
+        this->mFrames.erase(it);
+        this->mLRU.pop_back();
+    }
+    
+    this->mLRU.push_front(index);
+    Entry entry;
+    entry.frame = frame;
+    entry.lruPosition = this->mLRU.begin();
+    this->mFrames[index] = entry;
+    this->mCachedBytes += bytes;
+}
+
+void FrameCache::runWorker()
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    for(;;)
+    {
+        while(this->mRequests.empty() && !this->mStop)
+        {
+            this->mRequestAvailable.wait(lock);
+        }
+        if(this->mStop)
+        {
+            return;
+        }
+        
+        size_t const index = this->mRequests.front();
+        this->mRequests.pop_front();
+        if(this->mFrames.count(index) > 0 || this->mDecoding.count(index) > 0)
+        {
+            continue;
+        }
+        
+        this->mDecoding.insert(index);
+        lock.unlock();
+        cv::Mat frame = this->decode(index);
+        lock.lock();
+        
+        this->mDecoding.erase(index);
+        this->insert(index, frame);
+        this->mFrameDecoded.notify_all();
+    }
+}
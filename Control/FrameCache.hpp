@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef FRAMECACHE_HPP
+#define FRAMECACHE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Undistorter.hpp"
+
+/**
+ * @brief The FrameCache class caches display-ready frames (decoded, undistorted, RGB) of an image sequence
+ *
+ * The least recently used frames are evicted as soon as the cached frames exceed the byte budget. Frames ahead of
+ * the requested one (in the direction of playback or scrubbing) are decoded by background threads, thus stepping
+ * through the sequence usually hits the cache. A frame requested while it is decoded by a background thread is
+ * not decoded twice.
+ */
+class FrameCache
+{
+public:
+    /**
+     * @brief defaultByteBudget maximal size of the cached frames in bytes
+     */
+    static const size_t defaultByteBudget = 256 * 1024 * 1024;
+    
+    /**
+     * @brief maxPrefetchFrames maximal number of frames decoded ahead (limited to half of the budget as well)
+     */
+    static const size_t maxPrefetchFrames = 16;
+    
+    explicit FrameCache(size_t const byteBudget = defaultByteBudget);
+    
+    /**
+     * @brief ~FrameCache waits for the background threads
+     */
+    ~FrameCache();
+    
+    /**
+     * @brief reset removes all frames and starts the caching of the given image sequence
+     * @param undistorter applied to every frame if ready (may be nullptr); it must not be modified until clear,
+     *        reset or the destruction of the cache
+     */
+    void reset(std::vector<std::string> const& paths, Undistorter const* undistorter);
+    
+    /**
+     * @brief clear removes all frames and stops the background threads
+     */
+    void clear();
+    
+    /**
+     * @brief get returns the frame (CV_8UC3, RGB) at index; the frame is decoded on a cache miss
+     *        (empty if the image could not be read). The returned frame must not be modified.
+     */
+    cv::Mat get(size_t const index);
+    
+    /**
+     * @brief prefetch replaces the pending prefetch requests by the frames following index in the given direction
+     *        (wrapping around at the end of the sequence like the playback)
+     * @param direction 1 for forward, -1 for backward
+     */
+    void prefetch(size_t const index, int const direction);
+    
+    size_t size() const;
+    size_t getCachedBytes() const;
+    
+private:
+    struct Entry
+    {
+        cv::Mat frame;
+        std::list<size_t>::iterator lruPosition;
+    };
+    
+    cv::Mat decode(size_t const index) const;
+    
+    /**
+     * @brief insert adds a decoded frame and evicts the least recently used frames (mMutex must be locked)
+     */
+    void insert(size_t const index, cv::Mat const& frame);
+    
+    void runWorker();
+    
+    mutable std::mutex                      mMutex;
+    std::condition_variable                 mRequestAvailable;
+    std::condition_variable                 mFrameDecoded;
+    
+    std::vector<std::string>                mPaths;
+    Undistorter const*                      mUndistorter;
+    
+    size_t                                  mByteBudget;
+    size_t                                  mCachedBytes;
+    size_t                                  mFrameBytes;
+    
+    std::unordered_map<size_t, Entry>       mFrames;
+    /**
+     * @brief mLRU indices of the cached frames, the most recently used first
+     */
+    std::list<size_t>                       mLRU;
+    std::unordered_set<size_t>              mDecoding;
+    std::deque<size_t>                      mRequests;
+    
+    std::vector<std::thread>                mWorkers;
+    bool                                    mStop;
+};
+
+#endif // FRAMECACHE_HPP
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "GroupMetrics.hpp"
+
+#include <cmath>
+#include <fstream>
+
+#include "Utility/NumberFormat.hpp"
+
+void GroupMetrics::update(const unsigned int timePoint,
+                          const std::vector<cv::Point> &points,
+                          const std::vector<double> &directions,
+                          const double radius,
+                          std::vector<double> &nearestNeighbourDists,
+                          std::vector<int> &neighbourCounts)
+{
+    size_t const n = points.size();
+    nearestNeighbourDists.assign(n, -1.0);
+    neighbourCounts.assign(n, 0);
+    this->mGrid.build(points, radius);
+    
+    double sumNearestNeighbourDist = 0.0;
+    double sumNeighbourCount = 0.0;
+    for(unsigned int i = 0; i < n; ++i)
+    {
+        this->mGrid.findInRadius(i, radius, this->mNeighbours);
+        neighbourCounts[i] = static_cast<int>(this->mNeighbours.size());
+        sumNeighbourCount += this->mNeighbours.size();
+        
+        this->mGrid.findKNearest(i, 1, this->mNeighbours);
+        if(!this->mNeighbours.empty())
+        {
+            nearestNeighbourDists[i] = this->mNeighbours.front().distance;
+            sumNearestNeighbourDist += nearestNeighbourDists[i];
+        }
+    }
+    
+    // the movement direction is the angle to the y-axis in degree
+    double sumX = 0.0;
+    double sumY = 0.0;
+    size_t nDirections = 0;
+    for(double const direction : directions)
+    {
+        if(direction >= 0.0)
+        {
+            double const rad = direction * CV_PI / 180.0;
+            sumX += std::sin(rad);
+            sumY += std::cos(rad);
+            ++nDirections;
+        }
+    }
+    
+    FrameValues values;
+    values.nLarvae                  = static_cast<unsigned int>(n);
+    values.meanNearestNeighbourDist = (n > 1) ? sumNearestNeighbourDist / n : -1.0;
+    values.meanNeighbourCount       = (n > 0) ? sumNeighbourCount / n : 0.0;
+    values.polarization             = (nDirections > 0) ? std::sqrt(sumX * sumX + sumY * sumY) / nDirections : -1.0;
+    this->mFrames[timePoint] = values;
+}
+
+const GroupMetrics::FrameValues *GroupMetrics::getFrameValuesAt(const unsigned int timePoint) const
+{
+    TimeSeries<FrameValues>::const_iterator it = this->mFrames.find(timePoint);
+    return (it != this->mFrames.end()) ? &it->second : nullptr;
+}
+
+bool GroupMetrics::writeCSVFile(const std::string &path) const
+{
+    std::ofstream ofs;
+    ofs.open(path.c_str());
+    if(!ofs.is_open())
+    {
+        return false;
+    }
+    
+    std::string buffer("frame,fish_count,mean_nn_dist,mean_neighbour_count,polarization\n");
+    char number[NumberFormat::maxLength];
+    for(auto it = this->mFrames.begin(); it != this->mFrames.end(); ++it)
+    {
+        buffer.append(number, NumberFormat::formatInt(it->first, number));
+        buffer.push_back(',');
+        buffer.append(number, NumberFormat::formatInt(it->second.nLarvae, number));
+        buffer.push_back(',');
+        buffer.append(number, NumberFormat::formatDouble(it->second.meanNearestNeighbourDist, number));
+        buffer.push_back(',');
+        buffer.append(number, NumberFormat::formatDouble(it->second.meanNeighbourCount, number));
+        buffer.push_back(',');
+        buffer.append(number, NumberFormat::formatDouble(it->second.polarization, number));
+        buffer.push_back('\n');
+    }
+    ofs.write(buffer.data(), buffer.size());
+    
+    ofs.flush();
+    bool const ok = ofs.good();
+    ofs.close();
+    return ok;
+}
@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef GROUPMETRICS_HPP
+#define GROUPMETRICS_HPP
+
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "Data/MidPointGrid.hpp"
+#include "Data/TimeSeries.hpp"
+
+/**
+ * @brief The GroupMetrics class calculates the group behaviour of the larvae frame by frame while tracking
+ *
+ * Every frame is indexed by a MidPointGrid with the neighbour radius as cell size. Per larva, the distance to the
+ * nearest neighbour and the number of neighbours within the radius are returned (and stored in the values of the
+ * larvae by LarvaeContainer::updateGroupMetrics). Per frame, the means of both values and the polarization (length
+ * of the mean unit vector of the movement directions) are stored here.
+ */
+class GroupMetrics
+{
+public:
+    struct FrameValues
+    {
+        unsigned int    nLarvae;
+        /**
+         * @brief meanNearestNeighbourDist mean distance to the nearest neighbour (-1 if there are less than 2 larvae)
+         */
+        double          meanNearestNeighbourDist;
+        double          meanNeighbourCount;
+        /**
+         * @brief polarization 1 if all larvae move in the same direction, about 0 for random directions
+         *        (-1 if no movement direction is known)
+         */
+        double          polarization;
+    };
+    
+    void clear() {this->mFrames.clear();}
+    
+    /**
+     * @brief update calculates the values of the larvae of the frame at timePoint
+     * @param points positions (spine mid points) of the larvae
+     * @param directions movement directions of the larvae in degree (negative if unknown)
+     * @param radius neighbourhood radius in pixels
+     * @param nearestNeighbourDists distance to the nearest neighbour per larva (-1 if there is no other larva)
+     * @param neighbourCounts number of other larvae within radius per larva
+     */
+    void update(unsigned int const timePoint,
+                std::vector<cv::Point> const& points,
+                std::vector<double> const& directions,
+                double const radius,
+                std::vector<double>& nearestNeighbourDists,
+                std::vector<int>& neighbourCounts);
+    
+    /**
+     * @brief getFrameValuesAt read-only access to the values of a frame
+     * @return nullptr if the frame has not been processed
+     */
+    FrameValues const* getFrameValuesAt(unsigned int const timePoint) const;
+    
+    bool empty() const {return this->mFrames.empty();}
+    
+    /**
+     * @brief writeCSVFile writes one row per processed frame: frame,fish_count,mean_nn_dist,mean_neighbour_count,polarization
+     * @return false if the file could not be written
+     */
+    bool writeCSVFile(std::string const& path) const;
+    
+private:
+    TimeSeries<FrameValues> mFrames;
+    MidPointGrid mGrid;
+    std::vector<MidPointGrid::Neighbour> mNeighbours;
+};
+
+#endif // GROUPMETRICS_HPP
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "HeatMapAccumulator.hpp"
+
+#include <sstream>
+
+#include <QDir>
+
+#include "QtOpencvCore.hpp"
+
+namespace
+{
+    bool write16Bit(std::string const& path, cv::Mat const& counts)
+    {
+        cv::Mat image;
+        counts.convertTo(image, CV_16U);
+        return cv::imwrite(path, image);
+    }
+}
+
+HeatMapAccumulator::HeatMapAccumulator() : mBinSize(1)
+{
+}
+
+void HeatMapAccumulator::reset(const cv::Size &imageSize, const int binSize)
+{
+    this->mBinSize = std::max(1, binSize);
+    cv::Size const size((imageSize.width + this->mBinSize - 1) / this->mBinSize, 
+                        (imageSize.height + this->mBinSize - 1) / this->mBinSize);
+    this->mOccupancy = cv::Mat::zeros(std::max(1, size.height), std::max(1, size.width), CV_32S);
+    this->mTrajectories = cv::Mat::zeros(this->mOccupancy.size(), CV_32S);
+    this->mTrackOccupancy.clear();
+}
+
+void HeatMapAccumulator::clear()
+{
+    this->mOccupancy.release();
+    this->mTrajectories.release();
+    this->mTrackOccupancy.clear();
+}
+
+int HeatMapAccumulator::getBin(const cv::Point &p) const
+{
+    int const x = std::min(std::max(p.x / this->mBinSize, 0), this->mOccupancy.cols - 1);
+    int const y = std::min(std::max(p.y / this->mBinSize, 0), this->mOccupancy.rows - 1);
+    return y * this->mOccupancy.cols + x;
+}
+
+void HeatMapAccumulator::addDetection(const unsigned int larvaID, const cv::Point &position, const cv::Point *previous)
+{
+    if(!this->isEnabled())
+    {
+        return;
+    }
+    
+    int const bin = this->getBin(position);
+    ++this->mOccupancy.ptr<int>()[bin];
+    ++this->mTrackOccupancy[larvaID][bin];
+    this->addMovement((previous != nullptr) ? this->getBin(*previous) : -1, bin, 1);
+}
+
+void HeatMapAccumulator::removeTrack(const unsigned int larvaID, const std::vector<cv::Point> &positions)
+{
+    auto it = this->mTrackOccupancy.find(larvaID);
+    if(!this->isEnabled() || it == this->mTrackOccupancy.end())
+    {
+        return;
+    }
+    
+    for(auto const& bin : it->second)
+    {
+        this->mOccupancy.ptr<int>()[bin.first] -= bin.second;
+    }
+    this->mTrackOccupancy.erase(it);
+    
+    // the crossed bins are not stored per track, thus the movements are replayed
+    int previousBin = -1;
+    for(cv::Point const& p : positions)
+    {
+        int const bin = this->getBin(p);
+        this->addMovement(previousBin, bin, -1);
+        previousBin = bin;
+    }
+}
+
+void HeatMapAccumulator::addMovement(const int previousBin, const int bin, const int delta)
+{
+    // the bins crossed by the movement (the bin of the previous detection has been counted before)
+    if(previousBin < 0 || previousBin == bin)
+    {
+        this->mTrajectories.ptr<int>()[bin] += delta;
+        return;
+    }
+    cv::Point const from(previousBin % this->mTrajectories.cols, previousBin / this->mTrajectories.cols);
+    cv::Point const to(bin % this->mTrajectories.cols, bin / this->mTrajectories.cols);
+    cv::LineIterator it(this->mTrajectories, from, to, 8);
+    ++it;
+    for(int i = 1; i < it.count; ++i, ++it)
+    {
+        *reinterpret_cast<int*>(*it) += delta;
+    }
+}
+
+cv::Mat HeatMapAccumulator::getTrackOccupancy(const unsigned int larvaID) const
+{
+    auto it = this->mTrackOccupancy.find(larvaID);
+    if(it == this->mTrackOccupancy.end())
+    {
+        return cv::Mat();
+    }
+    
+    cv::Mat counts = cv::Mat::zeros(this->mOccupancy.size(), CV_32S);
+    for(auto const& bin : it->second)
+    {
+        counts.ptr<int>()[bin.first] = bin.second;
+    }
+    return counts;
+}
+
+bool HeatMapAccumulator::write(const std::string &directory, const std::vector<Larva> &larvae) const
+{
+    if(!this->isEnabled() || !QDir().mkpath(QtOpencvCore::str2qstr(directory)))
+    {
+        return false;
+    }
+    
+    bool ok = write16Bit(directory + "/occupancy.png", this->mOccupancy);
+    ok = write16Bit(directory + "/trajectories.png", this->mTrajectories) && ok;
+    
+    cv::FileStorage fs(directory + "/heatmaps.yml.gz", cv::FileStorage::WRITE);
+    if(fs.isOpened())
+    {
+        fs << "binSize" << this->mBinSize;
+        fs << "occupancy" << this->mOccupancy;
+        fs << "trajectories" << this->mTrajectories;
+        fs.release();
+    }
+    else
+    {
+        ok = false;
+    }
+    
+    for(auto const& l : larvae)
+    {
+        cv::Mat const counts = this->getTrackOccupancy(l.getID());
+        if(!counts.empty())
+        {
+            std::stringstream path;
+            path << directory << "/track_" << l.getID() << ".png";
+            ok = write16Bit(path.str(), counts) && ok;
+        }
+    }
+    
+    return ok;
+}
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef HEATMAPACCUMULATOR_HPP
+#define HEATMAPACCUMULATOR_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Data/Larva.hpp"
+
+/**
+ * @brief The HeatMapAccumulator class accumulates occupancy and trajectory heat maps while tracking
+ *
+ * The arena is divided into square bins. Every detection increments the occupancy bin of its momentum in the
+ * population map and in the (sparse) map of its track; the trajectory map counts the bins crossed by the
+ * movement since the previous detection of the track. Thus the maps are complete as soon as the tracking ends.
+ */
+class HeatMapAccumulator
+{
+public:
+    HeatMapAccumulator();
+    
+    /**
+     * @brief reset enables the accumulation and removes all counts
+     * @param imageSize size of the tracked images
+     * @param binSize edge length of the bins in pixels
+     */
+    void reset(cv::Size const& imageSize, int const binSize);
+    
+    /**
+     * @brief clear disables the accumulation and releases the maps
+     */
+    void clear();
+    
+    bool isEnabled() const {return !this->mOccupancy.empty();}
+    
+    /**
+     * @brief addDetection counts a detection of the larva at position
+     * @param previous pointer to the position of the previous detection of the track (nullptr for a new track)
+     */
+    void addDetection(unsigned int const larvaID, cv::Point const& position, cv::Point const* previous);
+    
+    /**
+     * @brief removeTrack removes all counts of a track (e.g. of a track removed after tracking)
+     * @param positions positions of all detections of the track in time order (as passed to addDetection)
+     */
+    void removeTrack(unsigned int const larvaID, std::vector<cv::Point> const& positions);
+    
+    /**
+     * @brief getOccupancy, getTrajectories population maps (CV_32S, one element per bin)
+     */
+    cv::Mat const& getOccupancy() const {return this->mOccupancy;}
+    cv::Mat const& getTrajectories() const {return this->mTrajectories;}
+    
+    /**
+     * @brief getTrackOccupancy occupancy map of a single track (CV_32S, empty if the track has no detections)
+     */
+    cv::Mat getTrackOccupancy(unsigned int const larvaID) const;
+    
+    /**
+     * @brief write writes the maps to directory (created if necessary): the population maps as 16-bit images
+     *        (occupancy.png, trajectories.png; counts above 65535 saturate), their exact 32-bit counts
+     *        (heatmaps.yml.gz) and the occupancy of every given larva (track_<id>.png)
+     * @return false if a file could not be written
+     */
+    bool write(std::string const& directory, std::vector<Larva> const& larvae) const;
+    
+private:
+    int getBin(cv::Point const& p) const;
+    
+    /**
+     * @brief addMovement adds delta to the trajectory bins crossed by the movement from previousBin to bin
+     *        (only bin for the first detection of a track, i.e. previousBin < 0)
+     */
+    void addMovement(int const previousBin, int const bin, int const delta);
+    
+    int mBinSize;
+    cv::Mat mOccupancy;
+    cv::Mat mTrajectories;
+    
+    /**
+     * @brief mTrackOccupancy maps the larva ids to the counts of their visited bins (bin index -> count)
+     */
+    std::unordered_map<unsigned int, std::unordered_map<int, int> > mTrackOccupancy;
+};
+
+#endif // HEATMAPACCUMULATOR_HPP
@@ -51,6 +51,24 @@ void InputGenerator::readMatrices(const std::string& path,
 
 void InputGenerator::readOutputLarvae(const std::string& path, std::vector<Larva>& dstLarvae, std::vector<std::string>& imgPaths, bool& useUndist)
 {
+    if (BinaryResultsReader::isBinaryResultsFile(path))
+    {
+        BinaryResultsReader reader;
+        if (reader.open(path))
+        {
+            useUndist = reader.getUseUndist();
+            imgPaths = reader.getImgPaths();
+            reader.readAllLarvae(dstLarvae);
+        }
+        return;
+    }
+
+    // streaming parser for the block style files written by writeYMLFile (cv::FileStorage for everything else)
+    if (YMLResultsReader::read(path, dstLarvae, imgPaths, useUndist))
+    {
+        return;
+    }
+
     cv::FileStorage fs = cv::FileStorage(path, cv::FileStorage::READ, StringConstats::textFileCoding);
 
     if (fs.isOpened())
@@ -76,9 +94,9 @@ void InputGenerator::readOutputLarvae(const std::string& path, std::vector<Larva
 
 void InputGenerator::readRegionOfInterests(const std::string& path, RegionOfInterestContainer* ROIContainert)
 {
-    cv::FileStorage fs = cv::FileStorage(path, cv::FileStorage::READ, StringConstats::textFileCoding);
+    cv::FileStorage fs;
 
-    if (fs.isOpened())
+    if (openResultsStorage(path, fs))
     {
         fs["ROIContainer"] >> ROIContainert;
     }
@@ -88,9 +106,9 @@ void InputGenerator::readRegionOfInterests(const std::string& path, RegionOfInte
 
 void InputGenerator::readLandmarks(const std::string& path, LandmarkContainer* landmarkContainer)
 {
-    cv::FileStorage fs = cv::FileStorage(path, cv::FileStorage::READ, StringConstats::textFileCoding);
+    cv::FileStorage fs;
 
-    if (fs.isOpened())
+    if (openResultsStorage(path, fs))
     {
         fs["LandmarkContainer"] >> landmarkContainer;
     }
@@ -98,6 +116,88 @@ void InputGenerator::readLandmarks(const std::string& path, LandmarkContainer* l
     fs.release();
 }
 
+std::string InputGenerator::getBinaryResultsPath(const std::string& ymlPath)
+{
+    std::string::size_type dot = ymlPath.find_last_of('.');
+    std::string::size_type slash = ymlPath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return ymlPath + ".fimb";
+    }
+    return ymlPath.substr(0, dot) + ".fimb";
+}
+
+bool InputGenerator::convertYMLToBinary(const std::string& ymlPath, const std::string& binaryPath)
+{
+    std::vector<Larva> larvae;
+    std::vector<std::string> imgPaths;
+    bool useUndist = false;
+    readOutputLarvae(ymlPath, larvae, imgPaths, useUndist);
+
+    return convertYMLToBinary(ymlPath, binaryPath, larvae, imgPaths, useUndist);
+}
+
+bool InputGenerator::convertYMLToBinary(const std::string& ymlPath,
+                                        const std::string& binaryPath,
+                                        const std::vector<Larva>& larvae,
+                                        const std::vector<std::string>& imgPaths,
+                                        const bool useUndist)
+{
+    std::vector<std::string> keys;
+    keys.push_back("ROIContainer");
+    keys.push_back("LandmarkContainer");
+
+    return BinaryResultsWriter::write(binaryPath, larvae, imgPaths, useUndist, readYMLSections(ymlPath, keys));
+}
+
+bool InputGenerator::openResultsStorage(const std::string& path, cv::FileStorage& fs)
+{
+    if (BinaryResultsReader::isBinaryResultsFile(path))
+    {
+        BinaryResultsReader reader;
+        if (!reader.open(path) || reader.getEmbeddedYML().empty())
+        {
+            return false;
+        }
+        return fs.open(reader.getEmbeddedYML(), cv::FileStorage::READ | cv::FileStorage::MEMORY, StringConstats::textFileCoding);
+    }
+
+    return fs.open(path, cv::FileStorage::READ, StringConstats::textFileCoding);
+}
+
+std::string InputGenerator::readYMLSections(const std::string& path, const std::vector<std::string>& keys)
+{
+    std::ifstream ifs(path.c_str());
+    if (!ifs.is_open())
+    {
+        return std::string();
+    }
+
+    // the yml files are written by cv::FileStorage, thus top-level keys start in the first column
+    std::string document;
+    std::string line;
+    bool copy = false;
+    while (std::getline(ifs, line))
+    {
+        if (!line.empty() && line[0] != ' ' && line[0] != '-' && line[0] != '%' && line[0] != '#')
+        {
+            std::string::size_type colon = line.find(':');
+            copy = colon != std::string::npos && std::find(keys.begin(), keys.end(), line.substr(0, colon)) != keys.end();
+        }
+        if (copy)
+        {
+            document.append(line);
+            document.push_back('\n');
+        }
+    }
+
+    if (document.empty())
+    {
+        return document;
+    }
+    return "%YAML:1.0\n" + document;
+}
+
 void InputGenerator::loadConfiguration(const std::string& path)
 {
     cv::FileStorage in = cv::FileStorage(path, cv::FileStorage::READ, StringConstats::textFileCoding);
@@ -113,6 +213,15 @@ void InputGenerator::loadConfiguration(const std::string& path)
         in["iMaxLarvaeArea"]            >> GeneralParameters::iMaxLarvaeArea;
         in["iMinLarvaeArea"]            >> GeneralParameters::iMinLarvaeArea;
 		in["iValleyThreshold"]			>> GeneralParameters::iValleyThreshold;
+        in["bStreamCSVOutput"]          >> GeneralParameters::bStreamCSVOutput;
+        in["iDistanceOutputMode"]       >> GeneralParameters::iDistanceOutputMode;
+        in["iDistanceOutputFormat"]     >> GeneralParameters::iDistanceOutputFormat;
+        in["iDistanceNeighbours"]       >> GeneralParameters::iDistanceNeighbours;
+        in["dDistanceRadius"]           >> GeneralParameters::dDistanceRadius;
+        in["dGroupNeighbourRadius"]     >> GeneralParameters::dGroupNeighbourRadius;
+        in["bSaveHeatMaps"]             >> GeneralParameters::bSaveHeatMaps;
+        in["iHeatMapBinSize"]           >> GeneralParameters::iHeatMapBinSize;
+        in["bSaveOverlayVideo"]         >> GeneralParameters::bSaveOverlayVideo;
 
         /* Read CameraParameter */
         in["dFSP"]          >> CameraParameter::dFPS;
@@ -129,6 +238,8 @@ void InputGenerator::loadConfiguration(const std::string& path)
         /* Read LarvaeExtractionParameters */
         in["LarvaeExtractionParametersbUseDefault"] >> LarvaeExtractionParameters::bUseDefault;
         in["iNumerOfSpinePoints"]                   >> LarvaeExtractionParameters::iNumerOfSpinePoints;
+        in["bUseLazySpineCalculation"]              >> LarvaeExtractionParameters::bUseLazySpineCalculation;
+        in["iMinTrackLengthForSpineCalculation"]    >> LarvaeExtractionParameters::iMinTrackLengthForSpineCalculation;
 
         /* Read IPANContourCurvatureParameters */
         in["bUseDynamicIpanParameterCalculation"]   >> LarvaeExtractionParameters::IPANContourCurvatureParameters::bUseDynamicIpanParameterCalculation;
@@ -147,6 +258,27 @@ void InputGenerator::loadConfiguration(const std::string& path)
         in["iAngleThreshold"]                           >> LarvaeExtractionParameters::StopAndGoCalculation::iAngleThreshold;
         in["iFramesForSpeedCalculation"]                >> LarvaeExtractionParameters::StopAndGoCalculation::iFramesForSpeedCalculation;
         in["iSpeedThreshold"]                           >> LarvaeExtractionParameters::StopAndGoCalculation::iSpeedThreshold;
+
+        /* Read AssignmentParameters (motion prediction; older configurations keep the defaults) */
+        in["bUseMotionPrediction"]  >> LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction;
+        if (!in["dMotionProcessNoise"].empty())
+        {
+            in["dMotionProcessNoise"]       >> LarvaeExtractionParameters::AssignmentParameters::dMotionProcessNoise;
+            in["dMotionMeasurementNoise"]   >> LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise;
+            in["dMotionGatingSigma"]        >> LarvaeExtractionParameters::AssignmentParameters::dMotionGatingSigma;
+        }
+
+        /* Read FeatureParameters (configurations without feature set keep all features) */
+        cv::FileNode featuresNode = in["enabledFeatures"];
+        if (!featuresNode.empty())
+        {
+            std::vector<std::string> featureNames;
+            for (cv::FileNodeIterator it = featuresNode.begin(); it != featuresNode.end(); ++it)
+            {
+                featureNames.push_back(static_cast<std::string>(*it));
+            }
+            FeatureParameters::setEnabledFeatures(featureNames);
+        }
     }
     in.release();
 }
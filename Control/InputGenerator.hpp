@@ -41,12 +41,15 @@
 #include "GUI/LandmarkContainer.hpp"
 
 #include "Utility/FileStorageUtility.hpp"
+#include "BinaryResultsFile.hpp"
+#include "YMLResultsReader.hpp"
 
 #include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iterator>
+#include <algorithm>
 
 
 
@@ -61,8 +64,9 @@ public:
     static void loadConfiguration(std::string const& path);
 
     /**
-     * @brief readOutputLarvae reads all larvaes from a yml file for output
-     * @param path the path where to find the larvae yml file
+     * @brief readOutputLarvae reads all larvaes from a yml or binary results file (see BinaryResultsFormat) for output.
+     *        All tracks are read completely (also from binary results files, which are not kept open).
+     * @param path the path where to find the larvae yml or binary results file
      * @param dstLarvae the container containing all the larvae after reading from the file
      * @param imgPaths contains the paths to the images
      * @param useUndist is a flag to indicate if undistortion (for lens distortion using a camera matrix) is used
@@ -73,7 +77,37 @@ public:
 
     static void readLandmarks(const std::string& path, LandmarkContainer* landmarkContainer);
 
+    /**
+     * @brief getBinaryResultsPath returns the path of the binary results file belonging to the given yml results file
+     */
+    static std::string getBinaryResultsPath(std::string const& ymlPath);
+
+    /**
+     * @brief convertYMLToBinary converts the yml results file to a binary results file (see BinaryResultsFormat)
+     * @return true on success
+     */
+    static bool convertYMLToBinary(std::string const& ymlPath, std::string const& binaryPath);
+
+    /**
+     * @brief convertYMLToBinary writes the larvae already read from the yml results file (readOutputLarvae) together
+     *        with the remaining sections of the yml file (ROIs and landmarks) to a binary results file
+     */
+    static bool convertYMLToBinary(std::string const& ymlPath,
+                                   std::string const& binaryPath,
+                                   std::vector<Larva> const& larvae,
+                                   std::vector<std::string> const& imgPaths,
+                                   bool const useUndist);
+
 private:
+    /**
+     * @brief openResultsStorage opens a yml results file or the yml document embedded in a binary results file
+     */
+    static bool openResultsStorage(std::string const& path, cv::FileStorage& fs);
+
+    /**
+     * @brief readYMLSections returns a yml document with the given top-level sections of the yml file (copied as text)
+     */
+    static std::string readYMLSections(std::string const& path, std::vector<std::string> const& keys);
 
 
 };
@@ -37,6 +37,26 @@ LarvaeContainer::LarvaeContainer(QObject *parent) :
     QObject(parent)
 {
     this->mMaxSpineLength = 0.0;
+    this->mOnlinePostProcessing = false;
+    this->invalidateActiveLarvae();
+}
+
+void LarvaeContainer::rebuildLarvaIndex()
+{
+    this->mLarvaIndex.clear();
+    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    {
+        this->mLarvaIndex[this->mLarvae.at(i).getID()] = i;
+    }
+}
+
+void LarvaeContainer::invalidateActiveLarvae()
+{
+    this->mHasActiveLarvae      = false;
+    this->mActiveTimePoint      = 0;
+    this->mAssignedTimePoint    = 0;
+    this->mActiveLarvae.clear();
+    this->mAssignedLarvae.clear();
 }
 
 Larva* LarvaeContainer::createDefaultLarva(const uint timeStep)
@@ -53,28 +73,41 @@ void LarvaeContainer::readLarvae(const QString &ymlFileName,
                                      this->mLarvae,
                                      imgPaths,
                                      useUndist);
-    double spineLength;
-    foreach(Larva l, this->mLarvae)
+    this->rebuildLarvaIndex();
+    this->invalidateActiveLarvae();
+    for(Larva const& l : this->mLarvae)
     {
-        foreach(uint t, l.getAllTimeSteps())
+        for(Larva::ParameterMap::const_iterator it = l.parameters.begin(); it != l.parameters.end(); ++it)
         {
-            if(l.getSpineLengthAt(t, spineLength))
-            {
-                this->mMaxSpineLength = std::max(spineLength, this->mMaxSpineLength);
-            }
+            this->mMaxSpineLength = std::max(l.parameters.getValue(TrackColumns::SPINE_LENGTH, *it), this->mMaxSpineLength);
         }
     }
     
-    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    Parallel::parallelFor(this->mLarvae.size(), [this](size_t i)
+    {
         this->recalculateLarvaVelocityAndAcceleration(i);
+    });
 }
 
 void LarvaeContainer::removeAllLarvae()
 {
     this->mLarvae.clear();
+    this->mLarvaIndex.clear();
+    this->mOnlineLarvaIDs.clear();
+    this->mGroupMetrics.clear();
+    this->mHeatMaps.clear();
+    this->invalidateActiveLarvae();
     emit reset();
 }
 
+void LarvaeContainer::takeResults(std::vector<Larva> &larvae, GroupMetrics &groupMetrics, HeatMapAccumulator &heatMaps)
+{
+    larvae.swap(this->mLarvae);
+    std::swap(groupMetrics, this->mGroupMetrics);
+    std::swap(heatMaps, this->mHeatMaps);
+    this->removeAllLarvae();
+}
+
 void LarvaeContainer::updateLandmark(Landmark const* l)
 {
     QPointF p;
@@ -105,31 +138,51 @@ void LarvaeContainer::updateLandmark(Landmark const* l)
 
 void LarvaeContainer::removeLandmark(const QString name)
 {
-    std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::getID(QtOpencvCore::qstr2str(name));
+    if(landmarkID < 0)
+    {
+        return;
+    }
     
     for(size_t i = 0; i < this->mLarvae.size(); ++i)
     {
-        timeSteps = this->mLarvae.at(i).getAllTimeSteps();
-        foreach(uint t, timeSteps)
-        {
-            this->mLarvae[i].parameters[t].distanceToLandmark.erase(stdName);
-            this->mLarvae[i].parameters[t].isInLandmark.erase(stdName);
-        }
+        this->mLarvae[i].removeLandmark(landmarkID);
     }
 }
 
 void LarvaeContainer::removeShortTracks(const uint minTrackLenght)
 {
     QVector<uint> removedLarvae;   
+    std::vector<uint> affectedTimePoints;
     this->mLarvae.erase(
                 std::remove_if(this->mLarvae.begin(), this->mLarvae.end(),
                                
-                               [&minTrackLenght, &removedLarvae](const Larva & l) -> bool
+                               [this, &minTrackLenght, &removedLarvae, &affectedTimePoints](const Larva & l) -> bool
     {
         if(l.getAllTimeSteps().size() <= minTrackLenght)
         {
             removedLarvae.push_back(l.getID());
+            
+            // the heat maps must not count removed tracks
+            if(this->mHeatMaps.isEnabled())
+            {
+                std::vector<cv::Point> positions;
+                positions.reserve(l.parameters.size());
+                for(Larva::ParameterMap::const_iterator it = l.parameters.begin(); it != l.parameters.end(); ++it)
+                {
+                    positions.push_back(l.parameters.getMomentum(*it));
+                }
+                this->mHeatMaps.removeTrack(l.getID(), positions);
+            }
+            
+            // the group metrics of all frames of the removed tracks are recalculated
+            if(!this->mGroupMetrics.empty())
+            {
+                for(Larva::ParameterMap::const_iterator it = l.parameters.begin(); it != l.parameters.end(); ++it)
+                {
+                    affectedTimePoints.push_back(*it);
+                }
+            }
             return true;
         }
         else
@@ -138,6 +191,37 @@ void LarvaeContainer::removeShortTracks(const uint minTrackLenght)
         }
     }),this->mLarvae.end());
     
+    this->rebuildLarvaIndex();
+    this->invalidateActiveLarvae();
+    
+    if(!affectedTimePoints.empty())
+    {
+        std::sort(affectedTimePoints.begin(), affectedTimePoints.end());
+        affectedTimePoints.erase(std::unique(affectedTimePoints.begin(), affectedTimePoints.end()), affectedTimePoints.end());
+        
+        // larvae of every affected frame in a single traversal of the remaining tracks
+        std::vector<std::vector<size_t> > frameLarvae(affectedTimePoints.size());
+        for(size_t i = 0; i < this->mLarvae.size(); ++i)
+        {
+            for(Larva::ParameterMap::const_iterator it = this->mLarvae[i].parameters.begin(); it != this->mLarvae[i].parameters.end(); ++it)
+            {
+                auto t = std::lower_bound(affectedTimePoints.begin(), affectedTimePoints.end(), *it);
+                if(t != affectedTimePoints.end() && *t == *it)
+                {
+                    frameLarvae[t - affectedTimePoints.begin()].push_back(i);
+                }
+            }
+        }
+        
+        for(size_t k = 0; k < affectedTimePoints.size(); ++k)
+        {
+            if(this->mGroupMetrics.getFrameValuesAt(affectedTimePoints[k]) != nullptr)
+            {
+                this->updateGroupMetrics(affectedTimePoints[k], frameLarvae[k]);
+            }
+        }
+    }
+    
     foreach (uint i, removedLarvae) 
     {
         emit sendRemovedResultLarvaID(i);   
@@ -294,13 +378,14 @@ void LarvaeContainer::attachToLarva(const uint toLarvaID, const uint fromLarvaID
             
             for(int i = minTime; i <= maxTime; ++i)
             {
-                if(this->mLarvae[indexFromLarva].parameters.find(i) == this->mLarvae[indexFromLarva].parameters.end())
+                if(this->mLarvae[indexFromLarva].parameters.count(i) == 0)
                 {
                     continue;
                 }
                 else
                 {
-                    this->mLarvae[indexToLarva].parameters[i] = this->mLarvae[indexFromLarva].parameters[i];
+                    this->mLarvae[indexToLarva].parameters.copy(this->mLarvae[indexFromLarva].parameters, i, i);
+                    this->mLarvae[indexToLarva].copyLandmarkValues(this->mLarvae[indexFromLarva], i, i);
                 }
             }
             
@@ -314,6 +399,8 @@ void LarvaeContainer::attachToLarva(const uint toLarvaID, const uint fromLarvaID
             this->recalculateLarvaDistanceParameter(toLarvaID); 
             this->recalculateLarvaVelocityAndAcceleration(toLarvaID);
             this->mLarvae.erase(this->mLarvae.begin() + indexFromLarva);
+            this->rebuildLarvaIndex();
+            this->invalidateActiveLarvae();
             emit sendRemovedResultLarvaID(fromLarvaID);
         }
     }
@@ -324,7 +411,9 @@ bool LarvaeContainer::copyModel2PrevTimeStep(const uint larvaID, const uint curr
     size_t larvaIndex;
     if(this->getIndexOfLarva(larvaID, larvaIndex))
     {
-        this->mLarvae[larvaIndex].parameters[currentTime - 1] = this->mLarvae[larvaIndex].parameters[currentTime];
+        this->mLarvae[larvaIndex].parameters.copy(this->mLarvae[larvaIndex].parameters, currentTime, currentTime - 1);
+        this->mLarvae[larvaIndex].copyLandmarkValues(this->mLarvae[larvaIndex], currentTime, currentTime - 1);
+        this->invalidateActiveLarvae();
         
         std::vector<uint> timeSteps = this->mLarvae.at(larvaIndex).getAllTimeSteps();
         for(size_t i = 0; i < timeSteps.size(); ++i)
@@ -351,7 +440,9 @@ bool LarvaeContainer::copyModel2NextTimeStep(const uint larvaID, const uint curr
     size_t larvaIndex;
     if(this->getIndexOfLarva(larvaID, larvaIndex))
     {
-        this->mLarvae[larvaIndex].parameters[currentTime + 1] = this->mLarvae[larvaIndex].parameters[currentTime];
+        this->mLarvae[larvaIndex].parameters.copy(this->mLarvae[larvaIndex].parameters, currentTime, currentTime + 1);
+        this->mLarvae[larvaIndex].copyLandmarkValues(this->mLarvae[larvaIndex], currentTime, currentTime + 1);
+        this->invalidateActiveLarvae();
         this->updateGoPhaseIndicator(larvaID, currentTime + 1);
         this->updateMovementDirection(larvaID, currentTime + 1);
         this->recalculateLarvaDistanceParameter(larvaID);
@@ -380,7 +471,7 @@ void LarvaeContainer::recalculateLarvaDistanceToOrigin(const size_t larvaIndex)
     {
         if(this->mLarvae.at(larvaIndex).getMomentumAt(t, pt))
         {
-            this->mLarvae[larvaIndex].parameters[t].distToOrigin = Calc::eucledianDist(p0, pt);
+            this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::DIST_TO_ORIGIN, t, Calc::eucledianDist(p0, pt));
         }
     }
 }
@@ -400,8 +491,8 @@ void LarvaeContainer::recalculateLarvaMomentumDistance(const size_t larvaIndex)
             momentumDist = Calc::eucledianDist(p1,p2);
             accDist += momentumDist;
             
-            this->mLarvae[larvaIndex].parameters[timeSteps.at(i)].momentumDist = momentumDist;
-            this->mLarvae[larvaIndex].parameters[timeSteps.at(i)].accDist = accDist;
+            this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::MOMENTUM_DIST, timeSteps.at(i), momentumDist);
+            this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::ACC_DIST, timeSteps.at(i), accDist);
         }
     }
 }
@@ -421,7 +512,7 @@ void LarvaeContainer::recalculateLarvaVelocityAndAcceleration(const size_t larva
         
         if(std::abs(t0-t1) != frameWindow)
         {
-            this->mLarvae[larvaIndex].parameters[t0].velosity = std::numeric_limits<double>::min();
+            this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::VELOSITY, t0, std::numeric_limits<double>::min());
         }
         else
         {            
@@ -429,7 +520,7 @@ void LarvaeContainer::recalculateLarvaVelocityAndAcceleration(const size_t larva
                     this->mLarvae.at(larvaIndex).getSpinePointAt(t1,mLarvae.at(larvaIndex).getNSpinePoints()-1, p1))
             {
                 velosity     = Calc::eucledianDist(p0, p1) / static_cast<double>(std::abs(t1-t0));
-                this->mLarvae[larvaIndex].parameters[t1].velosity = velosity;
+                this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::VELOSITY, t1, velosity);
             }
         }
     }
@@ -437,7 +528,7 @@ void LarvaeContainer::recalculateLarvaVelocityAndAcceleration(const size_t larva
     for(int i = 0; i < time.size() && i < frameWindow; ++i)
     {
         int t = time.at(i);
-        this->mLarvae[larvaIndex].parameters[t].velosity = std::numeric_limits<double>::min();
+        this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::VELOSITY, t, std::numeric_limits<double>::min());
     }
     
     this->recalculateLarvaAcceleration(larvaIndex);
@@ -452,7 +543,7 @@ void LarvaeContainer::recalculateLarvaAcceleration(const size_t larvaIndex)
     if (!time.empty())
     {
         // there is no acceleration value for the first timestep
-        this->mLarvae[larvaIndex].parameters[time.front()].acceleration = std::numeric_limits<double>::min();
+        this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::ACCELERATION, time.front(), std::numeric_limits<double>::min());
         
         for(int i = time.size()-1; i >= 1; --i)
         {
@@ -462,14 +553,14 @@ void LarvaeContainer::recalculateLarvaAcceleration(const size_t larvaIndex)
             if(this->mLarvae.at(larvaIndex).getVelosityAt(t0, v0) && this->mLarvae.at(larvaIndex).getVelosityAt(t1, v1))
             {
                 acceleration = (v1 - v0) / static_cast<double>(std::abs(t1-t0));
-                this->mLarvae[larvaIndex].parameters[t0].acceleration = acceleration;
+                this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::ACCELERATION, t0, acceleration);
             }
             else
             {
-                this->mLarvae[larvaIndex].parameters[t0].acceleration = std::numeric_limits<double>::min();
+                this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::ACCELERATION, t0, std::numeric_limits<double>::min());
             }
             
-            this->mLarvae[larvaIndex].parameters[time.front()].acceleration = std::numeric_limits<double>::min();
+            this->mLarvae[larvaIndex].parameters.setValue(TrackColumns::ACCELERATION, time.front(), std::numeric_limits<double>::min());
         }
     }
 }
@@ -477,7 +568,7 @@ void LarvaeContainer::recalculateLarvaAcceleration(const size_t larvaIndex)
 void LarvaeContainer::calcLandmarkParameter(QString const& name, QPointF const& p)
 {
     std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::registerLandmark(QtOpencvCore::qstr2str(name));
     cv::Point momentum;
     double dist = 0.0;
     
@@ -489,8 +580,7 @@ void LarvaeContainer::calcLandmarkParameter(QString const& name, QPointF const&
             if(this->mLarvae.at(i).getMomentumAt(t, momentum))
             {
                 dist = Calc::eucledianDist(momentum, p); 
-                this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = dist;
-                this->mLarvae[i].parameters[t].isInLandmark[stdName] = false;
+                this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, dist, false);
             }
         }
     }
@@ -501,7 +591,7 @@ void LarvaeContainer::calcLandmarkParameter(QString const& name, QPointF const&
 void LarvaeContainer::calcLandmarkParameter(QString const& name, QLineF const& l)
 {
     std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::registerLandmark(QtOpencvCore::qstr2str(name));
     cv::Point momentum;
     double dist = 0.0;
     
@@ -513,8 +603,7 @@ void LarvaeContainer::calcLandmarkParameter(QString const& name, QLineF const& l
             if(this->mLarvae.at(i).getMomentumAt(t, momentum))
             {
                 dist = Calc::eucledianDist(QtOpencvCore::point2qpoint(momentum), l); 
-                this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = dist;
-                this->mLarvae[i].parameters[t].isInLandmark[stdName] = false;
+                this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, dist, false);
             }
         }
     }
@@ -525,7 +614,7 @@ void LarvaeContainer::calcLandmarkParameter(QString const& name, QLineF const& l
 void LarvaeContainer::calcLandmarkParameter(const QString &name, const QRectF &r, const bool ellipse)
 {
     std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::registerLandmark(QtOpencvCore::qstr2str(name));
     cv::Point momentum;
     double dist = 0.0;
     QPointF p;
@@ -544,13 +633,11 @@ void LarvaeContainer::calcLandmarkParameter(const QString &name, const QRectF &r
                     if(!r.contains(p))
                     {
                         dist = Calc::eucledianDist(p, r, ellipse); 
-                        this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = dist;
-                        this->mLarvae[i].parameters[t].isInLandmark[stdName] = false;
+                        this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, dist, false);
                     }
                     else
                     {
-                        this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = 0.0;
-                        this->mLarvae[i].parameters[t].isInLandmark[stdName] = true;
+                        this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, 0.0, true);
                     }
                 }
                 else
@@ -558,13 +645,11 @@ void LarvaeContainer::calcLandmarkParameter(const QString &name, const QRectF &r
                     if(!Calc::isPointInEllipse(p, r))
                     {
                         dist = Calc::eucledianDist(p, r, ellipse); 
-                        this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = dist;
-                        this->mLarvae[i].parameters[t].isInLandmark[stdName] = false;
+                        this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, dist, false);
                     }
                     else
                     {
-                        this->mLarvae[i].parameters[t].distanceToLandmark[stdName] = 0.0;
-                        this->mLarvae[i].parameters[t].isInLandmark[stdName] = true;
+                        this->mLarvae[i].setLandmarkDistanceAt(t, landmarkID, 0.0, true);
                     }
                 }
             }
@@ -577,7 +662,7 @@ void LarvaeContainer::calcLandmarkParameter(const QString &name, const QRectF &r
 void LarvaeContainer::calcBearingAngle(const QString &name, const QPointF &landmarkPoint)
 {
     std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::registerLandmark(QtOpencvCore::qstr2str(name));
     cv::Point momentum, tail;
     for(size_t i = 0; i < this->mLarvae.size(); ++i)
     {
@@ -597,7 +682,7 @@ void LarvaeContainer::calcBearingAngle(const QString &name, const QPointF &landm
                 QPointF TP = landmarkPoint - T;
                 
                 double bearinAngle = Calc::calcInnerAngleOfVectors(TM, TP);
-                this->mLarvae[i].parameters[t].bearinAngle[stdName] = bearinAngle;
+                this->mLarvae[i].setLandmarkBearingAngleAt(t, landmarkID, bearinAngle);
             }
         }
     }
@@ -606,7 +691,7 @@ void LarvaeContainer::calcBearingAngle(const QString &name, const QPointF &landm
 void LarvaeContainer::calcBearingAngle(const QString& name, const QLineF& l)
 {
     std::vector<uint> timeSteps;
-    std::string stdName = QtOpencvCore::qstr2str(name);
+    int landmarkID = LandmarkRegistry::registerLandmark(QtOpencvCore::qstr2str(name));
     cv::Point spineMidPoint, tail;
     for(size_t i = 0; i < this->mLarvae.size(); ++i)
     {
@@ -629,7 +714,7 @@ void LarvaeContainer::calcBearingAngle(const QString& name, const QLineF& l)
                 QPointF TP = pClosestPointToTail - T;
                 
                 double bearinAngle = Calc::calcInnerAngleOfVectors(TM, TP);
-                this->mLarvae[i].parameters[t].bearinAngle[stdName] = bearinAngle;
+                this->mLarvae[i].setLandmarkBearingAngleAt(t, landmarkID, bearinAngle);
             }
         }
     }
@@ -654,6 +739,8 @@ bool LarvaeContainer::eraseLarva(const uint larvaID)
     if(this->getIndexOfLarva(larvaID, larvaIndex))
     {
         this->mLarvae.erase(this->mLarvae.begin() + larvaIndex);
+        this->rebuildLarvaIndex();
+        this->invalidateActiveLarvae();
         emit sendRemovedResultLarvaID(larvaID);
         return true;
     }
@@ -665,34 +752,122 @@ void LarvaeContainer::saveResultLarvae(const std::vector<std::string> &imgPaths,
                                        const RegionOfInterestContainer *ROIContainer, 
                                        const LandmarkContainer *landmarkContainer)
 {
-    QString saveAs = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("YAML-File (*.yml)"));
-    if(!saveAs.isNull() && !saveAs.isEmpty())
+    QString ymlPath = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("YAML-File (*.yml)"));
+    QString csvPath = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("CSV-File (*.csv)"));
+    QString imgPath = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("TIF-File (*.tif)"));
+    
+    bool const saveYML = !ymlPath.isNull() && !ymlPath.isEmpty();
+    bool const saveCSV = !csvPath.isNull() && !csvPath.isEmpty();
+    
+    // the files are written in the background from a copy of the larvae, thus the larvae can be modified meanwhile
+    std::shared_ptr<std::vector<Larva> const> larvae;
+    if(saveYML || saveCSV)
+    {
+        larvae = std::make_shared<std::vector<Larva> const>(this->mLarvae);
+    }
+    std::vector<PersistenceQueue::Writer> writers;
+    
+    if(saveYML)
+    {
+        std::string const path = ymlPath.toStdString();
+        std::string const sceneYML = OutputGenerator::serializeSceneYML(ROIContainer, landmarkContainer);
+        PersistenceQueue::Writer writer;
+        writer.path = ymlPath;
+        writer.write = [larvae, path, imgPaths, useUndist, sceneYML]()
+        {
+            return OutputGenerator::writeYMLFile(path, *larvae, imgPaths, useUndist, sceneYML);
+        };
+        writers.push_back(writer);
+    }
+    
+    if(saveCSV)
     {
-        OutputGenerator::writeYMLFile(saveAs.toStdString(), this->mLarvae, imgPaths, useUndist, ROIContainer, landmarkContainer);
+        std::string const path = csvPath.toStdString();
+        std::vector<std::string> const landmarkNames = CSVWriter::getLandmarkNames(landmarkContainer);
+        size_t const movieLength = imgPaths.size();
+        PersistenceQueue::Writer writer;
+        writer.path = csvPath;
+        writer.write = [larvae, path, movieLength, landmarkNames]()
+        {
+            return OutputGenerator::writeCSVFile(path, *larvae, movieLength, landmarkNames);
+        };
+        writers.push_back(writer);
     }
     
-    saveAs = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("CSV-File (*.csv)"));
-    if(!saveAs.isNull() && !saveAs.isEmpty())
+    if(!imgPath.isNull() && !imgPath.isEmpty())
     {
-        OutputGenerator::writeCSVFile(saveAs.toStdString(), this->mLarvae,imgPaths.size(), landmarkContainer);
+        PersistenceQueue::Writer writer;
+        writer.path = imgPath;
+        writer.write = [imgPath, img]()
+        {
+            return OutputGenerator::saveResultImage(imgPath, img);
+        };
+        writers.push_back(writer);
     }
     
-    saveAs = QFileDialog::getSaveFileName(nullptr, QString("Save (modified) Larvae As..."), QDir::currentPath(), tr("TIF-File (*.tif)"));
-    if(!saveAs.isNull() && !saveAs.isEmpty())
+    if(!writers.empty())
     {
-        OutputGenerator::saveResultImage(saveAs, img);
+        this->mPersistenceQueue.enqueue(QString("Save (modified) Larvae"), std::move(writers));
     }
 }
 
+void LarvaeContainer::saveBinaryResults(const std::string &ymlPath, 
+                                        const std::string &binaryPath, 
+                                        const std::vector<std::string> &imgPaths, 
+                                        const bool useUndist)
+{
+    std::shared_ptr<std::vector<Larva> const> larvae = std::make_shared<std::vector<Larva> const>(this->mLarvae);
+    
+    std::vector<PersistenceQueue::Writer> writers;
+    PersistenceQueue::Writer writer;
+    writer.path = QtOpencvCore::str2qstr(binaryPath);
+    writer.write = [larvae, ymlPath, binaryPath, imgPaths, useUndist]()
+    {
+        return InputGenerator::convertYMLToBinary(ymlPath, binaryPath, *larvae, imgPaths, useUndist);
+    };
+    writers.push_back(writer);
+    
+    this->mPersistenceQueue.enqueue(QString("Binary Results File"), std::move(writers));
+}
+
 void LarvaeContainer::processUntrackedLarvae(const uint timePoint)
 {
-    for(size_t i = 0; i < mLarvae.size(); ++i)
+    if(this->mHasActiveLarvae 
+            && timePoint > this->mActiveTimePoint
+            && (this->mAssignedLarvae.empty() || this->mAssignedTimePoint == timePoint))
     {
-        if(!this->isAssignedAt(mLarvae.at(i).getID(), timePoint))
+        // only the larvae of the last frame can lapse
+        for(size_t i : this->mActiveLarvae)
         {
-            mLarvae.at(i).contour.clear(); // last contour not needed anymore
+            if(this->mLarvae.at(i).parameters.count(timePoint) == 0)
+            {
+                this->mLarvae.at(i).contour.clear(); // last contour not needed anymore
+            }
         }
+        
+        std::sort(this->mAssignedLarvae.begin(), this->mAssignedLarvae.end());
+        this->mAssignedLarvae.erase(std::unique(this->mAssignedLarvae.begin(), this->mAssignedLarvae.end()), this->mAssignedLarvae.end());
+        this->mActiveLarvae.swap(this->mAssignedLarvae);
     }
+    else
+    {
+        this->mActiveLarvae.clear();
+        for(size_t i = 0; i < mLarvae.size(); ++i)
+        {
+            if(this->mLarvae.at(i).parameters.count(timePoint) == 0)
+            {
+                mLarvae.at(i).contour.clear(); // last contour not needed anymore
+            }
+            else
+            {
+                this->mActiveLarvae.push_back(i);
+            }
+        }
+    }
+    
+    this->mAssignedLarvae.clear();
+    this->mHasActiveLarvae = true;
+    this->mActiveTimePoint = timePoint;
 }
 
 QStringList LarvaeContainer::getAllLarvaeIDs() const
@@ -700,7 +875,7 @@ QStringList LarvaeContainer::getAllLarvaeIDs() const
     QStringList ids;
     foreach(auto& l, this->mLarvae)
     {
-        QString id = QString("%1 -> [%2 %3]").arg(QString::number(l.getID())).arg(QString::number(l.getAllTimeSteps().front())).arg(QString::number(l.getAllTimeSteps().back()));
+        QString id = QString("%1 -> [%2 %3]").arg(QString::number(l.getID())).arg(QString::number(l.getFirstTimePoint())).arg(QString::number(l.getLastTimePoint()));
         ids << id;
     }
     
@@ -719,17 +894,34 @@ bool LarvaeContainer::getLarva(const uint index, Larva &l)
 
 bool LarvaeContainer::getLarvaByID(uint larvaID, Larva& l)
 {
-    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    Larva const* larva = this->findLarva(larvaID);
+    if(larva != nullptr)
     {
-        if(this->mLarvae.at(i).getID() == larvaID)
-        {
-            l = this->mLarvae.at(i);
-            return true;
-        }
+        l = *larva;
+        return true;
     }
     return false;
 }
 
+const Larva *LarvaeContainer::getLarvaAt(const uint index) const
+{
+    if(index < this->mLarvae.size())
+    {
+        return &this->mLarvae.at(index);
+    }
+    return nullptr;
+}
+
+const Larva *LarvaeContainer::findLarva(const uint larvaID) const
+{
+    size_t index;
+    if(this->getIndexOfLarva(larvaID, index))
+    {
+        return &this->mLarvae.at(index);
+    }
+    return nullptr;
+}
+
 std::vector<uint> LarvaeContainer::getAllTimesteps(const uint larvaID)
 {
     size_t index;
@@ -789,12 +981,44 @@ QPair<int, int> LarvaeContainer::getStartEndTimesteps(const uint larvaID)
     return res;
 }
 
+void LarvaeContainer::getLarvaeAt(const uint timePoint, std::vector<const Larva *> &larvae) const
+{
+    larvae.clear();
+    if(this->hasActiveLarvaeAt(timePoint))
+    {
+        larvae.reserve(this->mActiveLarvae.size());
+        for(size_t i : this->mActiveLarvae)
+        {
+            larvae.push_back(&this->mLarvae.at(i));
+        }
+        return;
+    }
+    
+    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    {
+        if(this->mLarvae.at(i).parameters.count(timePoint) > 0)
+        {
+            larvae.push_back(&this->mLarvae.at(i));
+        }
+    }
+}
+
 std::vector<int> LarvaeContainer::getAllValidLarvaeIDS(const uint timePoint)
 {
     std::vector<int> res;
+    if(this->hasActiveLarvaeAt(timePoint))
+    {
+        res.reserve(this->mActiveLarvae.size());
+        for(size_t i : this->mActiveLarvae)
+        {
+            res.push_back(this->mLarvae.at(i).getID());
+        }
+        return res;
+    }
+    
     for(size_t i = 0; i < this->mLarvae.size(); ++i)
     {
-        if(this->isAssignedAt(this->mLarvae.at(i).getID(), timePoint))
+        if(this->mLarvae.at(i).parameters.count(timePoint) > 0)
         {
             res.push_back(this->mLarvae.at(i).getID());
         }
@@ -802,31 +1026,92 @@ std::vector<int> LarvaeContainer::getAllValidLarvaeIDS(const uint timePoint)
     return res;
 }
 
-bool LarvaeContainer::larvaHasPointInContour(const uint timePoint, const uint larvaID, const FIMTypes::contour_t &rawLarvaContour)
+void LarvaeContainer::getTrackSnapshot(const uint timePoint, TrackSnapshot &snapshot) const
+{
+    snapshot.clear();
+    
+    bool const useActiveLarvae = this->hasActiveLarvaeAt(timePoint);
+    size_t const n = useActiveLarvae ? this->mActiveLarvae.size() : this->mLarvae.size();
+    snapshot.reserve(n);
+    
+    for(size_t k = 0; k < n; ++k)
+    {
+        Larva const& l = this->mLarvae.at(useActiveLarvae ? this->mActiveLarvae.at(k) : k);
+        if(l.parameters.count(timePoint) == 0)
+        {
+            continue;
+        }
+        
+        cv::Point const momentum = l.parameters.getMomentum(timePoint);
+        size_t const spineSize = l.parameters.getSpineSize(timePoint);
+        uint midPointIndex = l.getSpineMidPointIndex();
+        bool hasMidPoint = spineSize > midPointIndex;
+        cv::Point const midPoint = hasMidPoint ? l.parameters.getSpinePoint(timePoint, midPointIndex) : cv::Point();
+        
+        snapshot.larvaIDs.push_back(l.getID());
+        snapshot.momentumX.push_back(static_cast<float>(momentum.x));
+        snapshot.momentumY.push_back(static_cast<float>(momentum.y));
+        snapshot.midPointX.push_back(static_cast<float>(midPoint.x));
+        snapshot.midPointY.push_back(static_cast<float>(midPoint.y));
+        snapshot.hasMidPoint.push_back(hasMidPoint ? 1 : 0);
+        snapshot.spineLength.push_back(l.parameters.getValue(TrackColumns::SPINE_LENGTH, timePoint));
+        snapshot.area.push_back(l.parameters.getValue(TrackColumns::AREA, timePoint));
+        
+        double footprintRadius = 0.0;
+        for(size_t j = 0; j < spineSize; ++j)
+        {
+            footprintRadius = std::max(footprintRadius, Calc::eucledianDist(l.parameters.getSpinePoint(timePoint, j), momentum));
+        }
+        snapshot.footprintRadius.push_back(footprintRadius);
+        
+        // predicted displacement until the next time point
+        cv::Point2d predicted;
+        double stdDev;
+        if(LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction && l.motion.predict(timePoint + 1, predicted, stdDev))
+        {
+            snapshot.predictedShiftX.push_back(static_cast<float>(predicted.x - momentum.x));
+            snapshot.predictedShiftY.push_back(static_cast<float>(predicted.y - momentum.y));
+            snapshot.predictionStdDev.push_back(stdDev);
+        }
+        else
+        {
+            snapshot.predictedShiftX.push_back(0.0f);
+            snapshot.predictedShiftY.push_back(0.0f);
+            snapshot.predictionStdDev.push_back(-1.0);
+        }
+    }
+}
+
+bool LarvaeContainer::larvaHasPointInLabel(const uint timePoint, 
+                                           const uint larvaID, 
+                                           const LabelImage &labels, 
+                                           const int label, 
+                                           const FIMTypes::contour_t &contour) const
 {
     size_t i;
     bool retBool = false;
     
     if(this->getIndexOfLarva(larvaID, i))
     {
-        FIMTypes::spine_t spine;
-        cv::Point momentum;
-        
-        if (this->getSpineAt(larvaID, timePoint-1, spine))
+        Larva::ParameterMap const& parameters = this->mLarvae.at(i).parameters;
+        if(parameters.count(timePoint-1) > 0)
         {
-            this->getMomentumAt(larvaID, timePoint-1, momentum);
-            int momInContour = cv::pointPolygonTest(rawLarvaContour, momentum, false);
+            // strictly inside the contour (the label image also covers the contour border)
+            auto isInside = [&](cv::Point const& p)
+            {
+                return labels.getLabelAt(p) == label && cv::pointPolygonTest(contour, p, false) > 0;
+            };
+            
             // momentum in contour
-            if (momInContour > 0)
+            if(isInside(parameters.getMomentum(timePoint-1)))
             {
                 retBool = true;
             }
-            else if(!retBool)
+            else
             {
-                foreach(auto spinePoint, spine)
+                for(size_t j = 0; j < parameters.getSpineSize(timePoint-1); ++j)
                 {
-                    int spinePointInContour = cv::pointPolygonTest(rawLarvaContour, spinePoint, false);
-                    if (spinePointInContour > 0)
+                    if(isInside(parameters.getSpinePoint(timePoint-1, j)))
                     {
                         retBool = true;
                         break;
@@ -1254,11 +1539,12 @@ QVector<double> LarvaeContainer::getAllDistancesToLandmark(const uint larvaID, c
     QVector<double> res;
     size_t i;
     double val;
+    int id = LandmarkRegistry::getID(landmarkID.toStdString());
     if(this->getIndexOfLarva(larvaID, i))
     {
         for(int t = 0; t < this->mMaximumNumberOfTimePoints; ++t)
         {
-            if(this->mLarvae.at(i).getDistanceToLandmark(t, landmarkID.toStdString(), val))
+            if(this->mLarvae.at(i).getDistanceToLandmark(t, id, val))
             {
                 res << val;
             }
@@ -1277,11 +1563,12 @@ QVector<double> LarvaeContainer::getAllBearingAnglesToLandmark(const uint larvaI
     QVector<double> res;
     size_t i;
     double val;
+    int id = LandmarkRegistry::getID(landmarkID.toStdString());
     if(this->getIndexOfLarva(larvaID, i))
     {
         for(int t = 0; t < this->mMaximumNumberOfTimePoints; ++t)
         {
-            if(this->mLarvae.at(i).getBearingAngleToLandmark(t, landmarkID.toStdString(), val))
+            if(this->mLarvae.at(i).getBearingAngleToLandmark(t, id, val))
             {
                 res << val;
             }
@@ -1391,17 +1678,17 @@ FIMTypes::spine_t LarvaeContainer::calcSpine(QPainterPath const& spinePath)
 void LarvaeContainer::updateLarvaSpine(const int index, 
                                        const uint time, 
                                        QPainterPath const& paintSpine, 
-                                       std::vector<double> const& radii)
+                                       FIMTypes::radii_t const& radii)
 {
     FIMTypes::spine_t spine                                                         = this->calcSpine(paintSpine);
     double spineLength                                                      = Calc::calcSpineLength(spine);
     double mainBodyBendingAngle                                             = Calc::calcAngle(spine.at((spine.size() - 1) / 2), 
                                                                                               spine.at(0), 
                                                                                               spine.at((spine.size() - 1)));    
-    this->mLarvae[index].parameters[time].spine                       = spine;
-    this->mLarvae[index].parameters[time].spineLength                 = spineLength;
-    this->mLarvae[index].parameters[time].mainBodyBendingAngle        = mainBodyBendingAngle;
-    this->mLarvae[index].parameters[time].spineRadii                  = radii;
+    this->mLarvae[index].parameters.setSpine(time, spine);
+    this->mLarvae[index].parameters.setValue(TrackColumns::SPINE_LENGTH, time, spineLength);
+    this->mLarvae[index].parameters.setValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, time, mainBodyBendingAngle);
+    this->mLarvae[index].parameters.setSpineRadii(time, radii);
 }
 
 void LarvaeContainer::updateLarvaMomentum(const int index, 
@@ -1416,8 +1703,8 @@ void LarvaeContainer::updateLarvaMomentum(const int index,
     {
         momentumDist = Calc::eucledianDist(momentum, consecutiveMomentum);
     }
-    this->mLarvae[index].parameters[time].momentum        = momentum;
-    this->mLarvae[index].parameters[time].momentumDist    = momentumDist;
+    this->mLarvae[index].parameters.setMomentum(time, momentum);
+    this->mLarvae[index].parameters.setValue(TrackColumns::MOMENTUM_DIST, time, momentumDist);
 }
 
 void LarvaeContainer::updateLarvaArea(const int index, 
@@ -1425,7 +1712,7 @@ void LarvaeContainer::updateLarvaArea(const int index,
                                       QPolygonF const& paintPolygon)
 {
     double area                                         = Calc::calcPolygonArea(paintPolygon);
-    this->mLarvae[index].parameters[time].area    = area;
+    this->mLarvae[index].parameters.setValue(TrackColumns::AREA, time, area);
 }
 
 void LarvaeContainer::updateLarvaPerimeter(const int index, 
@@ -1433,7 +1720,7 @@ void LarvaeContainer::updateLarvaPerimeter(const int index,
                                            QPolygonF const& paintPolygon)
 {
     double perimeter                                        = Calc::calcPerimeter(paintPolygon);
-    this->mLarvae[index].parameters[time].perimeter   = perimeter;
+    this->mLarvae[index].parameters.setValue(TrackColumns::PERIMETER, time, perimeter);
 }
 
 void LarvaeContainer::updateLarvaDistance2Origin(const int index)
@@ -1444,10 +1731,10 @@ void LarvaeContainer::updateLarvaDistance2Origin(const int index)
     
     for(unsigned int i = 0; i < timeSteps.size(); ++i) 
     {
-        if(this->mLarvae.at(index).getMomentumAt(i, momentum))
+        if(this->mLarvae.at(index).getMomentumAt(timeSteps.at(i), momentum))
         {
             distToOrigin = Calc::eucledianDist(this->mLarvae.at(index).getOrigin(), momentum);
-            this->mLarvae[index].parameters[timeSteps.at(i)].distToOrigin = distToOrigin;
+            this->mLarvae[index].parameters.setValue(TrackColumns::DIST_TO_ORIGIN, timeSteps.at(i), distToOrigin);
         }
     }
 }
@@ -1459,10 +1746,10 @@ void LarvaeContainer::updateLarvaAccumulatedDistance(const int index)
     std::vector<unsigned int> timeSteps = this->mLarvae.at(index).getAllTimeSteps();
     for(unsigned int i = 1; i < timeSteps.size(); ++i) 
     {
-        if(this->mLarvae.at(index).getMomentumAt(i-1, p1) && this->mLarvae.at(index).getMomentumAt(i, p2))
+        if(this->mLarvae.at(index).getMomentumAt(timeSteps.at(i-1), p1) && this->mLarvae.at(index).getMomentumAt(timeSteps.at(i), p2))
         {
             accDist += Calc::eucledianDist(p1, p2);
-            this->mLarvae[index].parameters[timeSteps.at(i)].accDist = accDist;
+            this->mLarvae[index].parameters.setValue(TrackColumns::ACC_DIST, timeSteps.at(i), accDist);
         }
     }
     
@@ -1478,7 +1765,7 @@ void LarvaeContainer::updateIsCoiledIndicator(const int index, const uint time)
     double midPointRadius;
     double midCirclePeri2PeriRatio;
     
-    std::vector<double> radii;
+    FIMTypes::radii_t radii;
     
     if(     this->mLarvae.at(index).getPerimeterAt(time, perimeter) && 
             this->mLarvae.at(index).getSpineLengthAt(time, spineLength) &&
@@ -1505,11 +1792,11 @@ void LarvaeContainer::updateIsCoiledIndicator(const int index, const uint time)
             if( peri2spineLengthRatio >= peri2spineLengthThresh &&
                     midCirclePeri2PeriRatio >= midCirclePeri2PeriThresh)
             {
-                this->mLarvae[index].parameters[time].isCoiled = true;
+                this->mLarvae[index].parameters.setIndicator(TrackColumns::IS_COILED, time, true);
             }
             else
             {
-                this->mLarvae[index].parameters[time].isCoiled = false;
+                this->mLarvae[index].parameters.setIndicator(TrackColumns::IS_COILED, time, false);
             }
         }
     }
@@ -1559,7 +1846,7 @@ void LarvaeContainer::updateGoPhaseIndicator(const int index, const uint time)
             phaseIndicator = 0;
         }
     }
-    this->mLarvae[index].parameters[time].goPhase =  phaseIndicator;
+    this->mLarvae[index].parameters.setGoPhase(time, phaseIndicator);
 }
 
 void LarvaeContainer::updateTurnIndicator(const int index, const uint time)
@@ -1573,8 +1860,8 @@ void LarvaeContainer::updateTurnIndicator(const int index, const uint time)
     
     if(this->mLarvae.at(index).getMainBodyBendingAngleAt(time, mainBodyBendingAngle))
     {
-        this->mLarvae[index].parameters[time].isLeftBended    = this->calcLeftTurnIndicator(mainBodyBendingAngle, bendingAngleThresh);
-        this->mLarvae[index].parameters[time].isRightBended   = this->calcRightTurnIndicator(mainBodyBendingAngle, bendingAngleThresh);
+        this->mLarvae[index].parameters.setIndicator(TrackColumns::IS_LEFT_BENDED, time, this->calcLeftTurnIndicator(mainBodyBendingAngle, bendingAngleThresh));
+        this->mLarvae[index].parameters.setIndicator(TrackColumns::IS_RIGHT_BENDED, time, this->calcRightTurnIndicator(mainBodyBendingAngle, bendingAngleThresh));
     }
 }
 
@@ -1610,112 +1897,226 @@ void LarvaeContainer::updateMovementDirection(const int index, const uint time)
         }
     }
     
-    this->mLarvae[index].parameters[time].movementDirection = movementDirection;
+    this->mLarvae[index].parameters.setValue(TrackColumns::MOVEMENT_DIRECTION, time, movementDirection);
 }
 
 bool LarvaeContainer::getIndexOfLarva(const uint id, size_t& index) const
 {
-    for(unsigned int i = 0; i < this->mLarvae.size(); ++i)
+    auto it = this->mLarvaIndex.find(id);
+    if(it != this->mLarvaIndex.end())
     {
-        if(this->mLarvae.at(i).getID() == id)
-        {
-            index = i;
-            return true;
-        }
+        index = it->second;
+        return true;
     }
     return false;
 }
 
 void LarvaeContainer::insertRawLarva(const uint larvaID, 
                                      const uint timePoint, 
-                                     const RawLarva &rawLarva)
+                                     RawLarva &&rawLarva)
 {
     size_t larvaIndex;
     if(this->getIndexOfLarva(larvaID, larvaIndex))
     {
-        FIMTypes::spine_t spine;
-        spine.reserve(rawLarva.getDiscreteSpine().size());
-        
-        std::vector<double> radii;
-        radii.reserve(rawLarva.getLarvalRadii().size());
-        
-        bool invertParameters = this->changeDirectionality(larvaIndex, timePoint,rawLarva);
-        
-        spine = (invertParameters) ? this->reverseVec(rawLarva.getDiscreteSpine())  : rawLarva.getDiscreteSpine();
-        radii = (invertParameters) ? this->reverseVec(rawLarva.getLarvalRadii())    : rawLarva.getLarvalRadii();
+        if(this->mHeatMaps.isEnabled())
+        {
+            // the current values still hold the momentum of the previous detection
+            cv::Point const previous = this->mLarvae[larvaIndex].values.momentum;
+            this->mHeatMaps.addDetection(larvaID, rawLarva.getMomentum(),
+                                         this->mLarvae[larvaIndex].parameters.empty() ? nullptr : &previous);
+        }
         
-        this->mLarvae[larvaIndex].values.spine          = spine;
         this->mLarvae[larvaIndex].values.momentum       = rawLarva.getMomentum();
         this->mLarvae[larvaIndex].values.area           = rawLarva.getArea();
-        this->mLarvae[larvaIndex].values.spineRadii     = radii;
-        
-        int midIndex = static_cast<int>((this->mLarvae[larvaIndex].getNSpinePoints() - 1) / 2);
-        this->mLarvae[larvaIndex].values.mainBodyBendingAngle = Calc::calcAngle(spine.at(midIndex), spine.at(0), spine.at((this->mLarvae[larvaIndex].getNSpinePoints()-1)));
-        
-        this->mLarvae[larvaIndex].values.spineLength    = rawLarva.getSpineLength();
-        this->mMaxSpineLength                           = std::max(this->mLarvae[larvaIndex].values.spineLength, this->mMaxSpineLength);
         this->mLarvae[larvaIndex].values.perimeter      = rawLarva.getContourPerimeter();
         
-        this->mLarvae[larvaIndex].values.isCoiled       = rawLarva.getIsCoiledIndicator();
+        if(rawLarva.isSpineCalculated())
+        {
+            this->setSpineParameters(larvaIndex, timePoint, rawLarva, this->mLarvae[larvaIndex].values);
+            this->mMaxSpineLength                       = std::max(this->mLarvae[larvaIndex].values.spineLength, this->mMaxSpineLength);
+        }
+        else
+        {
+            // the spine dependent values are calculated after tracking (see calcDeferredSpines)
+            this->mLarvae[larvaIndex].deferredContours[timePoint] = rawLarva.getContour();
+            
+            this->mLarvae[larvaIndex].values.spine.clear();
+            this->mLarvae[larvaIndex].values.spineRadii.clear();
+            this->mLarvae[larvaIndex].values.mainBodyBendingAngle = 0.0;
+            // half of the perimeter is used as estimate of the spine length (e.g. for the greedy assignment)
+            this->mLarvae[larvaIndex].values.spineLength    = rawLarva.getContourPerimeter() / 2;
+            this->mLarvae[larvaIndex].values.isCoiled       = rawLarva.getIsCoiledIndicator();
+            this->mLarvae[larvaIndex].values.goPhase        = -1;
+            this->mLarvae[larvaIndex].values.isLeftBended   = false;
+            this->mLarvae[larvaIndex].values.isRightBended  = false;
+        }
         
         this->mLarvae[larvaIndex].values.isWellOriented = false; // set false by default
         
-        this->mLarvae[larvaIndex].values.distToOrigin   = calcDistToOrigin(larvaIndex, rawLarva.getMomentum());
+        if(FeatureParameters::isEnabled(FeatureParameters::DISTANCE_TO_ORIGIN))
+        {
+            this->mLarvae[larvaIndex].values.distToOrigin   = calcDistToOrigin(larvaIndex, rawLarva.getMomentum());
+        }
+        
+        if(FeatureParameters::isEnabled(FeatureParameters::MOMENTUM_DISTANCE))
+        {
+            this->mLarvae[larvaIndex].values.momentumDist   = calcMomentumDist(larvaIndex, timePoint, rawLarva.getMomentum());
+            this->mLarvae[larvaIndex].values.accDist        += this->mLarvae[larvaIndex].values.momentumDist;
+        }
         
-        this->mLarvae[larvaIndex].values.momentumDist   = calcMomentumDist(larvaIndex, timePoint, rawLarva.getMomentum());
-        this->mLarvae[larvaIndex].values.accDist        += this->mLarvae[larvaIndex].values.momentumDist;
+        if(FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION))
+        {
+            int framesForMovementDirectionCalc = static_cast<int>(CameraParameter::dFPS);
+            if(!LarvaeExtractionParameters::MovementDirectionParameters::bUseDynamicMovementDirectionParameterCalculation)
+            {
+                framesForMovementDirectionCalc = LarvaeExtractionParameters::MovementDirectionParameters::iFramesForMovementDirectionCalculation;
+            }
+            
+            this->mLarvae[larvaIndex].values.movementDirection = calcMovementDirection(larvaIndex, timePoint,framesForMovementDirectionCalc,rawLarva.getMomentum());
+        }
         
-        // body bending must be +/- 30 degree deviation from 180 degree
-        int angleThresh = 30;
-        // traveled distance is calculated between one second (i.e. framesForSpeedCalc = FPS)
-        int framesForSpeedCalc = static_cast<int>(CameraParameter::dFPS);
-        // movement (in pixel) must be more than 15% of the spine length
-        //int speedThresh = (int) (rawLarva.getSpineLength() * 15 / 100);
+        // the online post-processing calculates velocity and acceleration as soon as they are final
+        if(FeatureParameters::isEnabled(FeatureParameters::VELOCITY) && !this->mLarvae[larvaIndex].postProcessing.isOnline)
+        {
+            this->recalculateLarvaVelocityAndAcceleration(larvaIndex);
+        }
         
-        double speedThreshTmp = static_cast<double>(GeneralParameters::iMaxLarvaeArea);
-        // larval length is approximatly 2*sqrt(max_area)
-        speedThreshTmp = 2 * std::sqrt(speedThreshTmp);
-        // assuming a framesForSpeedCalc value equal to the frame rate: speed is calculated for one second
-        // a further assumption, that a crawling larva is travaleing 5% of its body length per second (during a go) leads to:
-        int speedThresh = static_cast<int>(speedThreshTmp * 0.05);
+        this->mLarvae[larvaIndex].setValuesAt(timePoint, this->mLarvae[larvaIndex].values);
         
-        if(!LarvaeExtractionParameters::StopAndGoCalculation::bUseDynamicStopAndGoParameterCalculation)
+        if(LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction)
         {
-            angleThresh = LarvaeExtractionParameters::StopAndGoCalculation::iAngleThreshold;
-            framesForSpeedCalc = LarvaeExtractionParameters::StopAndGoCalculation::iFramesForSpeedCalculation;
-            speedThresh = LarvaeExtractionParameters::StopAndGoCalculation::iSpeedThreshold;
+            // the velocity of a new larva is unknown, but hardly exceeds one spine length per frame
+            this->mLarvae[larvaIndex].motion.update(cv::Point2d(rawLarva.getMomentum()), 
+                                                    timePoint, 
+                                                    this->mLarvae[larvaIndex].values.spineLength);
         }
         
-        this->mLarvae[larvaIndex].values.goPhase = calcGoPhaseIndicator(larvaIndex,
-                                                                        timePoint,
-                                                                        rawLarva.getMomentum(),
-                                                                        this->mLarvae[larvaIndex].values.mainBodyBendingAngle,
-                                                                        speedThresh,
-                                                                        angleThresh,
-                                                                        framesForSpeedCalc);
+        this->mLarvae[larvaIndex].contour = rawLarva.takeContour();
         
+        // collect the larvae of the tracked frame for the active set (see processUntrackedLarvae)
+        if(this->mHasActiveLarvae)
+        {
+            if(timePoint <= this->mActiveTimePoint || (!this->mAssignedLarvae.empty() && timePoint != this->mAssignedTimePoint))
+            {
+                this->invalidateActiveLarvae();
+            }
+            else
+            {
+                this->mAssignedTimePoint = timePoint;
+                this->mAssignedLarvae.push_back(larvaIndex);
+            }
+        }
+    }
+}
+
+void LarvaeContainer::setSpineParameters(const size_t larvaIndex, 
+                                         const uint timePoint, 
+                                         RawLarva &rawLarva, 
+                                         Larva::ValuesType &values)
+{
+    bool invertParameters = this->changeDirectionality(larvaIndex, timePoint,rawLarva);
+    
+    values.spine                    = rawLarva.takeDiscreteSpine();
+    values.spineRadii               = rawLarva.takeLarvalRadii();
+    
+    if(invertParameters)
+    {
+        std::reverse(values.spine.begin(), values.spine.end());
+        std::reverse(values.spineRadii.begin(), values.spineRadii.end());
+    }
+    
+    int midIndex = static_cast<int>((this->mLarvae[larvaIndex].getNSpinePoints() - 1) / 2);
+    values.mainBodyBendingAngle     = Calc::calcAngle(values.spine.at(midIndex), values.spine.at(0), values.spine.at((this->mLarvae[larvaIndex].getNSpinePoints()-1)));
+    
+    values.spineLength              = rawLarva.getSpineLength();
+    values.isCoiled                 = rawLarva.getIsCoiledIndicator();
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::GO_PHASE))
+    {
+        this->setGoPhaseIndicator(larvaIndex, timePoint, values);
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+    {
         int bendingAngleThresh = 30;
         if(!LarvaeExtractionParameters::BodyBendingParameters::bUseDynamicBodyBendingCalculation)
         {
             bendingAngleThresh = static_cast<int>(LarvaeExtractionParameters::BodyBendingParameters::dAngleThreshold);
         }
         
-        this->mLarvae[larvaIndex].values.isLeftBended  = this->calcLeftTurnIndicator(this->mLarvae[larvaIndex].values.mainBodyBendingAngle, bendingAngleThresh);
-        this->mLarvae[larvaIndex].values.isRightBended = this->calcRightTurnIndicator(this->mLarvae[larvaIndex].values.mainBodyBendingAngle, bendingAngleThresh);
-        
-        int framesForMovementDirectionCalc = static_cast<int>(CameraParameter::dFPS);
-        if(!LarvaeExtractionParameters::MovementDirectionParameters::bUseDynamicMovementDirectionParameterCalculation)
+        values.isLeftBended  = this->calcLeftTurnIndicator(values.mainBodyBendingAngle, bendingAngleThresh);
+        values.isRightBended = this->calcRightTurnIndicator(values.mainBodyBendingAngle, bendingAngleThresh);
+    }
+}
+
+void LarvaeContainer::setGoPhaseIndicator(const size_t larvaIndex, 
+                                          const uint timePoint, 
+                                          Larva::ValuesType &values)
+{
+    // body bending must be +/- 30 degree deviation from 180 degree
+    int angleThresh = 30;
+    // traveled distance is calculated between one second (i.e. framesForSpeedCalc = FPS)
+    int framesForSpeedCalc = static_cast<int>(CameraParameter::dFPS);
+    // movement (in pixel) must be more than 15% of the spine length
+    //int speedThresh = (int) (rawLarva.getSpineLength() * 15 / 100);
+    
+    double speedThreshTmp = static_cast<double>(GeneralParameters::iMaxLarvaeArea);
+    // larval length is approximatly 2*sqrt(max_area)
+    speedThreshTmp = 2 * std::sqrt(speedThreshTmp);
+    // assuming a framesForSpeedCalc value equal to the frame rate: speed is calculated for one second
+    // a further assumption, that a crawling larva is travaleing 5% of its body length per second (during a go) leads to:
+    int speedThresh = static_cast<int>(speedThreshTmp * 0.05);
+    
+    if(!LarvaeExtractionParameters::StopAndGoCalculation::bUseDynamicStopAndGoParameterCalculation)
+    {
+        angleThresh = LarvaeExtractionParameters::StopAndGoCalculation::iAngleThreshold;
+        framesForSpeedCalc = LarvaeExtractionParameters::StopAndGoCalculation::iFramesForSpeedCalculation;
+        speedThresh = LarvaeExtractionParameters::StopAndGoCalculation::iSpeedThreshold;
+    }
+    
+    values.goPhase = calcGoPhaseIndicator(larvaIndex,
+                                          timePoint,
+                                          values.momentum,
+                                          values.mainBodyBendingAngle,
+                                          speedThresh,
+                                          angleThresh,
+                                          framesForSpeedCalc);
+}
+
+void LarvaeContainer::calcDeferredSpines()
+{
+    // every larva is processed independently (in temporal order, since the head/tail decision
+    // depends on the spine of the previous time step)
+    Parallel::parallelFor(this->mLarvae.size(), [this](size_t larvaIndex)
+    {
+        Larva& larva = this->mLarvae[larvaIndex];
+        Larva::ValuesType values;
+        for(auto it = larva.deferredContours.begin(); it != larva.deferredContours.end(); ++it)
+        {
+            if(!larva.getValuesAt(it->first, values))
+            {
+                continue;
+            }
+            
+            RawLarva rawLarva(std::move(it->second), cv::Mat());
+            if(larva.getNSpinePoints() == 0)
+            {
+                larva.setNSpinePoints(rawLarva.getDiscreteSpine().size());
+            }
+            
+            this->setSpineParameters(larvaIndex, it->first, rawLarva, values);
+            larva.setValuesAt(it->first, values);
+        }
+        larva.deferredContours.clear();
+    });
+    
+    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    {
+        Larva::ParameterMap const& parameters = this->mLarvae.at(i).parameters;
+        for(unsigned int t : parameters)
         {
-            framesForMovementDirectionCalc = LarvaeExtractionParameters::MovementDirectionParameters::iFramesForMovementDirectionCalculation;
+            this->mMaxSpineLength = std::max(parameters.getValue(TrackColumns::SPINE_LENGTH, t), this->mMaxSpineLength);
         }
-        
-        this->mLarvae[larvaIndex].values.movementDirection = calcMovementDirection(larvaIndex, timePoint,framesForMovementDirectionCalc,rawLarva.getMomentum());
-        
-        this->recalculateLarvaVelocityAndAcceleration(larvaIndex);
-        
-        this->mLarvae[larvaIndex].parameters.insert(std::pair<unsigned int, Larva::ValuesType>(timePoint, this->mLarvae[larvaIndex].values));
-        
-        this->mLarvae[larvaIndex].contour = rawLarva.getContour();
     }
 }
 
@@ -1734,16 +2135,296 @@ bool LarvaeContainer::isAssignedAt(const uint larvaID, const uint timePoint) con
 
 void LarvaeContainer::interplolateLarvae()
 {
-    // change Head-Tail position if it is not consistent over time
-    this->interpolateHeadTailOverTime();
+    bool const orientation = FeatureParameters::isEnabled(FeatureParameters::ORIENTATION);
+    
+    // every larva is processed independently, all steps for one larva in a row
+    Parallel::parallelFor(this->mLarvae.size(), [this, orientation](size_t larvaIndex)
+    {
+        // change Head-Tail position if it is not consistent over time
+        if(orientation)
+        {
+            this->interpolateHeadTailOverTime(larvaIndex);
+        }
+        
+        // fill sampling gaps caused by time windows (e.g. 10 fps are oversampled for movement direction etc.)
+        this->fillTimeSamplingGaps(larvaIndex);
+        
+        // reacalculate some parameters after head tail interpolation bacause in some frames
+        // head and tail markers can be swapped so some features like velocity etc. have 
+        // to be recalculated
+        this->updateLarvaParameterAfterHeadTailInterpolation(larvaIndex);
+    });
+}
+
+void LarvaeContainer::updateOnlinePostProcessing(const uint timePoint)
+{
+    if(!this->mOnlinePostProcessing)
+    {
+        return;
+    }
+    
+    size_t nOpen = 0;
+    for(size_t i = 0; i < this->mOnlineLarvaIDs.size(); ++i)
+    {
+        size_t larvaIndex;
+        if(!this->getIndexOfLarva(this->mOnlineLarvaIDs.at(i), larvaIndex))
+        {
+            continue;
+        }
+        
+        if(this->mLarvae.at(larvaIndex).parameters.count(timePoint) > 0)
+        {
+            this->processOnlineTimePoint(larvaIndex, timePoint);
+            this->mOnlineLarvaIDs[nOpen++] = this->mOnlineLarvaIDs.at(i);
+        }
+        else
+        {
+            // a track is never continued after a frame without assignment
+            this->closeOnlineLarva(larvaIndex);
+        }
+    }
+    this->mOnlineLarvaIDs.resize(nOpen);
+}
+
+void LarvaeContainer::finishOnlinePostProcessing()
+{
+    for(size_t i = 0; i < this->mOnlineLarvaIDs.size(); ++i)
+    {
+        size_t larvaIndex;
+        if(this->getIndexOfLarva(this->mOnlineLarvaIDs.at(i), larvaIndex))
+        {
+            this->closeOnlineLarva(larvaIndex);
+        }
+    }
+    this->mOnlineLarvaIDs.clear();
+}
+
+void LarvaeContainer::updateGroupMetrics(const uint timePoint)
+{
+    if(!FeatureParameters::isEnabled(FeatureParameters::GROUP_BEHAVIOUR))
+    {
+        return;
+    }
+    
+    std::vector<size_t> indices;
+    if(this->hasActiveLarvaeAt(timePoint))
+    {
+        indices = this->mActiveLarvae;
+    }
+    else
+    {
+        for(size_t i = 0; i < this->mLarvae.size(); ++i)
+        {
+            if(this->mLarvae[i].parameters.count(timePoint) > 0)
+            {
+                indices.push_back(i);
+            }
+        }
+    }
+    
+    this->updateGroupMetrics(timePoint, indices);
+}
+
+void LarvaeContainer::updateGroupMetrics(const uint timePoint, const std::vector<size_t> &indices)
+{
+    bool const useDirections = FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION);
+    std::vector<cv::Point> points;
+    std::vector<double> directions;
+    points.reserve(indices.size());
+    directions.reserve(indices.size());
+    for(size_t i : indices)
+    {
+        Larva::ParameterMap const& parameters = this->mLarvae[i].parameters;
+        uint const midPointIndex = this->mLarvae[i].getSpineMidPointIndex();
+        points.push_back(midPointIndex < parameters.getSpineSize(timePoint) ? parameters.getSpinePoint(timePoint, midPointIndex) : parameters.getMomentum(timePoint));
+        directions.push_back(useDirections ? parameters.getValue(TrackColumns::MOVEMENT_DIRECTION, timePoint) : -1.0);
+    }
+    
+    std::vector<double> nearestNeighbourDists;
+    std::vector<int> neighbourCounts;
+    this->mGroupMetrics.update(timePoint, points, directions, GeneralParameters::dGroupNeighbourRadius,
+                               nearestNeighbourDists, neighbourCounts);
+    
+    for(size_t k = 0; k < indices.size(); ++k)
+    {
+        Larva::ParameterMap& parameters = this->mLarvae[indices[k]].parameters;
+        parameters.setValue(TrackColumns::NEAREST_NEIGHBOUR_DIST, timePoint, nearestNeighbourDists[k]);
+        parameters.setNeighbourCount(timePoint, neighbourCounts[k]);
+    }
+}
+
+void LarvaeContainer::processOnlineTimePoint(const size_t larvaIndex, const uint timePoint)
+{
+    uint minSeqSize = 10; // PARAMS (see interpolateHeadTailOverTime)
+    Larva& larva = this->mLarvae[larvaIndex];
+    Larva::PostProcessingState& state = larva.postProcessing;
+    
+    if(!FeatureParameters::isEnabled(FeatureParameters::ORIENTATION))
+    {
+        state.firstUnorientedTimePoint = timePoint + 1;
+    }
+    else if(larva.parameters.getIndicator(TrackColumns::IS_COILED, timePoint))
+    {
+        if(state.runOpen)
+        {
+            this->closeOnlineRun(larvaIndex, timePoint - 1);
+        }
+        // coiled time points are not part of a sequence and keep their orientation
+        state.firstUnorientedTimePoint = timePoint + 1;
+    }
+    else
+    {
+        if(!state.runOpen)
+        {
+            state.runOpen       = true;
+            state.runFrom       = timePoint;
+            state.runCounter    = 0;
+            state.runIndicator  = 0;
+            state.runApplied    = false;
+        }
+        
+        if(state.runIndicator == 0)
+        {
+            state.runIndicator = this->calcHeadTailMovementIndicator(larvaIndex, timePoint, state.runCounter);
+        }
+        
+        // calcHeadTailRecognitionIndicator1 returns the first movement based decision, thus the indicator is
+        // final as soon as the sequence is long enough to be checked at all
+        if(state.runIndicator != 0 && timePoint - state.runFrom + 1 > minSeqSize)
+        {
+            state.runApplied = true;
+        }
+        
+        if(state.runApplied)
+        {
+            // the latest time point keeps its orientation until the next one is inserted (see changeDirectionality)
+            for(uint t = state.firstUnorientedTimePoint; t < timePoint; ++t)
+            {
+                this->applyHeadTailIndicator(larvaIndex, t, state.runIndicator);
+            }
+            state.firstUnorientedTimePoint = timePoint;
+        }
+    }
+    
+    // the acceleration of a time point depends on the velocity (i.e. the orientation) of the next time point
+    while(state.firstOpenTimePoint + 1 < state.firstUnorientedTimePoint)
+    {
+        this->finalizeTimePoint(larvaIndex, state.firstOpenTimePoint, false);
+        ++state.firstOpenTimePoint;
+    }
+}
+
+void LarvaeContainer::closeOnlineRun(const size_t larvaIndex, const uint to)
+{
+    uint minSeqSize = 10; // PARAMS (see interpolateHeadTailOverTime)
+    Larva::PostProcessingState& state = this->mLarvae[larvaIndex].postProcessing;
+    
+    int indicator = 0;
+    if(state.runApplied)
+    {
+        indicator = state.runIndicator;
+    }
+    else if(to - state.runFrom + 1 > minSeqSize)
+    {
+        indicator = this->calcHeadTailRecognitionIndicator1(larvaIndex, state.runFrom, to);
+    }
+    
+    if(indicator != 0)
+    {
+        for(uint t = state.firstUnorientedTimePoint; t <= to; ++t)
+        {
+            this->applyHeadTailIndicator(larvaIndex, t, indicator);
+        }
+    }
+    
+    state.firstUnorientedTimePoint = to + 1;
+    state.runOpen = false;
+}
+
+void LarvaeContainer::closeOnlineLarva(const size_t larvaIndex)
+{
+    Larva& larva = this->mLarvae[larvaIndex];
+    Larva::PostProcessingState& state = larva.postProcessing;
+    if(state.isClosed || larva.parameters.empty())
+    {
+        state.isClosed = true;
+        return;
+    }
+    
+    uint last = larva.getLastTimePoint();
+    if(state.runOpen)
+    {
+        this->closeOnlineRun(larvaIndex, last);
+    }
     
-    // fill sampling gaps caused by time windows (e.g. 10 fps are oversampled for movement direction etc.)
-    this->fillTimeSamplingGaps();
+    for(uint t = state.firstOpenTimePoint; t <= last; ++t)
+    {
+        this->finalizeTimePoint(larvaIndex, t, t == last);
+    }
     
-    // reacalculate some parameters after head tail interpolation bacause in some frames
-    // head and tail markers can be swapped so some features like velocity etc. have 
-    // to be recalculated
-    this->updateLarvaParameterAfterHeadTailInterpolation();
+    state.firstOpenTimePoint        = last + 1;
+    state.firstUnorientedTimePoint  = last + 1;
+    state.isClosed                  = true;
+}
+
+void LarvaeContainer::finalizeTimePoint(const size_t larvaIndex, const uint timePoint, const bool isLast)
+{
+    Larva& larva = this->mLarvae[larvaIndex];
+    uint const first = larva.getFirstTimePoint();
+    
+    // same values as updateLarvaParameterAfterHeadTailInterpolation (the sampling gaps filled by 
+    // fillTimeSamplingGaps are overwritten there as well)
+    if(FeatureParameters::isEnabled(FeatureParameters::DISTANCE_TO_ORIGIN))
+    {
+        larva.parameters.setValue(TrackColumns::DIST_TO_ORIGIN, timePoint, Calc::eucledianDist(larva.getOrigin(), larva.parameters.getMomentum(timePoint)));
+    }
+    if(FeatureParameters::isEnabled(FeatureParameters::MOMENTUM_DISTANCE) && timePoint > first)
+    {
+        double const momentumDist = Calc::eucledianDist(larva.parameters.getMomentum(timePoint - 1), larva.parameters.getMomentum(timePoint));
+        larva.parameters.setValue(TrackColumns::MOMENTUM_DIST, timePoint, momentumDist);
+        larva.parameters.setValue(TrackColumns::ACC_DIST, timePoint, larva.parameters.getValue(TrackColumns::ACC_DIST, timePoint - 1) + momentumDist);
+    }
+    if(FeatureParameters::isEnabled(FeatureParameters::VELOCITY))
+    {
+        this->updateVelocityAt(larvaIndex, timePoint);
+        if(timePoint == first)
+        {
+            // there is no acceleration value for the first timestep
+            larva.parameters.setValue(TrackColumns::ACCELERATION, timePoint, std::numeric_limits<double>::min());
+        }
+        else if(!isLast)
+        {
+            this->updateVelocityAt(larvaIndex, timePoint + 1);
+            larva.parameters.setValue(TrackColumns::ACCELERATION, timePoint, larva.parameters.getValue(TrackColumns::VELOSITY, timePoint + 1) - larva.parameters.getValue(TrackColumns::VELOSITY, timePoint));
+        }
+    }
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::GO_PHASE))
+        this->updateGoPhaseIndicator(larvaIndex, timePoint);
+    if(FeatureParameters::isEnabled(FeatureParameters::COILED))
+        this->updateIsCoiledIndicator(larvaIndex, timePoint);
+    if(FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION))
+        this->updateMovementDirection(larvaIndex, timePoint);
+    if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+        this->updateTurnIndicator(larvaIndex, timePoint);
+}
+
+void LarvaeContainer::updateVelocityAt(const size_t larvaIndex, const uint timePoint)
+{
+    Larva& larva = this->mLarvae[larvaIndex];
+    int frameWindow = static_cast<int>(cvRound(CameraParameter::dFPS));
+    cv::Point p0;
+    cv::Point p1;
+    
+    if(static_cast<int>(timePoint - larva.getFirstTimePoint()) < frameWindow)
+    {
+        larva.parameters.setValue(TrackColumns::VELOSITY, timePoint, std::numeric_limits<double>::min());
+    }
+    else if(larva.getSpinePointAt(timePoint - frameWindow, larva.getNSpinePoints() - 1, p0) && 
+            larva.getSpinePointAt(timePoint, larva.getNSpinePoints() - 1, p1))
+    {
+        larva.parameters.setValue(TrackColumns::VELOSITY, timePoint, Calc::eucledianDist(p0, p1) / static_cast<double>(frameWindow));
+    }
 }
 
 void LarvaeContainer::interpolateHeadTailOverTime(const uint larvaIndex)
@@ -1753,30 +2434,21 @@ void LarvaeContainer::interpolateHeadTailOverTime(const uint larvaIndex)
     uint from = 0;
     uint to = 0;
     
-    for (std::map<unsigned int, Larva::ValuesType>::iterator it = mLarvae[larvaIndex].parameters.begin(); it != mLarvae[larvaIndex].parameters.end(); ++it)
+    Larva::ParameterMap const& parameters = mLarvae[larvaIndex].parameters;
+    for (Larva::ParameterMap::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
     {
-        if(!it->second.isCoiled)
+        if(!parameters.getIndicator(TrackColumns::IS_COILED, *it))
         {
-            from = it->first;
+            from = *it;
             to = from;
             
-            std::map<uint, Larva::ValuesType>::iterator goOnIt = it;
-            goOnIt++;
-            while(goOnIt != mLarvae[larvaIndex].parameters.end())
+            // the iterator follows the sequence up to its last time point
+            while(parameters.count(to + 1) > 0 && !parameters.getIndicator(TrackColumns::IS_COILED, to + 1))
             {
-                if(goOnIt->first == to + 1 && !goOnIt->second.isCoiled)
-                {
-                    to = goOnIt->first;
-                    goOnIt++;
-                }
-                else
-                {
-                    break;
-                }
+                ++to;
+                ++it;
             }
             
-            goOnIt--;
-            
             // if sequence sufficiently long, check head-tail-recognition
             if(to-from+1 > minSeqSize)
             {
@@ -1784,32 +2456,44 @@ void LarvaeContainer::interpolateHeadTailOverTime(const uint larvaIndex)
                 
                 if(indicator != 0)
                 {
-                    for(uint i = from; i <= to; it++, i++)
+                    for(uint i = from; i <= to; i++)
                     {
-                        it->second.isWellOriented = true; // if indicator != 0, the sequence is valid
-                        if(indicator == -1)
-                        { // change orientation if indicated
-                            it->second.spine        = this->reverseVec(it->second.spine);
-                            it->second.spineRadii   = this->reverseVec(it->second.spineRadii);
-                            it->second.mainBodyBendingAngle = Calc::calcAngle(it->second.spine.at((this->mLarvae[larvaIndex].getNSpinePoints()-1)/2),
-                                                                              it->second.spine.at(0),
-                                                                              it->second.spine.at(this->mLarvae[larvaIndex].getNSpinePoints()-1));
-                            std::swap(it->second.isLeftBended,it->second.isRightBended);
-                        }
+                        this->applyHeadTailIndicator(larvaIndex, i, indicator);
                     }
                 }
             }
-            it = goOnIt;
         }
     }
 }
 
+void LarvaeContainer::applyHeadTailIndicator(const uint larvaIndex, const uint timePoint, const int indicator)
+{
+    Larva::ParameterMap& parameters = this->mLarvae[larvaIndex].parameters;
+    if(parameters.count(timePoint) == 0)
+    {
+        return;
+    }
+    
+    parameters.setIndicator(TrackColumns::IS_WELL_ORIENTED, timePoint, true); // if indicator != 0, the sequence is valid
+    if(indicator == -1)
+    { // change orientation if indicated
+        parameters.reverseSpine(timePoint, true);
+        parameters.setValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, timePoint, 
+                            Calc::calcAngle(parameters.getSpinePoint(timePoint, (this->mLarvae[larvaIndex].getNSpinePoints()-1)/2),
+                                            parameters.getSpinePoint(timePoint, 0),
+                                            parameters.getSpinePoint(timePoint, this->mLarvae[larvaIndex].getNSpinePoints()-1)));
+        bool const isLeftBended = parameters.getIndicator(TrackColumns::IS_LEFT_BENDED, timePoint);
+        parameters.setIndicator(TrackColumns::IS_LEFT_BENDED, timePoint, parameters.getIndicator(TrackColumns::IS_RIGHT_BENDED, timePoint));
+        parameters.setIndicator(TrackColumns::IS_RIGHT_BENDED, timePoint, isLeftBended);
+    }
+}
+
 void LarvaeContainer::interpolateHeadTailOverTime()
 {
-    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    Parallel::parallelFor(this->mLarvae.size(), [this](size_t i)
     {
         this->interpolateHeadTailOverTime(i);
-    }
+    });
 }
 
 void LarvaeContainer::fillTimeSamplingGaps(const uint larvaIndex)
@@ -1845,20 +2529,21 @@ void LarvaeContainer::fillTimeSamplingGaps(const uint larvaIndex)
         framesForMovementDirectionCalc = LarvaeExtractionParameters::MovementDirectionParameters::iFramesForMovementDirectionCalculation;
     }
     
-    for (std::map<unsigned int, Larva::ValuesType>::iterator it = this->mLarvae[larvaIndex].parameters.begin(); it != this->mLarvae[larvaIndex].parameters.end(); ++it)
+    Larva::ParameterMap& parameters = this->mLarvae[larvaIndex].parameters;
+    for (Larva::ParameterMap::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
     {
-        int goPhase = it->second.goPhase;
-        int movementDirection = it->second.movementDirection;
+        int goPhase = parameters.getGoPhase(*it);
+        int movementDirection = parameters.getValue(TrackColumns::MOVEMENT_DIRECTION, *it);
         
-        if(goPhase == -1)
+        if(goPhase == -1 && FeatureParameters::isEnabled(FeatureParameters::GO_PHASE))
         {
-            cv::Point curMom = it->second.momentum;
+            cv::Point curMom = parameters.getMomentum(*it);
             cv::Point nextMom;
-            if (this->mLarvae.at(larvaIndex).getMomentumAt(it->first + framesForSpeedCalc, nextMom))
+            if (this->mLarvae.at(larvaIndex).getMomentumAt(*it + framesForSpeedCalc, nextMom))
             {
                 int phaseIndicator = -1;
                 
-                double curBending = it->second.mainBodyBendingAngle;
+                double curBending = parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, *it);
                 double angleLowThresh = 180 - angleThresh;
                 double angleHighThresh = 180 + angleThresh;
                 double distance = Calc::eucledianDist(curMom,nextMom);
@@ -1871,16 +2556,16 @@ void LarvaeContainer::fillTimeSamplingGaps(const uint larvaIndex)
                 {
                     phaseIndicator = 0;
                 }
-                it->second.goPhase = phaseIndicator;
+                parameters.setGoPhase(*it, phaseIndicator);
             }
         }
         
-        if(movementDirection == -1.0)
+        if(movementDirection == -1.0 && FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION))
         {
             double movementDirection = -1;
-            cv::Point curMom = it->second.momentum;
+            cv::Point curMom = parameters.getMomentum(*it);
             cv::Point nextMom;
-            if (this->mLarvae.at(larvaIndex).getMomentumAt(it->first + framesForMovementDirectionCalc, nextMom))
+            if (this->mLarvae.at(larvaIndex).getMomentumAt(*it + framesForMovementDirectionCalc, nextMom))
             {
                 // if there is no movement at all angle calculation will fail.
                 // Thus, we asure that the distance between the two points is not zero!
@@ -1890,35 +2575,65 @@ void LarvaeContainer::fillTimeSamplingGaps(const uint larvaIndex)
                 }
             }
             
-            it->second.movementDirection = movementDirection;
+            parameters.setValue(TrackColumns::MOVEMENT_DIRECTION, *it, movementDirection);
         }
     }
 }
 
 void LarvaeContainer::fillTimeSamplingGaps()
 {
-    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    Parallel::parallelFor(this->mLarvae.size(), [this](size_t i)
     {
         this->fillTimeSamplingGaps(i);
+    });
+}
+
+void LarvaeContainer::updateLarvaParameterAfterHeadTailInterpolation(const uint larvaIndex)
+{
+    bool const goPhase              = FeatureParameters::isEnabled(FeatureParameters::GO_PHASE);
+    bool const coiled               = FeatureParameters::isEnabled(FeatureParameters::COILED);
+    bool const movementDirection    = FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION);
+    bool const bending              = FeatureParameters::isEnabled(FeatureParameters::BENDING);
+    
+    if(FeatureParameters::isEnabled(FeatureParameters::DISTANCE_TO_ORIGIN))
+    {
+        this->recalculateLarvaDistanceToOrigin(larvaIndex);
+        this->updateLarvaDistance2Origin(larvaIndex);
+    }
+    if(FeatureParameters::isEnabled(FeatureParameters::MOMENTUM_DISTANCE))
+    {
+        this->recalculateLarvaMomentumDistance(larvaIndex);
+        this->updateLarvaAccumulatedDistance(larvaIndex);
+    }
+    if(FeatureParameters::isEnabled(FeatureParameters::VELOCITY))
+    {
+        this->recalculateLarvaVelocityAndAcceleration(larvaIndex);
+    }
+    
+    if(!goPhase && !coiled && !movementDirection && !bending)
+    {
+        return;
+    }
+    
+    std::vector<uint> time = mLarvae.at(larvaIndex).getAllTimeSteps();
+    foreach (uint t, time) {
+        if(goPhase)
+            this->updateGoPhaseIndicator(larvaIndex, t);
+        if(coiled)
+            this->updateIsCoiledIndicator(larvaIndex, t);
+        if(movementDirection)
+            this->updateMovementDirection(larvaIndex, t);
+        if(bending)
+            this->updateTurnIndicator(larvaIndex, t);
     }
 }
 
 void LarvaeContainer::updateLarvaParameterAfterHeadTailInterpolation()
 {
-    for(size_t i = 0; i < this->mLarvae.size(); ++i)
+    Parallel::parallelFor(this->mLarvae.size(), [this](size_t i)
     {
-        this->recalculateLarvaDistanceParameter(mLarvae.at(i).getID());
-        this->recalculateLarvaVelocityAndAcceleration(i);
-        this->updateLarvaAccumulatedDistance(i);
-        this->updateLarvaDistance2Origin(i);
-        std::vector<uint> time = mLarvae.at(i).getAllTimeSteps();
-        foreach (uint t, time) {
-            this->updateGoPhaseIndicator(i, t);
-            this->updateIsCoiledIndicator(i, t);
-            this->updateMovementDirection(i, t);
-            this->updateTurnIndicator(i, t);
-        }
-    }
+        this->updateLarvaParameterAfterHeadTailInterpolation(i);
+    });
 }
 
 double LarvaeContainer::calcMomentumDist(const uint larvaIndex, const uint timePoint, const cv::Point &curMomentum) const
@@ -1963,6 +2678,8 @@ void LarvaeContainer::changeDirection(const uint larvaIndex, const uint timePoin
 void LarvaeContainer::eraseAt(const uint larvaIndex, const uint timePoint)
 {
     this->mLarvae[larvaIndex].parameters.erase(timePoint);
+    this->mLarvae[larvaIndex].eraseLandmarkValuesAt(timePoint);
+    this->invalidateActiveLarvae();
 }
 
 double LarvaeContainer::calcDistToOrigin(const uint larvaIndex, const cv::Point &curMomentum) const
@@ -2026,59 +2743,22 @@ int LarvaeContainer::calcHeadTailRecognitionIndicator1(const uint larvaIndex, co
     
     /* First approach: Search for a period where the body bending angle
       is less than a specified threshold (close to 180 degree) and with
-      movement of the larva
+      movement of the larva (see calcHeadTailMovementIndicator)
     */
     std::vector<double> bendingAngles;
     bendingAngles.reserve(numValues);
     
-    double maxBendingAngleThresh = 30; // PARAMS, indicates how much angle can differ from 180 degree
     double fractionOfSpineLengthForMovement = 0.07; // PARAMS
-    double movementToOrientationAngleThresh = 50; // PARAMS
     uint counter = 0;
     for(uint i = from; i <= to; i++){
         
-        double angleDiff = std::abs(180 - mLarvae[larvaIndex].parameters[i].mainBodyBendingAngle);
+        double angleDiff = std::abs(180 - mLarvae[larvaIndex].parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, i));
         bendingAngles.push_back(angleDiff);
         
-        if(angleDiff <= maxBendingAngleThresh)
+        int indicator = this->calcHeadTailMovementIndicator(larvaIndex, i, counter);
+        if(indicator != 0)
         {
-            counter++;
-            if(counter >= timeWindow)
-            {
-                // now, check if there was a significant movement
-                cv::Point mom1 = mLarvae[larvaIndex].parameters[i-counter+1].momentum;
-                cv::Point mom2 = mLarvae[larvaIndex].parameters[i].momentum;
-                cv::Point2f movDir = mom2 - mom1;
-                
-                // movement must be wide enough and wider than change of spinelengths (think of pulling in the head)
-                float movLength = Calc::normL2<float>(movDir);
-                double spineLength1 = mLarvae[larvaIndex].parameters[i-counter+1].spineLength;
-                double spineLength2 = mLarvae[larvaIndex].parameters[i].spineLength;
-                double spineLengthChange = spineLength1-spineLength2; // if longer, its negative, so not considered in if condition
-                if(movLength > std::max(1.5*spineLengthChange, fractionOfSpineLengthForMovement * spineLength1))
-                {
-                    double spineSize = mLarvae[larvaIndex].parameters[i].spine.size();
-                    cv::Point head = mLarvae[larvaIndex].parameters[i].spine.at(0);
-                    cv::Point tail = mLarvae[larvaIndex].parameters[i].spine.at(spineSize-1);
-                    cv::Point2f orientation = head-tail;
-                    double angle = Calc::calcAngle(orientation, movDir);
-                    assert(angle <= 180.0);
-                    if(angle < movementToOrientationAngleThresh)
-                    {
-                        return 1; // angle small enough, so head-tail orientation can be verified true
-                    }
-                    else if(angle > 180-movementToOrientationAngleThresh)
-                    {
-                        return -1; // angle high enough, so head-tail orientation need to be changed
-                    }
-                }
-                counter = 1; // angle/movLength not informative enough, go on
-                continue;
-            }
-        }
-        else
-        {
-            counter = 0;
+            return indicator;
         }
     }
     
@@ -2093,18 +2773,18 @@ int LarvaeContainer::calcHeadTailRecognitionIndicator1(const uint larvaIndex, co
     for(uint i = from; i+stepWidth <= to; i++)
     {
         double bendingAngle1 = bendingAngles.at(i-from);
-        double spineLength1 = mLarvae[larvaIndex].parameters[i].spineLength;
+        double spineLength1 = mLarvae[larvaIndex].parameters.getValue(TrackColumns::SPINE_LENGTH, i);
         for(uint j = i+stepWidth; j < std::min(i+timeWindow,to); j = j+stepWidth)
         {
             double bendingAngle2 = bendingAngles.at(j-from);
             // bendingAngle got considerably bigger?
             if(bendingAngle2-bendingAngle1 > bendingAngleChangeThresh)
             {
-                double spineSize = mLarvae[larvaIndex].parameters[i].spine.size();
-                cv::Point2f head1 = mLarvae[larvaIndex].parameters[i].spine.at(0);
-                cv::Point2f tail1 = mLarvae[larvaIndex].parameters[i].spine.at(spineSize-1);
-                cv::Point2f head2 = mLarvae[larvaIndex].parameters[j].spine.at(0);
-                cv::Point2f tail2 = mLarvae[larvaIndex].parameters[j].spine.at(spineSize-1);
+                double spineSize = mLarvae[larvaIndex].parameters.getSpineSize(i);
+                cv::Point2f head1 = mLarvae[larvaIndex].parameters.getSpinePoint(i, 0);
+                cv::Point2f tail1 = mLarvae[larvaIndex].parameters.getSpinePoint(i, spineSize-1);
+                cv::Point2f head2 = mLarvae[larvaIndex].parameters.getSpinePoint(j, 0);
+                cv::Point2f tail2 = mLarvae[larvaIndex].parameters.getSpinePoint(j, spineSize-1);
                 
                 // calc movement of both endpoints
                 float headMov = Calc::normL2<float>(head1-head2);
@@ -2131,6 +2811,58 @@ int LarvaeContainer::calcHeadTailRecognitionIndicator1(const uint larvaIndex, co
     return 0; // could not verify orientation
 }
 
+int LarvaeContainer::calcHeadTailMovementIndicator(const uint larvaIndex, const uint timePoint, uint &counter)
+{
+    uint timeWindow = static_cast<uint>(CameraParameter::dFPS); // PARAMS
+    double maxBendingAngleThresh = 30; // PARAMS, indicates how much angle can differ from 180 degree
+    double fractionOfSpineLengthForMovement = 0.07; // PARAMS
+    double movementToOrientationAngleThresh = 50; // PARAMS
+    uint i = timePoint;
+    
+    double angleDiff = std::abs(180 - mLarvae[larvaIndex].parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, i));
+    if(angleDiff <= maxBendingAngleThresh)
+    {
+        counter++;
+        if(counter >= timeWindow)
+        {
+            // now, check if there was a significant movement
+            cv::Point mom1 = mLarvae[larvaIndex].parameters.getMomentum(i-counter+1);
+            cv::Point mom2 = mLarvae[larvaIndex].parameters.getMomentum(i);
+            cv::Point2f movDir = mom2 - mom1;
+            
+            // movement must be wide enough and wider than change of spinelengths (think of pulling in the head)
+            float movLength = Calc::normL2<float>(movDir);
+            double spineLength1 = mLarvae[larvaIndex].parameters.getValue(TrackColumns::SPINE_LENGTH, i-counter+1);
+            double spineLength2 = mLarvae[larvaIndex].parameters.getValue(TrackColumns::SPINE_LENGTH, i);
+            double spineLengthChange = spineLength1-spineLength2; // if longer, its negative, so not considered in if condition
+            if(movLength > std::max(1.5*spineLengthChange, fractionOfSpineLengthForMovement * spineLength1))
+            {
+                double spineSize = mLarvae[larvaIndex].parameters.getSpineSize(i);
+                cv::Point head = mLarvae[larvaIndex].parameters.getSpinePoint(i, 0);
+                cv::Point tail = mLarvae[larvaIndex].parameters.getSpinePoint(i, spineSize-1);
+                cv::Point2f orientation = head-tail;
+                double angle = Calc::calcAngle(orientation, movDir);
+                assert(angle <= 180.0);
+                if(angle < movementToOrientationAngleThresh)
+                {
+                    return 1; // angle small enough, so head-tail orientation can be verified true
+                }
+                else if(angle > 180-movementToOrientationAngleThresh)
+                {
+                    return -1; // angle high enough, so head-tail orientation need to be changed
+                }
+            }
+            counter = 1; // angle/movLength not informative enough, go on
+        }
+    }
+    else
+    {
+        counter = 0;
+    }
+    
+    return 0;
+}
+
 int LarvaeContainer::calcHeadTailRecognitionIndicator2(const uint larvaIndex, const uint from, const uint to)
 {
     int changeDirectionalityCounter = 0;
@@ -2143,8 +2875,8 @@ int LarvaeContainer::calcHeadTailRecognitionIndicator2(const uint larvaIndex, co
         {
             timepointsTested++;
             
-            cv::Point head = mLarvae[larvaIndex].parameters[i].spine.at(0);
-            cv::Point tail = mLarvae[larvaIndex].parameters[i].spine.at(nSpinepoints-1);
+            cv::Point head = mLarvae[larvaIndex].parameters.getSpinePoint(i, 0);
+            cv::Point tail = mLarvae[larvaIndex].parameters.getSpinePoint(i, nSpinepoints-1);
             double angleMainBodyDirectionality = Calc::calcAngleToYAxes(tail,head);
             
             double angleDiff = Calc::calcAngleDiff(movementDirection,angleMainBodyDirectionality);
@@ -2176,7 +2908,7 @@ int LarvaeContainer::calcHeadTailRecognitionIndicator2(const uint larvaIndex, co
 bool LarvaeContainer::changeDirectionality(const uint larvaIndex, const uint timePoint, const RawLarva &rawlarva)
 {
     FIMTypes::spine_t previousSpine;
-    FIMTypes::spine_t curSpine = rawlarva.getDiscreteSpine();
+    FIMTypes::spine_t const& curSpine = rawlarva.getDiscreteSpine();
     bool change = false;
     if(timePoint > 0 && this->mLarvae.at(larvaIndex).getSpineAt(timePoint-1,previousSpine))
     {
@@ -2198,28 +2930,41 @@ bool LarvaeContainer::changeDirectionality(const uint larvaIndex, const uint tim
     return change;
 }
 
-template<class T> std::vector<T> LarvaeContainer::reverseVec(std::vector<T> const& v)
-{
-    std::vector<T> retVec;
-    retVec.reserve(v.size());
-    std::reverse_copy(v.begin(), v.end(), std::back_inserter(retVec));
-    
-    return retVec;
-}
-
-void LarvaeContainer::createNewLarva(const uint timePoint, const RawLarva &rawLarva, unsigned int larvaID)
+void LarvaeContainer::createNewLarva(const uint timePoint, RawLarva &&rawLarva, unsigned int larvaID)
 {
     Larva l;
-    l.setNSpinePoints(rawLarva.getDiscreteSpine().size());
+    // if the spine calculation is deferred, the number of spine points is set in calcDeferredSpines
+    l.setNSpinePoints(rawLarva.isSpineCalculated() ? rawLarva.getDiscreteSpine().size() : 0);
     
     l.setOrigin(rawLarva.getMomentum());
     
-    l.values.accDist = 0.0;
+    // features which are not part of the feature set keep these values
+    l.values.accDist            = 0.0;
+    l.values.momentumDist       = 0.0;
+    l.values.distToOrigin       = 0.0;
+    l.values.isCoiled           = false;
+    l.values.goPhase            = -1;
+    l.values.isLeftBended       = false;
+    l.values.isRightBended      = false;
+    l.values.movementDirection  = -1.0;
+    l.values.velosity           = std::numeric_limits<double>::min();
+    l.values.acceleration       = std::numeric_limits<double>::min();
+    l.values.nearestNeighbourDist = -1.0;
+    l.values.neighbourCount     = 0;
     l.setID(larvaID);
     
+    if(this->mOnlinePostProcessing)
+    {
+        l.postProcessing.isOnline                   = true;
+        l.postProcessing.firstOpenTimePoint         = timePoint;
+        l.postProcessing.firstUnorientedTimePoint   = timePoint;
+        this->mOnlineLarvaIDs.push_back(larvaID);
+    }
+    
     this->mLarvae.push_back(l);
+    this->mLarvaIndex[l.getID()] = this->mLarvae.size() - 1;
     
-    this->insertRawLarva(l.getID(), timePoint, rawLarva);
+    this->insertRawLarva(l.getID(), timePoint, std::move(rawLarva));
 }
 
 uint LarvaeContainer::getLastValidLavaID() const
@@ -39,13 +39,22 @@
 //#include <QtCore>
 #include <QFileDialog>
 #include <list>
+#include <memory>
+#include <unordered_map>
 
 #include "Data/Larva.hpp"
+#include "Data/LabelImage.hpp"
+#include "Data/TrackSnapshot.hpp"
+#include "GroupMetrics.hpp"
+#include "HeatMapAccumulator.hpp"
 #include "InputGenerator.hpp"
 #include "OutputGenerator.hpp"
+#include "CSVWriter.hpp"
+#include "PersistenceQueue.hpp"
 #include "GUI/TrackerScene.hpp"
 #include "GUI/TrackerSceneLarva.hpp"
 #include "GUI/LandmarkContainer.hpp"
+#include "Utility/ParallelFor.hpp"
 
 class LarvaeContainer : public QObject
 {
@@ -56,8 +65,70 @@ private:
     double                                      mMaxSpineLength;
     int                                         mMaximumNumberOfTimePoints;
     
+    /**
+     * @brief mLarvaIndex maps larva ids to their index in mLarvae
+     */
+    std::unordered_map<uint, size_t>            mLarvaIndex;
+    
+    /**
+     * @brief mActiveLarvae indices (ascending) of the larvae assigned at mActiveTimePoint, i.e. the latest time point
+     *        passed to processUntrackedLarvae. mAssignedLarvae collects the larvae inserted at mAssignedTimePoint
+     *        (the frame currently tracked). The active set is only valid during tracking (mHasActiveLarvae); any
+     *        other change of the larvae falls back to scanning all larvae.
+     */
+    bool                                        mHasActiveLarvae;
+    uint                                        mActiveTimePoint;
+    std::vector<size_t>                         mActiveLarvae;
+    uint                                        mAssignedTimePoint;
+    std::vector<size_t>                         mAssignedLarvae;
+    
+    /**
+     * @brief mOnlinePostProcessing larvae created during tracking are post-processed online (see
+     *        updateOnlinePostProcessing); mOnlineLarvaIDs ids of the larvae whose track has not ended yet
+     */
+    bool                                        mOnlinePostProcessing;
+    std::vector<uint>                           mOnlineLarvaIDs;
+    
+    /**
+     * @brief mGroupMetrics group behaviour values of the tracked frames (see updateGroupMetrics)
+     */
+    GroupMetrics                                mGroupMetrics;
+    
+    /**
+     * @brief mHeatMaps occupancy and trajectory heat maps, updated by insertRawLarva if enabled (see enableHeatMaps)
+     */
+    HeatMapAccumulator                          mHeatMaps;
+    
+    /**
+     * @brief mPersistenceQueue writes the results saved by saveResultLarvae and saveBinaryResults in the background
+     */
+    PersistenceQueue                            mPersistenceQueue;
+    
+    void rebuildLarvaIndex();
+    void invalidateActiveLarvae();
+    bool hasActiveLarvaeAt(const uint timePoint) const {return this->mHasActiveLarvae && this->mActiveTimePoint == timePoint;}
+    
     uint getLastValidLavaID() const;
     
+    /**
+     * @brief setSpineParameters moves spine and radii of the raw larva into values (inverted if necessary) and
+     *        calculates all spine dependent values (bending angle, spine length and, if enabled in the
+     *        FeatureParameters, go phase and bending indicators).
+     *        Only the larva at larvaIndex is accessed, thus different larvae can be processed concurrently.
+     */
+    void setSpineParameters(const size_t larvaIndex, const uint timePoint, RawLarva & rawLarva, Larva::ValuesType & values);
+    
+    /**
+     * @brief setGoPhaseIndicator calculates the go phase indicator of values (the larva at larvaIndex at timePoint)
+     */
+    void setGoPhaseIndicator(const size_t larvaIndex, const uint timePoint, Larva::ValuesType & values);
+    
+    /**
+     * @brief updateGroupMetrics calculates the group behaviour values of the given larvae (indices of all larvae
+     *        existing at timePoint)
+     */
+    void updateGroupMetrics(const uint timePoint, std::vector<size_t> const& indices);
+    
     double calcMomentumDist(const uint larvaIndex, 
                             const uint timePoint, 
                             cv::Point const & curMomentum) const;
@@ -85,15 +156,38 @@ private:
     int calcHeadTailRecognitionIndicator2(const uint larvaIndex,
                                           const uint from,
                                           const uint to);
+    
+    /**
+     * @brief calcHeadTailMovementIndicator one step of the movement based head/tail recognition (first approach of
+     *        calcHeadTailRecognitionIndicator1) at timePoint; counter is the number of preceding unbended time points
+     * @return 1 (orientation verified), -1 (orientation must be changed) or 0 (undecided)
+     */
+    int calcHeadTailMovementIndicator(const uint larvaIndex, const uint timePoint, uint & counter);
+    
+    /**
+     * @brief applyHeadTailIndicator marks the values of timePoint (of the larva at larvaIndex) as well oriented and changes head and
+     *        tail if the indicator is -1
+     */
+    void applyHeadTailIndicator(const uint larvaIndex, const uint timePoint, const int indicator);
+    
+    void processOnlineTimePoint(const size_t larvaIndex, const uint timePoint);
+    void closeOnlineRun(const size_t larvaIndex, const uint to);
+    void closeOnlineLarva(const size_t larvaIndex);
+    
+    /**
+     * @brief finalizeTimePoint calculates all values of the post-processing for timePoint (the orientation of
+     *        timePoint and the next time point must be final)
+     */
+    void finalizeTimePoint(const size_t larvaIndex, const uint timePoint, const bool isLast);
+    void updateVelocityAt(const size_t larvaIndex, const uint timePoint);
 
     bool changeDirectionality(const uint larvaIndex, const uint timePoint, RawLarva const & rawlarva);
-    template<class T> std::vector<T> reverseVec(std::vector<T> const & v);
     
     
     bool getIndexOfLarva(const uint id, size_t &index) const;
     FIMTypes::spine_t calcSpine(QPainterPath const& spinePath);
     
-    void updateLarvaSpine(const int index, const uint time, QPainterPath const& paintSpine, const std::vector<double> &radii);
+    void updateLarvaSpine(const int index, const uint time, QPainterPath const& paintSpine, FIMTypes::radii_t const& radii);
     void updateLarvaMomentum(const int index, const uint time, QPolygonF const& paintPolygon);
     void updateLarvaArea(const int index, const uint time, QPolygonF const& paintPolygon);
     void updateLarvaPerimeter(const int index, const uint time, QPolygonF const& paintPolygon);
@@ -130,19 +224,28 @@ public:
      *  This function is used during tracking to initialize new larval objects
      *
      * @param timePoint specifies the first detection for this larva
-     * @param rawLarva contains the uprocessed raw larva and is used to calculate all larval parameters
+     * @param rawLarva contains the uprocessed raw larva and is used to calculate all larval parameters.
+     *        Contour, spine and radii are moved out of the raw larva.
      * @param larvaID specifies the unique ID of this larval object
      */
-    void createNewLarva(const uint timePoint, RawLarva const & rawLarva, unsigned int larvaID);
+    void createNewLarva(const uint timePoint, RawLarva && rawLarva, unsigned int larvaID);
     
     /**
      * @brief insert is used to add new measurements (given by rawLarva) to this larva at a given time point
      * @param timePoint the given time point (for the parameters map)
      * @param rawLarva contains all raw larval values (i.e. features; e.g. the contour).
+     *        Contour, spine and radii are moved out of the raw larva.
      */
     void insertRawLarva(const uint larvaID, 
                         const uint timePoint, 
-                        RawLarva const & rawLarva);
+                        RawLarva && rawLarva);
+    
+    /**
+     * @brief calcDeferredSpines calculates the spines (and all spine dependent values) for all time points
+     *        at which the spine calculation was deferred during tracking (see LarvaeExtractionParameters::
+     *        bUseLazySpineCalculation). The larvae are processed in parallel.
+     */
+    void calcDeferredSpines();
     
     /**
      * @brief interpolateHeadTailOverTime changes the head/tail classification if necessary
@@ -166,6 +269,7 @@ public:
      */
     void fillTimeSamplingGaps(const uint larvaIndex);
     void fillTimeSamplingGaps();
+    void updateLarvaParameterAfterHeadTailInterpolation(const uint larvaIndex);
     void updateLarvaParameterAfterHeadTailInterpolation();
     
     /**
@@ -175,8 +279,61 @@ public:
      */
     bool isAssignedAt(const uint larvaID, const uint timePoint) const;
     
+    /**
+     * @brief interplolateLarvae runs all post-processing steps (head/tail interpolation, filling of the sampling
+     *        gaps and recalculation of the dependent features) after the whole video is processed.
+     *
+     * Every step only reads and writes the larva it is called for, thus the larvae are processed in parallel
+     * (all steps for one larva in a row); the results do not depend on the number of threads.
+     */
     void interplolateLarvae();
     
+    /**
+     * @brief setOnlinePostProcessing enables the online post-processing for all larvae created afterwards
+     *
+     * The post-processing of interplolateLarvae is done while tracking: the head/tail orientation of a sequence
+     * of non-coiled time points is final as soon as the movement based recognition decides (or the sequence ends),
+     * and all other values only depend on a bounded window around the time point. Each time point is finalized as
+     * soon as it leaves this window (see Larva::isFinalAt), the results equal those of interplolateLarvae.
+     * Requires the spines during tracking (i.e. no LarvaeExtractionParameters::bUseLazySpineCalculation).
+     */
+    void setOnlinePostProcessing(const bool enabled) {this->mOnlinePostProcessing = enabled;}
+    bool usesOnlinePostProcessing() const {return this->mOnlinePostProcessing;}
+    
+    /**
+     * @brief updateOnlinePostProcessing processes timePoint for all larvae with an open track and finalizes the
+     *        tracks which ended before timePoint (called once per tracked frame, after processUntrackedLarvae)
+     */
+    void updateOnlinePostProcessing(const uint timePoint);
+    
+    /**
+     * @brief finishOnlinePostProcessing finalizes all remaining time points after the last frame
+     */
+    void finishOnlinePostProcessing();
+    
+    /**
+     * @brief updateGroupMetrics calculates the group behaviour values of all larvae at timePoint if enabled
+     *        (see FeatureParameters::GROUP_BEHAVIOUR; called once per tracked frame, after processUntrackedLarvae)
+     *
+     * The positions are the spine mid points (the momentum if the spine is not calculated yet), which do not depend
+     * on the head/tail orientation. Movement directions which are not known yet (-1) are ignored.
+     */
+    void updateGroupMetrics(const uint timePoint);
+    GroupMetrics const& getGroupMetrics() const {return this->mGroupMetrics;}
+    
+    /**
+     * @brief enableHeatMaps accumulates the heat maps of all detections inserted afterwards (see HeatMapAccumulator;
+     *        disabled by removeAllLarvae)
+     */
+    void enableHeatMaps(cv::Size const& imageSize, const int binSize) {this->mHeatMaps.reset(imageSize, binSize);}
+    HeatMapAccumulator const& getHeatMaps() const {return this->mHeatMaps;}
+    
+    /**
+     * @brief takeResults moves the larvae, the group metrics and the heat maps into the given (frozen) snapshot
+     *        without copying the tracks; the container is empty afterwards (see removeAllLarvae)
+     */
+    void takeResults(std::vector<Larva>& larvae, GroupMetrics& groupMetrics, HeatMapAccumulator& heatMaps);
+    
     void readLarvae(QString const& ymlFileName, 
                     std::vector<std::string> &imgPaths, 
                     bool useUndist);
@@ -197,16 +354,48 @@ public:
     bool eraseLarvaAt(const uint larvaID, const uint time);
     bool eraseLarva(const uint larvaID);
     
+    /**
+     * @brief saveResultLarvae asks for the result files and writes them in the background (see PersistenceQueue)
+     *        from a snapshot of the larvae, the ROIs and the landmarks, thus the gui is not blocked
+     */
     void saveResultLarvae(const std::vector<std::string> &imgPaths, 
                           QImage const& img,
                           const bool useUndist, 
                           RegionOfInterestContainer const* ROIContainer = NULL,
                           LandmarkContainer const* landmarkContainer = NULL);
+    
+    /**
+     * @brief saveBinaryResults writes the larvae (read from the yml results file at ymlPath) to a binary results file
+     *        in the background from a snapshot of the larvae (see InputGenerator::convertYMLToBinary); failures are
+     *        reported by the log of the PersistenceQueue
+     */
+    void saveBinaryResults(std::string const& ymlPath, 
+                           std::string const& binaryPath, 
+                           std::vector<std::string> const& imgPaths, 
+                           const bool useUndist);
 
     void processUntrackedLarvae(const uint timePoint);
     
     /// Getter
-    std::vector< Larva > getAllLarvae() const {return this->mLarvae;}
+    
+    /**
+     * @brief const_iterator read-only iteration over all larvae (no copies). Iterators and references are
+     *        invalidated by any modification of the container (e.g. new larvae, removed tracks).
+     */
+    typedef std::vector<Larva>::const_iterator const_iterator;
+    const_iterator begin() const {return this->mLarvae.begin();}
+    const_iterator end() const {return this->mLarvae.end();}
+    
+    /**
+     * @brief getLarvae read-only view of all larvae (same validity as const_iterator)
+     */
+    std::vector<Larva> const& getLarvae() const {return this->mLarvae;}
+    
+    /**
+     * @brief getLarvaeAt collects pointers to the larvae existing at timePoint (uses the active larvae during
+     *        tracking, see processUntrackedLarvae; same validity as const_iterator)
+     */
+    void getLarvaeAt(const uint timePoint, std::vector<Larva const*>& larvae) const;
     QStringList getAllLarvaeIDs() const;
     int getNumberOfLarvae() const {return this->mLarvae.size();}
     Larva* getLarvaPointer(const unsigned int index)
@@ -225,11 +414,43 @@ public:
     bool getLarva(const uint index, Larva& l);
     bool getLarvaByID(uint larvaID, Larva& l);
     
+    /**
+     * @brief getLarvaAt, findLarva read-only access to a single larva by index or id without copying it
+     * @return pointer to the larva (same validity as const_iterator) or nullptr if there is no such larva
+     */
+    Larva const* getLarvaAt(const uint index) const;
+    Larva const* findLarva(const uint larvaID) const;
+    
     std::vector<uint>   getAllTimesteps(const uint larvaID);
     QPair<int, int>     getStartEndTimesteps(const uint larvaID);
     std::vector< int >  getAllValidLarvaeIDS(const uint timePoint);
     
-    bool larvaHasPointInContour(uint const timePoint, const uint larvaID, FIMTypes::contour_t const & rawLarvaContour);
+    /**
+     * @brief getTrackSnapshot collects the features of all larvae assigned at timePoint in a single pass over the
+     *        larvae (the ids are in the same order as returned by getAllValidLarvaeIDS). If motion prediction is
+     *        used, the predictions refer to timePoint + 1.
+     * @param timePoint time point
+     * @param snapshot the snapshot (previous content is removed)
+     */
+    void getTrackSnapshot(const uint timePoint, TrackSnapshot& snapshot) const;
+    
+    /**
+     * @brief larvaHasPointInLabel checks if the momentum or a spine point of the larva at timePoint-1 lies strictly
+     *        inside the contour of a raw larva at timePoint. Points not covered by the label are rejected by a lookup;
+     *        covered points are confirmed by pointPolygonTest, thus points on the contour do not count (the label
+     *        image includes the contour border).
+     * @param timePoint current time point
+     * @param larvaID larva id
+     * @param labels label image of the raw larvae at timePoint
+     * @param label label of the raw larva
+     * @param contour contour of the raw larva
+     * @return true if the momentum or at least one spine point lies within the raw larva
+     */
+    bool larvaHasPointInLabel(uint const timePoint, 
+                              const uint larvaID, 
+                              LabelImage const& labels, 
+                              int const label, 
+                              FIMTypes::contour_t const& contour) const;
     
     /**************** GETTER **********************/
     bool getSpineMidPointIndex(const uint larvaID, uint &index) const;
@@ -280,6 +501,10 @@ public slots:
     void updateLandmark(const Landmark *l);
     void removeLandmark(const QString name);
     
+    /**
+     * @brief removeShortTracks removes all larvae with at most minTrackLenght time points together with their counts
+     *        in the heat maps; the group metrics of their frames are recalculated without them
+     */
     void removeShortTracks(const uint minTrackLenght);
     
     void setMaximumNumberOfTimePoints(const int maxTimePoints);
@@ -32,6 +32,8 @@
  *****************************************************************************/
 
 #include "OutputGenerator.hpp"
+#include "CSVWriter.hpp"
+#include "BinaryResultsFile.hpp"
 
 using namespace cv;
 using std::vector;
@@ -50,6 +52,15 @@ void OutputGenerator::saveConfiguration(const std::string& path)
         out << "iMaxLarvaeArea"         << GeneralParameters::iMaxLarvaeArea;
         out << "iMinLarvaeArea"         << GeneralParameters::iMinLarvaeArea;
 		out << "iValleyThreshold"		<< GeneralParameters::iValleyThreshold;
+        out << "bStreamCSVOutput"       << GeneralParameters::bStreamCSVOutput;
+        out << "iDistanceOutputMode"    << GeneralParameters::iDistanceOutputMode;
+        out << "iDistanceOutputFormat"  << GeneralParameters::iDistanceOutputFormat;
+        out << "iDistanceNeighbours"    << GeneralParameters::iDistanceNeighbours;
+        out << "dDistanceRadius"        << GeneralParameters::dDistanceRadius;
+        out << "dGroupNeighbourRadius"  << GeneralParameters::dGroupNeighbourRadius;
+        out << "bSaveHeatMaps"          << GeneralParameters::bSaveHeatMaps;
+        out << "iHeatMapBinSize"        << GeneralParameters::iHeatMapBinSize;
+        out << "bSaveOverlayVideo"      << GeneralParameters::bSaveOverlayVideo;
         
         /* Write CameraParameter */
         out << "dFSP"           << CameraParameter::dFPS;
@@ -65,6 +76,8 @@ void OutputGenerator::saveConfiguration(const std::string& path)
         /* Write LarvaeExtractionParameters */
         out << "LarvaeExtractionParametersbUseDefault"  << LarvaeExtractionParameters::bUseDefault;
         out << "iNumerOfSpinePoints"                    << LarvaeExtractionParameters::iNumerOfSpinePoints;
+        out << "bUseLazySpineCalculation"               << LarvaeExtractionParameters::bUseLazySpineCalculation;
+        out << "iMinTrackLengthForSpineCalculation"     << LarvaeExtractionParameters::iMinTrackLengthForSpineCalculation;
         
         /* Write IPANContourCurvatureParameters */
         out << "bUseDynamicIpanParameterCalculation"    << LarvaeExtractionParameters::IPANContourCurvatureParameters::bUseDynamicIpanParameterCalculation;
@@ -83,6 +96,20 @@ void OutputGenerator::saveConfiguration(const std::string& path)
         out << "iAngleThreshold"                            << LarvaeExtractionParameters::StopAndGoCalculation::iAngleThreshold;
         out << "iFramesForSpeedCalculation"                 << LarvaeExtractionParameters::StopAndGoCalculation::iFramesForSpeedCalculation;
         out << "iSpeedThreshold"                            << LarvaeExtractionParameters::StopAndGoCalculation::iSpeedThreshold;
+        
+        /* Write AssignmentParameters (motion prediction) */
+        out << "bUseMotionPrediction"       << LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction;
+        out << "dMotionProcessNoise"        << LarvaeExtractionParameters::AssignmentParameters::dMotionProcessNoise;
+        out << "dMotionMeasurementNoise"    << LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise;
+        out << "dMotionGatingSigma"         << LarvaeExtractionParameters::AssignmentParameters::dMotionGatingSigma;
+        
+        /* Write FeatureParameters */
+        out << "enabledFeatures" << "[";
+        for (auto const& name : FeatureParameters::getEnabledFeatureNames())
+        {
+            out << name;
+        }
+        out << "]";
     }
     
     out.release();
@@ -110,562 +137,154 @@ void OutputGenerator::writeCSVFile(std::string const& path,
                                    size_t movieLength,
                                    LandmarkContainer const* landmarkContainer)
 {
-    std::ofstream ofs;
-    ofs.open(path.c_str());
-    
-    for (size_t i = 0; i < larvae.size(); ++i)
-    {
-        ofs << "," << "fish(" << larvae.at(i).getID() << ")";
-    }
-    ofs << std::endl;
-    
-    // write momentum_x
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "mom_x(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrMomentum(t, 0).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write momentum_y
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "mom_y(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrMomentum(t, 1).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write distance momentum
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "mom_dst(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrMomentumDist(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write accumulated distance momentum
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "acc_dst(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrAccDist(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write distance to origin (momentum)
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "dst_to_origin(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrDistToOrigin(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write area
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "area(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrArea(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write perimeter
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "perimeter(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrPerimeter(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write spine length
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "spine_length(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrSpineLength(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write body bending
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "bending(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrMainBodyBendingAngle(t).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write head x position
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "head_x(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrSpine(t, 0, 0).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write head y position
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "head_y(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrSpine(t, 0, 1).c_str();
-        }
-        
-        ofs << std::endl;
-    }
-    
-    // write spinepoints
-    unsigned int midPos = (int)(((larvae.at(0)).getNSpinePoints() - 1) / 2);
-    
-    for (uint i = 1; i < larvae.at(0).getNSpinePoints() - 1; ++i)
-    {
-        // write x position of spinepoint i
-        for (size_t t = 0; t < movieLength; ++t)
-        {
-            ofs << "spinepoint_" << i << "_x(" << t << ")";
-            
-            for (auto const& l : larvae)
-            {
-                ofs << "," << l.getStrSpine(t, i, 0).c_str();
-            }
-            
-            ofs << std::endl;
-        }
-        
-        // write y position of spinepoint i
-        for (size_t t = 0; t < movieLength; ++t)
-        {
-            ofs << "spinepoint_" << i << "_y(" << t << ")";
-            
-            for (auto const& l : larvae)
-            {
-                ofs << "," << l.getStrSpine(t, i, 1).c_str();
-            }
-            
-            ofs << std::endl;
-        }
-    }
-    
-    // write tail x position
-    unsigned int tailPos = larvae.at(0).getNSpinePoints() - 1;
-    for (size_t t = 0; t < movieLength; ++t)
+    CSVWriter::writeTable(path, larvae, movieLength, landmarkContainer);
+}
+
+bool OutputGenerator::writeCSVFile(std::string const& path,
+                                   std::vector<Larva> const& larvae,
+                                   size_t movieLength,
+                                   std::vector<std::string> const& landmarkNames)
+{
+    return CSVWriter::writeTable(path, larvae, movieLength, landmarkNames);
+}
+
+void OutputGenerator::writeYMLFile(const std::string& path,
+                                   const std::vector<Larva>& larvae,
+                                   const std::vector<std::string>& imgPaths,
+                                   const bool useUndist,
+                                   const RegionOfInterestContainer* RIOContainer,
+                                   const LandmarkContainer* landmarkContainer)
+{
+    OutputGenerator::writeYMLFile(path, larvae, imgPaths, useUndist, OutputGenerator::serializeSceneYML(RIOContainer, landmarkContainer));
+}
+
+std::string OutputGenerator::serializeSceneYML(const RegionOfInterestContainer* RIOContainer,
+                                               const LandmarkContainer* landmarkContainer)
+{
+    std::string sceneYML;
+    if (RIOContainer != nullptr || landmarkContainer != nullptr)
     {
-        ofs << "tail_x(" << t << ")";
+        cv::FileStorage fs = cv::FileStorage(".yml", cv::FileStorage::WRITE | cv::FileStorage::MEMORY, "UTF-8");
         
-        for (auto const& l : larvae)
+        if (RIOContainer != nullptr)
         {
-            ofs << "," << l.getStrSpine(t, tailPos, 0).c_str();
+            fs << "ROIContainer" << RIOContainer;
         }
         
-        ofs << std::endl;
-    }
-    
-    // write tail y position
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "tail_y(" << t << ")";
-        
-        for (auto const& l : larvae)
+        if (landmarkContainer != nullptr)
         {
-            ofs << "," << l.getStrSpine(t, tailPos, 1).c_str();
+            fs << "LandmarkContainer" << landmarkContainer;
         }
         
-        ofs << std::endl;
+        sceneYML = fs.releaseAndGetString();
     }
     
-    // write spinepoint radii
-    for (uint i = 1; i < larvae.at(0).getNSpinePoints() - 1; ++i)
-    {
-        for (size_t t = 0; t < movieLength; ++t)
-        {
-            ofs << "radius_" << i << "(" << t << ")";
-            
-            for (auto const& l : larvae)
-            {
-                ofs << "," << l.getStrSpineRadius(t, i).c_str();
-            }
-            
-            ofs << std::endl;
-        }
-    }
+    return sceneYML;
+}
+
+bool OutputGenerator::writeYMLFile(const std::string& path,
+                                   const std::vector<Larva>& larvae,
+                                   const std::vector<std::string>& imgPaths,
+                                   const bool useUndist,
+                                   const std::string& sceneYML)
+{
+    cv::FileStorage fs =  cv::FileStorage(path, cv::FileStorage::WRITE, "UTF-8");
     
-    // write is coiled indicator
-    for (size_t t = 0; t < movieLength; ++t)
+    if (!fs.isOpened())
     {
-        ofs << "is_coiled(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrIsCoiledIndicator(t);
-        }
-        
-        ofs << std::endl;
+        return false;
     }
     
-    // write is well oriented indicator
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "is_well_oriented(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrIsWellOriented(t);
-        }
-        
-        ofs << std::endl;
-    }
+    fs << "storageDate" << QDateTime::currentDateTime().toString("ddd MMM dd yyyy hh:mm:ss.zzz").toStdString();
     
-    // write go phase indicator
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "go_phase(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrGoPhaseIndicator(t);
-        }
-        
-        ofs << std::endl;
-    }
+    fs << "imgNames" << imgPaths;
     
-    // write left bended indicator
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "left_bended(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrLeftBendingIndicator(t);
-        }
-        
-        ofs << std::endl;
-    }
+    fs << "useUndist" << useUndist;
     
-    // write right bended indicator
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "right_bended(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrRightBendingIndicator(t);
-        }
-        
-        ofs << std::endl;
-    }
+    fs << "data" << "[";
     
-    // write movement direction
-    for (size_t t = 0; t < movieLength; ++t)
+    for (auto const& l : larvae)
     {
-        ofs << "mov_direction(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrMovementDirection(t);
-        }
-        
-        ofs << std::endl;
+        fs << l;
     }
     
-    // write velocity
-    for (size_t t = 0; t < movieLength; ++t)
-    {
-        ofs << "velocity(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrVelosity(t);
-        }
-        
-        ofs << std::endl;
-    }
+    fs << "]";
+    fs.release();
     
-    // write acceleration
-    for (size_t t = 0; t < movieLength; ++t)
+    // the top level sections of the scene follow the data section (skip the directives of the document)
+    size_t begin = 0;
+    while (begin < sceneYML.size() && (sceneYML[begin] == '%' || sceneYML.compare(begin, 3, "---") == 0))
     {
-        ofs << "acceleration(" << t << ")";
-        
-        for (auto const& l : larvae)
-        {
-            ofs << "," << l.getStrAcceleration(t);
-        }
-        
-        ofs << std::endl;
+        size_t const lineEnd = sceneYML.find('\n', begin);
+        begin = (lineEnd == std::string::npos) ? sceneYML.size() : lineEnd + 1;
     }
     
-    // write distances to landmarks
-    if (landmarkContainer != nullptr)
+    if (begin < sceneYML.size())
     {
-        // get number of landmarks
-        int numberOfLandmarks = landmarkContainer->getSize();
-        for (int i = 0; i < numberOfLandmarks; ++i)
-        {
-            // get name of landmark i
-            std::string landmarkName = landmarkContainer->getLandmarkName(i).toStdString();
-            
-            // write distance to landmark i
-            for (unsigned int t = 0; t < movieLength; ++t)
-            {
-                ofs << "dist_to_" << landmarkName << "(" << t << ")";
-                
-                for (auto const& l : larvae)
-                {
-                    ofs << "," << l.getStrDistanceToLandmark(t, landmarkName);
-                }
-                
-                ofs << std::endl;
-            }
-        }
-        
-        // write indicator if larva is in landmark
-        for (int i = 0; i < numberOfLandmarks; ++i)
-        {
-            // get name of landmark i
-            std::string landmarkName = landmarkContainer->getLandmarkName(i).toStdString();
-            
-            // write is in landmark i
-            for (unsigned int t = 0; t < movieLength; ++t)
-            {
-                ofs << "is_in_" << landmarkName << "(" << t << ")";
-                
-                for (auto const& l : larvae)
-                {
-                    ofs << "," << l.getStrIsInLandmark(t, landmarkName);
-                }
-                
-                ofs << std::endl;
-            }
-        }
-        
-        // write bearing angle to landmark
-        for (int i = 0; i < numberOfLandmarks; ++i)
-        {
-            // get name of landmark i
-            std::string landmarkName = landmarkContainer->getLandmarkName(i).toStdString();
-            
-            // write bearing angle to landmark i
-            for (unsigned int t = 0; t < movieLength; ++t)
-            {
-                ofs << "bearing_angle_to_" << landmarkName << "(" << t << ")";
-                
-                for (auto const& l : larvae)
-                {
-                    ofs << "," << l.getStrBearingAngleToLandmark(t, landmarkName);
-                }
-                
-                ofs << std::endl;
-            }
-        }
+        std::ofstream ofs(path.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+        ofs.write(sceneYML.data() + begin, sceneYML.size() - begin);
+        return ofs.good();
     }
     
-    ofs.flush();
-    ofs.close();
-    
+    return true;
 }
 
-void OutputGenerator::writeYMLFile(const std::string& path,
-                                   const std::vector<Larva>& larvae,
-                                   const std::vector<std::string>& imgPaths,
-                                   const bool useUndist,
-                                   const RegionOfInterestContainer* RIOContainer,
-                                   const LandmarkContainer* landmarkContainer)
+bool OutputGenerator::writeBinaryResultsFile(const std::string& path,
+                                             const std::vector<Larva>& larvae,
+                                             const std::vector<std::string>& imgPaths,
+                                             const bool useUndist,
+                                             const RegionOfInterestContainer* RIOContainer,
+                                             const LandmarkContainer* landmarkContainer)
 {
-    cv::FileStorage fs =  cv::FileStorage(path, cv::FileStorage::WRITE, "UTF-8");
-    
-    if (fs.isOpened())
-    {
-        fs << "storageDate" << QDateTime::currentDateTime().toString("ddd MMM dd yyyy hh:mm:ss.zzz").toStdString();
-        
-        fs << "imgNames" << imgPaths;
-        
-        fs << "useUndist" << useUndist;
-        
-        fs << "data" << "[";
-        
-        for (auto const& l : larvae)
-        {
-            fs << l;
-        }
-        
-        fs << "]";
-        
-        if (RIOContainer != nullptr)
-        {
-            fs << "ROIContainer" << RIOContainer;
-        }
-        
-        if (landmarkContainer != nullptr)
-        {
-            fs << "LandmarkContainer" << landmarkContainer;
-        }
-    }
-    fs.release();
+    return BinaryResultsWriter::write(path, larvae, imgPaths, useUndist, OutputGenerator::serializeSceneYML(RIOContainer, landmarkContainer));
+}
+
+bool OutputGenerator::writeBinaryResultsFile(const std::string& path,
+                                             const std::vector<Larva>& larvae,
+                                             const std::vector<std::string>& imgPaths,
+                                             const bool useUndist,
+                                             const std::string& sceneYML)
+{
+    return BinaryResultsWriter::write(path, larvae, imgPaths, useUndist, sceneYML);
 }
 
-void OutputGenerator::drawTrackingResults(const std::string& trackImgPath,
-                                          const std::vector<std::string>& imgPaths,
+bool OutputGenerator::drawTrackingResults(const std::string& trackImgPath,
+                                          const std::string& trackImgNoNumbersPath,
+                                          const cv::Size& imageSize,
                                           const std::vector<Larva>& larvae)
 {
-    cv::Mat tmpImg = cv::imread(imgPaths.at(0), 0);
-    // initialize resultant track image
-    cv::Mat resultantTrackImage = cv::Mat::zeros(tmpImg.size(), CV_8UC3);
-    
-    qsrand(QTime::currentTime().msec());
-    
-    for (std::vector<Larva>::const_iterator larvaIt = larvae.begin(); larvaIt != larvae.end(); ++larvaIt)
-    {
-        std::vector<cv::Point> midPoints = larvaIt->getAllMidPoints();
-        std::vector<cv::Point> headPoints = larvaIt->getAllHeadPoints();
-        std::vector<cv::Point> tailPoints = larvaIt->getAllTailPoints();
-        
-        // calculate random color
-        int b = qrand() % 256;
-        int g = qrand() % 256;
-        int r = qrand() % 256;
-        cv::Scalar color(b, g, r);
-        
-        std::stringstream ss;
-        ss << larvaIt->getID();
-        cv::putText(resultantTrackImage, ss.str(), midPoints.at(0), CV_FONT_HERSHEY_PLAIN, 2, color, 1);
-        
-        for (unsigned int index = 0; index < midPoints.size(); ++index)
-        {
-            cv::line(resultantTrackImage, headPoints.at(index), midPoints.at(index), color, 2);
-            cv::line(resultantTrackImage, midPoints.at(index), tailPoints.at(index), color, 2);
-        }
-    }
-    
-    cv::imwrite(trackImgPath, resultantTrackImage);
+    return TrackRenderer::writeOverviews(imageSize, larvae, trackImgPath, trackImgNoNumbersPath);
 }
 
-void OutputGenerator::drawTrackingResultsNoNumbers(const std::string& trackImgPath,
-                                                   const std::vector<std::string>& imgPaths,
-                                                   const std::vector<Larva>& larvae)
+bool OutputGenerator::writeOverlayVideo(const std::string& videoPath,
+                                        const std::vector<std::string>& imgPaths,
+                                        const std::vector<Larva>& larvae,
+                                        const unsigned int movieLength,
+                                        const cv::Size& frameSize,
+                                        const cv::Mat& roiMask,
+                                        const Backgroundsubtractor* bs)
 {
-    cv::Mat tmpImg = cv::imread(imgPaths.at(0), 0);
-    
-    // initialize resultant track image
-    cv::Mat resultantTrackImage = cv::Mat::zeros(tmpImg.size(), CV_8UC3);
-    
-    qsrand(QTime::currentTime().msec());
-    
-    for (std::vector<Larva>::const_iterator larvaIt = larvae.begin(); larvaIt != larvae.end(); ++larvaIt)
-    {
-        std::vector<cv::Point> midPoints    = larvaIt->getAllMidPoints();
-        std::vector<cv::Point> headPoints   = larvaIt->getAllHeadPoints();
-        std::vector<cv::Point> tailPoints   = larvaIt->getAllTailPoints();
-        
-        // calculate random color
-        int b = qrand() % 256;
-        int g = qrand() % 256;
-        int r = qrand() % 256;
-        cv::Scalar color(b, g, r);
-        
-        for (unsigned int index = 0; index < midPoints.size(); ++index)
-        {
-            cv::line(resultantTrackImage, headPoints.at(index), midPoints.at(index), color, 2);
-            cv::line(resultantTrackImage, midPoints.at(index), tailPoints.at(index), color, 2);
-        }
-    }
-    
-    cv::imwrite(trackImgPath, resultantTrackImage);
-    tmpImg.release();
-    resultantTrackImage.release();
+    return TrackRenderer::writeOverlayVideo(videoPath, imgPaths, larvae, movieLength, frameSize, roiMask, bs, CameraParameter::dFPS);
 }
 
-void OutputGenerator::saveResultImage(const QString& path, const QImage& img)
+bool OutputGenerator::saveResultImage(const QString& path, const QImage& img)
 {
-    cv::imwrite(QtOpencvCore::qstr2str(path), QtOpencvCore::qimg2img(img));
+    return cv::imwrite(QtOpencvCore::qstr2str(path), QtOpencvCore::qimg2img(img));
 }
 
 void OutputGenerator::writeDistancesCSVFile(std::string const& path,
 											std::vector<Larva> const& larvae,
 											size_t movieLength)
 {
-	std::ofstream ofs;
-	ofs.open(path.c_str());
-
-	// write column names
-	for (size_t i = 0; i < larvae.size(); ++i)
-	{
-		ofs << "," << "fish(" << larvae.at(i).getID() << ")";
-	}
-	ofs << std::endl;
-
-	// for each fish: write distance to each fish for every time point
-	for (size_t i = 0; i < larvae.size(); ++i)
-	{
-		for (size_t t = 0; t < movieLength; ++t)
-		{
-			ofs << "dst_to_fish[" << larvae.at(i).getID() << "](" << t << ")";
-
-			for (auto const& l : larvae)
-			{
-				ofs << ",";
-				cv::Point p1;
-				cv::Point p2;
-				if (l.getSpineMidPointAt(t, p1) && larvae.at(i).getSpineMidPointAt(t, p2) && l.getID() != larvae.at(i).getID())
-				{
-					std::stringstream str;
-					str << Calc::eucledianDist(p1, p2);
-					ofs << str.str().c_str();
-				}
-			}
-
-			ofs << std::endl;
-		}
-	}
+	DistanceWriter::write(path, larvae, movieLength, DistanceWriter::getDefaultOptions());
+}
 
-	ofs.flush();
-	ofs.close();
+bool OutputGenerator::writeDistancesFile(std::string const& path,
+										 std::vector<Larva> const& larvae,
+										 size_t movieLength,
+										 DistanceWriter::Options const& options)
+{
+	return DistanceWriter::write(path, larvae, movieLength, options);
 }
 
 bool OutputGenerator::getTimeIntervall(std::vector<Larva> const& larvae, std::pair<int, int>& timeInterval)
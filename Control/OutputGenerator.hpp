@@ -52,6 +52,8 @@
 #include "GUI/LandmarkContainer.hpp"
 
 #include "Utility/FileStorageUtility.hpp"
+#include "DistanceWriter.hpp"
+#include "TrackRenderer.hpp"
 
 
 class OutputGenerator
@@ -69,6 +71,16 @@ public:
                              size_t movieLength,
                              LandmarkContainer const* landmarkContainer = nullptr);
     
+    /**
+     * @brief writeCSVFile writes the feature table with the landmark columns of the given landmark names
+     *        (see CSVWriter::getLandmarkNames)
+     * @return false if the file could not be written
+     */
+    static bool writeCSVFile(std::string const& path,
+                             std::vector<Larva> const& larvae,
+                             size_t movieLength,
+                             std::vector<std::string> const& landmarkNames);
+    
     static void writeYMLFile(std::string const& path,
                              std::vector<Larva> const& larvae,
                              std::vector<std::string> const& imgPaths,
@@ -76,15 +88,64 @@ public:
                              RegionOfInterestContainer const* RIOContainer = nullptr,
                              LandmarkContainer const* landmarkContainer = nullptr);
     
-    static void drawTrackingResults(std::string const& trackImgPath,
-                                    std::vector<std::string> const& imgPaths,
+    /**
+     * @brief serializeSceneYML serializes the ROIs and landmarks to a yml document (empty if both are nullptr).
+     *        The document does not refer to the containers anymore, thus the results can be written by another
+     *        thread while the containers are modified (see PersistenceQueue).
+     */
+    static std::string serializeSceneYML(RegionOfInterestContainer const* RIOContainer,
+                                         LandmarkContainer const* landmarkContainer);
+    
+    /**
+     * @brief writeYMLFile writes the larvae followed by the sections of a serialized scene (see serializeSceneYML)
+     * @return false if the file could not be written
+     */
+    static bool writeYMLFile(std::string const& path,
+                             std::vector<Larva> const& larvae,
+                             std::vector<std::string> const& imgPaths,
+                             const bool useUndist,
+                             std::string const& sceneYML);
+    
+    /**
+     * @brief writeBinaryResultsFile writes the larvae to a binary results file (see BinaryResultsFormat), which
+     *        can be memory-mapped by the results viewer; ROIs and landmarks are embedded as yml document
+     */
+    static bool writeBinaryResultsFile(std::string const& path,
+                                       std::vector<Larva> const& larvae,
+                                       std::vector<std::string> const& imgPaths,
+                                       const bool useUndist,
+                                       RegionOfInterestContainer const* RIOContainer = nullptr,
+                                       LandmarkContainer const* landmarkContainer = nullptr);
+    
+    static bool writeBinaryResultsFile(std::string const& path,
+                                       std::vector<Larva> const& larvae,
+                                       std::vector<std::string> const& imgPaths,
+                                       const bool useUndist,
+                                       std::string const& sceneYML);
+    
+    /**
+     * @brief drawTrackingResults writes the track overview images with and without the larva ids (see TrackRenderer)
+     */
+    static bool drawTrackingResults(std::string const& trackImgPath,
+                                    std::string const& trackImgNoNumbersPath,
+                                    cv::Size const& imageSize,
                                     std::vector<Larva> const& larvae);
     
-    static void drawTrackingResultsNoNumbers(std::string const& trackImgPath,
-                                             std::vector<std::string> const& imgPaths,
-                                             std::vector<Larva> const& larvae);
+    /**
+     * @brief writeOverlayVideo writes the images annotated with the tracking results as a video (see TrackRenderer)
+     * @param frameSize size of the tracked images (i.e. of the background image)
+     * @param roiMask mask of the regions of interest applied before tracking (empty if there are none)
+     * @param bs background used to redraw the contours (nullptr to omit the contours)
+     */
+    static bool writeOverlayVideo(std::string const& videoPath,
+                                  std::vector<std::string> const& imgPaths,
+                                  std::vector<Larva> const& larvae,
+                                  unsigned int const movieLength,
+                                  cv::Size const& frameSize,
+                                  cv::Mat const& roiMask,
+                                  Backgroundsubtractor const* bs);
     
-	static void saveResultImage(QString const& path, QImage const& img);
+	static bool saveResultImage(QString const& path, QImage const& img);
 
 	/**
 	* @brief writeDistancesCSVFile exports all distances between all objects on every frame
@@ -92,6 +153,14 @@ public:
 	static void writeDistancesCSVFile(std::string const& path,
 									  std::vector<Larva> const& larvae,
 									  size_t movieLength);
+
+	/**
+	* @brief writeDistancesFile exports the distances selected by options (see DistanceWriter)
+	*/
+	static bool writeDistancesFile(std::string const& path,
+								   std::vector<Larva> const& larvae,
+								   size_t movieLength,
+								   DistanceWriter::Options const& options);
     
 private:
     static bool getTimeIntervall(std::vector<Larva> const& larvae, std::pair<int, int>& timeInterval);
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "PersistenceQueue.hpp"
+
+PersistenceQueue::PersistenceQueue(QObject *parent) 
+    : QObject(parent),
+      mIsRunningJob(false),
+      mStop(false)
+{
+    connect(this, SIGNAL(sendLogMessage(QString, LOGLEVEL)), Logger::getInstance(), SLOT(handleLogMessage(QString, LOGLEVEL)));
+}
+
+PersistenceQueue::~PersistenceQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStop = true;
+    }
+    this->mJobAvailable.notify_all();
+    
+    if(this->mThread.joinable())
+    {
+        this->mThread.join();
+    }
+}
+
+void PersistenceQueue::enqueue(const QString &name, std::vector<Writer> writers)
+{
+    Job job;
+    job.name = name;
+    job.writers = std::move(writers);
+    
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mJobs.push_back(std::move(job));
+        
+        // the thread is started with the first job and runs until the queue is destroyed
+        if(!this->mThread.joinable())
+        {
+            this->mThread = std::thread(&PersistenceQueue::run, this);
+        }
+    }
+    this->mJobAvailable.notify_one();
+}
+
+void PersistenceQueue::waitForFinished()
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    while(!this->mJobs.empty() || this->mIsRunningJob)
+    {
+        this->mJobsFinished.wait(lock);
+    }
+}
+
+bool PersistenceQueue::isIdle() const
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mJobs.empty() && !this->mIsRunningJob;
+}
+
+void PersistenceQueue::run()
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    for(;;)
+    {
+        while(this->mJobs.empty() && !this->mStop)
+        {
+            this->mJobAvailable.wait(lock);
+        }
+        
+        // pending jobs are finished before the thread stops
+        if(this->mJobs.empty())
+        {
+            return;
+        }
+        
+        Job job = std::move(this->mJobs.front());
+        this->mJobs.pop_front();
+        this->mIsRunningJob = true;
+        
+        lock.unlock();
+        this->process(job);
+        // release the snapshot of the job before reporting its completion
+        job.writers.clear();
+        lock.lock();
+        
+        this->mIsRunningJob = false;
+        if(this->mJobs.empty())
+        {
+            this->mJobsFinished.notify_all();
+        }
+    }
+}
+
+void PersistenceQueue::process(Job &job)
+{
+    // the writers run one after another, each of them parallelizes its own work
+    QStringList failedPaths;
+    for(Writer const& writer : job.writers)
+    {
+        bool succeeded = false;
+        try
+        {
+            succeeded = writer.write();
+        }
+        catch(...)
+        {
+            succeeded = false;
+        }
+        
+        if(!succeeded)
+        {
+            failedPaths.append(writer.path);
+            emit sendLogMessage(QString("Could not write ").append(writer.path), WARNING);
+        }
+    }
+    
+    emit sendLogMessage(QString("Results saved: ").append(job.name), INFO);
+    emit jobFinished(job.name, failedPaths);
+}
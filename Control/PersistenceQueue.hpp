@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef PERSISTENCEQUEUE_HPP
+#define PERSISTENCEQUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Logger.hpp"
+
+/**
+ * @brief The PersistenceQueue class writes results on a background thread
+ *
+ * A job consists of writers which only access a frozen snapshot of the results (e.g. a shared pointer to copies
+ * of the larvae captured by the writer functions), thus the caller can continue (with the next tracking job or in
+ * the gui) as soon as the job is enqueued. Jobs and their writers are processed in order (a writer may use
+ * Parallel::parallelFor internally).
+ * The completion and the failed files of every job are reported by jobFinished and by the log.
+ */
+class PersistenceQueue : public QObject
+{
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief The Writer struct writes one result file
+     */
+    struct Writer
+    {
+        /**
+         * @brief path of the written file (used in the report)
+         */
+        QString path;
+        
+        /**
+         * @brief write writes the file and returns false on failure (exceptions are reported as failure)
+         */
+        std::function<bool()> write;
+    };
+    
+    explicit PersistenceQueue(QObject* parent = nullptr);
+    
+    /**
+     * @brief ~PersistenceQueue finishes all enqueued jobs
+     */
+    ~PersistenceQueue();
+    
+    /**
+     * @brief enqueue appends a job; the writers must not refer to data which is modified after this call
+     * @param name name of the job in the report
+     */
+    void enqueue(QString const& name, std::vector<Writer> writers);
+    
+    /**
+     * @brief waitForFinished blocks until all enqueued jobs are finished
+     */
+    void waitForFinished();
+    
+    /**
+     * @brief isIdle returns true if no job is pending or running
+     */
+    bool isIdle() const;
+    
+signals:
+    /**
+     * @brief jobFinished is emitted by the background thread after all writers of a job finished
+     * @param failedPaths paths of the files which could not be written
+     */
+    void jobFinished(QString name, QStringList failedPaths);
+    
+    void sendLogMessage(QString msg, LOGLEVEL);
+    
+private:
+    struct Job
+    {
+        QString name;
+        std::vector<Writer> writers;
+    };
+    
+    void run();
+    void process(Job& job);
+    
+    mutable std::mutex          mMutex;
+    std::condition_variable     mJobAvailable;
+    std::condition_variable     mJobsFinished;
+    std::deque<Job>             mJobs;
+    bool                        mIsRunningJob;
+    bool                        mStop;
+    std::thread                 mThread;
+};
+
+#endif // PERSISTENCEQUEUE_HPP
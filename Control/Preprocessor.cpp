@@ -102,7 +102,7 @@ void Preprocessor::filterByFeatures(cv::Mat const & img,
 	biggerContoursDst.clear();
 
 	// iterate over all contours
-	for (const contour_t c : contoursSrc)
+	for (contour_t const& c : contoursSrc)
 	{
 		// calculate the current size of the contour area
 		double current_size = cv::contourArea(c);
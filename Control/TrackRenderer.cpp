@@ -0,0 +1,283 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "TrackRenderer.hpp"
+
+#include <sstream>
+
+#include <QTime>
+
+#include "Configuration/TrackerConfig.hpp"
+#include "Preprocessor.hpp"
+#include "Utility/ParallelFor.hpp"
+
+namespace
+{
+    /**
+     * @brief The Label struct holds the id of a track and where it is drawn in the overview image
+     */
+    struct Label
+    {
+        std::string text;
+        cv::Point position;
+        cv::Scalar color;
+    };
+    
+    /**
+     * @brief getGoText returns the go/stop label of the live preview (empty if the go phase is unknown)
+     */
+    std::string getGoText(Larva::ValuesType const& values)
+    {
+        if (values.goPhase == 1)
+        {
+            return "go";
+        }
+        if (values.goPhase == 0)
+        {
+            if (values.isLeftBended)
+            {
+                return "stop:left";
+            }
+            if (values.isRightBended)
+            {
+                return "stop:right";
+            }
+            return "stop";
+        }
+        return "";
+    }
+}
+
+TrackRenderer::TrackRenderer()
+{
+}
+
+void TrackRenderer::drawOverviews(const cv::Size &imageSize,
+                                  const std::vector<Larva> &larvae,
+                                  cv::Mat &trackImg,
+                                  cv::Mat &trackImgNoNumbers)
+{
+    trackImgNoNumbers = cv::Mat::zeros(imageSize, CV_8UC3);
+    
+    std::vector<Label> labels;
+    labels.reserve(larvae.size());
+    
+    qsrand(QTime::currentTime().msec());
+    
+    // a single traversal draws the lines of both images; the ids are added afterwards
+    for (Larva const& larva : larvae)
+    {
+        // calculate random color
+        int b = qrand() % 256;
+        int g = qrand() % 256;
+        int r = qrand() % 256;
+        cv::Scalar color(b, g, r);
+        
+        size_t const midIndex = larva.getSpineMidPointIndex();
+        bool hasLabel = false;
+        
+        for (Larva::ParameterMap::const_iterator it = larva.parameters.begin(); it != larva.parameters.end(); ++it)
+        {
+            size_t const spineSize = larva.parameters.getSpineSize(*it);
+            if (spineSize <= midIndex)
+            {
+                continue;
+            }
+            
+            cv::Point const midPoint = larva.parameters.getSpinePoint(*it, midIndex);
+            if (!hasLabel)
+            {
+                std::stringstream ss;
+                ss << larva.getID();
+                Label label = {ss.str(), midPoint, color};
+                labels.push_back(label);
+                hasLabel = true;
+            }
+            
+            cv::line(trackImgNoNumbers, larva.parameters.getSpinePoint(*it, 0), midPoint, color, 2);
+            cv::line(trackImgNoNumbers, midPoint, larva.parameters.getSpinePoint(*it, spineSize - 1), color, 2);
+        }
+    }
+    
+    trackImg = trackImgNoNumbers.clone();
+    for (Label const& label : labels)
+    {
+        cv::putText(trackImg, label.text, label.position, CV_FONT_HERSHEY_PLAIN, 2, label.color, 1);
+    }
+}
+
+bool TrackRenderer::writeOverviews(const cv::Size &imageSize,
+                                   const std::vector<Larva> &larvae,
+                                   const std::string &trackImgPath,
+                                   const std::string &trackImgNoNumbersPath)
+{
+    cv::Mat trackImg;
+    cv::Mat trackImgNoNumbers;
+    TrackRenderer::drawOverviews(imageSize, larvae, trackImg, trackImgNoNumbers);
+    
+    bool success = cv::imwrite(trackImgPath, trackImg);
+    success &= cv::imwrite(trackImgNoNumbersPath, trackImgNoNumbers);
+    return success;
+}
+
+void TrackRenderer::drawAnnotations(cv::Mat &img, const std::vector<const Larva *> &larvae, const unsigned int timePoint)
+{
+    Larva::ValuesType values;
+    for (Larva const* larva : larvae)
+    {
+        if (!larva->getValuesAt(timePoint, values) || values.spine.empty())
+        {
+            continue;
+        }
+        
+        FIMTypes::spine_t const& spine = values.spine;
+        cv::Scalar color;
+        if (values.isCoiled)
+        {
+            color = cv::Scalar(100, 0, 180);
+        }
+        else
+        {
+            color = cv::Scalar(0, 255, 255);
+        }
+        
+        for (auto const& spinePoint : spine)
+        {
+            cv::circle(img, spinePoint, 2, color, 2);
+        }
+        cv::circle(img, spine.front(), 3, cv::Scalar(0, 0, 255), 3);
+        cv::circle(img, spine.back(), 3, cv::Scalar(255, 0, 0), 3);
+        
+        std::stringstream ss;
+        ss << larva->getID();
+        ss << ":" << getGoText(values);
+        cv::putText(img, ss.str(), spine.front(), cv::FONT_HERSHEY_PLAIN, 2, cv::Scalar(255, 255, 255), 2);
+    }
+}
+
+void TrackRenderer::drawContours(const cv::Mat &img, const Backgroundsubtractor &bs, cv::Mat &dst)
+{
+    FIMTypes::contours_t contours;
+    FIMTypes::contours_t collidedContours;
+    Preprocessor::preprocessTracking(img,
+                                     contours,
+                                     collidedContours,
+                                     GeneralParameters::iGrayThreshold,
+                                     GeneralParameters::iMinLarvaeArea,
+                                     GeneralParameters::iMaxLarvaeArea,
+                                     GeneralParameters::iValleyThreshold,
+                                     bs,
+                                     false);
+    
+    cv::drawContours(dst, contours, -1, cv::Scalar(130, 200, 80), 3);
+    cv::drawContours(dst, collidedContours, -1, cv::Scalar(0, 0, 255), 8);
+}
+
+bool TrackRenderer::writeOverlayVideo(const std::string &path,
+                                      const std::vector<std::string> &imgPaths,
+                                      const std::vector<Larva> &larvae,
+                                      const unsigned int nFrames,
+                                      const cv::Size &frameSize,
+                                      const cv::Mat &roiMask,
+                                      const Backgroundsubtractor *bs,
+                                      const double fps)
+{
+    size_t const frameCount = std::min<size_t>(nFrames, imgPaths.size());
+    if (frameCount == 0 || frameSize.area() == 0)
+    {
+        return false;
+    }
+    
+    cv::VideoWriter writer(path, CV_FOURCC('M', 'J', 'P', 'G'), fps > 0 ? fps : 10.0, frameSize, true);
+    if (!writer.isOpened())
+    {
+        return false;
+    }
+    
+    // larvae of every frame in a single traversal of the tracks (instead of a lookup per frame and larva)
+    std::vector<std::vector<Larva const*> > frameLarvae(frameCount);
+    for (Larva const& larva : larvae)
+    {
+        for (Larva::ParameterMap::const_iterator it = larva.parameters.begin(); it != larva.parameters.end(); ++it)
+        {
+            if (*it < frameCount)
+            {
+                frameLarvae[*it].push_back(&larva);
+            }
+        }
+    }
+    
+    // frames are rendered in parallel batches (bounding the memory) and written in order
+    size_t const batchSize = 2 * Parallel::numberOfThreads();
+    std::vector<cv::Mat> frames(batchSize);
+    
+    for (size_t batchBegin = 0; batchBegin < frameCount; batchBegin += batchSize)
+    {
+        size_t const batchEnd = std::min(batchBegin + batchSize, frameCount);
+        
+        Parallel::parallelFor(batchEnd - batchBegin, [&](size_t i)
+        {
+            size_t const t = batchBegin + i;
+            cv::Mat img = cv::imread(imgPaths.at(t), CV_LOAD_IMAGE_GRAYSCALE);
+            if (img.empty())
+            {
+                img = cv::Mat::zeros(frameSize, CV_8UC1);
+            }
+            else if (img.size() != frameSize)
+            {
+                cv::resize(img, img, frameSize);
+            }
+            
+            // only the regions of interest are tracked, thus only their contours are drawn
+            if (!roiMask.empty())
+            {
+                img &= roiMask;
+            }
+            
+            cv::Mat& frame = frames[i];
+            cv::cvtColor(img, frame, CV_GRAY2BGR);
+            if (bs != nullptr)
+            {
+                TrackRenderer::drawContours(img, *bs, frame);
+            }
+            TrackRenderer::drawAnnotations(frame, frameLarvae[t], static_cast<unsigned int>(t));
+        });
+        
+        for (size_t i = 0; i < batchEnd - batchBegin; ++i)
+        {
+            writer << frames[i];
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef TRACKRENDERER_HPP
+#define TRACKRENDERER_HPP
+
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Data/Larva.hpp"
+#include "Backgroundsubtractor.hpp"
+
+/**
+ * @brief The TrackRenderer class draws the tracking results: the track overview images and an annotated overlay video
+ *
+ * Both overview images (with and without the larva ids) are drawn in a single traversal of the tracks using the
+ * head, mid and tail points stored in the larvae. The overlay video shows the same annotations as the live preview
+ * while tracking; its frames are rendered in parallel and written in order.
+ */
+class TrackRenderer
+{
+public:
+    /**
+     * @brief drawOverviews draws the head-mid-tail lines of all time points of all larvae (one random color per larva)
+     * @param imageSize size of the tracked images
+     * @param trackImg resultant image with the larva ids
+     * @param trackImgNoNumbers resultant image without the larva ids
+     */
+    static void drawOverviews(cv::Size const& imageSize,
+                              std::vector<Larva> const& larvae,
+                              cv::Mat& trackImg,
+                              cv::Mat& trackImgNoNumbers);
+    
+    /**
+     * @brief writeOverviews draws the overview images (see drawOverviews) and writes them to the given paths
+     * @return false if an image could not be written
+     */
+    static bool writeOverviews(cv::Size const& imageSize,
+                               std::vector<Larva> const& larvae,
+                               std::string const& trackImgPath,
+                               std::string const& trackImgNoNumbersPath);
+    
+    /**
+     * @brief drawAnnotations draws the spines, head and tail points, ids and go/stop labels of the given larvae at timePoint
+     *        (the annotations of the live preview)
+     */
+    static void drawAnnotations(cv::Mat& img, std::vector<Larva const*> const& larvae, unsigned int const timePoint);
+    
+    /**
+     * @brief drawContours draws the accepted and the collided contours found in img (grayscale) into dst as shown
+     *        by the live preview
+     */
+    static void drawContours(cv::Mat const& img, Backgroundsubtractor const& bs, cv::Mat& dst);
+    
+    /**
+     * @brief writeOverlayVideo writes the first nFrames images annotated with the tracking results as a motion jpeg video
+     * @param frameSize size of the tracked images (i.e. of the background image)
+     * @param roiMask mask of the regions of interest applied to every image as by the tracker (empty if there are none)
+     * @param bs background used to redetect the contours of each frame (nullptr to omit the contours)
+     * @param fps frame rate of the video
+     * @return false if the video could not be opened
+     */
+    static bool writeOverlayVideo(std::string const& path,
+                                  std::vector<std::string> const& imgPaths,
+                                  std::vector<Larva> const& larvae,
+                                  unsigned int const nFrames,
+                                  cv::Size const& frameSize,
+                                  cv::Mat const& roiMask,
+                                  Backgroundsubtractor const* bs,
+                                  double const fps);
+    
+private:
+    TrackRenderer();
+};
+
+#endif // TRACKRENDERER_HPP
@@ -34,13 +34,51 @@
 #include "Tracker.hpp"
 
 #include <ctime>
+#include <algorithm>
+#include <memory>
 
 using namespace cv;
 using std::vector;
 using std::string;
 using std::map;
 
-Tracker::Tracker(QObject* parent) : QObject(parent), _stopTracking(false)
+// minimal gating factor (times the spine length) of the hungarian and sparse assignment. Without motion prediction
+// the gate is additionally widened to the footprints of both larvae (see buildGatingIndex)
+static const double minHungarianGatingFactor = 2.0;
+
+// minimal number of cost matrix cells (summed over all components) to solve the assignment components in parallel
+static const size_t minParallelAssignmentCells = 4096;
+
+namespace
+{
+    /**
+     * @brief The JobResults struct is the frozen snapshot of the results of a tracking job written by the persistence queue
+     */
+    struct JobResults
+    {
+        std::vector<Larva> larvae;
+        GroupMetrics groupMetrics;
+        HeatMapAccumulator heatMaps;
+        std::vector<std::string> imgPaths;
+        unsigned int movieLength;
+        bool useUndist;
+        std::string sceneYML;
+        cv::Mat backgroundImage;
+        cv::Mat roiMask;
+    };
+
+    template<class WriteFunc>
+    void addWriter(std::vector<PersistenceQueue::Writer>& writers, QString const& path, WriteFunc write)
+    {
+        std::string const stdPath = QtOpencvCore::qstr2str(path);
+        PersistenceQueue::Writer writer;
+        writer.path = path;
+        writer.write = [write, stdPath]() {return write(stdPath);};
+        writers.push_back(writer);
+    }
+}
+
+Tracker::Tracker(QObject* parent) : QObject(parent), _maxGatingRadius(0.0), _stopTracking(false)
 {
     qRegisterMetaType<LOGLEVEL>("LOGLEVEL");
     connect(this, SIGNAL(logMessageSignal(QString, LOGLEVEL)), Logger::getInstance(), SLOT(handleLogMessage(QString, LOGLEVEL)));
@@ -89,17 +127,69 @@ void Tracker::startTrackingSlot(const std::vector<std::vector<std::string>>& mul
 
         _curRawLarvae.clear();
         _larvaeContainer.removeAllLarvae();
+        _curLabels.clear();
+        _lastLabels.clear();
+        _lastLabelLarvaIDs.clear();
+        // the online post-processing needs the spines during tracking
+        _larvaeContainer.setOnlinePostProcessing(!LarvaeExtractionParameters::bUseLazySpineCalculation);
+
+        if (GeneralParameters::bStreamCSVOutput)
+        {
+            QString streamPath = absPath;
+            streamPath.append("/table_stream");
+            streamPath.append("_");
+            streamPath.append(strDate);
+            streamPath.append("_");
+            streamPath.append(strTime);
+            streamPath.append(".csv");
+            // the raw larvae use 9 spine points unless the extraction parameters are customized (see RawLarva)
+            unsigned int const nSpinePoints = LarvaeExtractionParameters::bUseDefault ? 9 : LarvaeExtractionParameters::iNumerOfSpinePoints;
+            if (!_csvStream.open(QtOpencvCore::qstr2str(streamPath), nSpinePoints))
+            {
+                emit logMessageSignal(QString("Could not open ").append(streamPath), WARNING);
+            }
+        }
 
         Backgroundsubtractor bs(imgPaths, undist);
+        if (GeneralParameters::bSaveHeatMaps)
+        {
+            _larvaeContainer.enableHeatMaps(bs.getBackgroundImage().size(), GeneralParameters::iHeatMapBinSize);
+        }
 
         uint numProcessed = track(imgPaths, bs, undist, ROIContainer);
 
         emit logMessageSignal(QString("Postprocessing and Storage of Tracking Results"), INFO);
 
         /****** Post-Tracking Steps ******/
-        _larvaeContainer.interplolateLarvae();
+        if (LarvaeExtractionParameters::bUseLazySpineCalculation && LarvaeExtractionParameters::iMinTrackLengthForSpineCalculation > 0)
+        {
+            _larvaeContainer.removeShortTracks(LarvaeExtractionParameters::iMinTrackLengthForSpineCalculation);
+        }
+        if (_larvaeContainer.usesOnlinePostProcessing())
+        {
+            _larvaeContainer.finishOnlinePostProcessing();
+        }
+        else
+        {
+            _larvaeContainer.calcDeferredSpines();
+            _larvaeContainer.interplolateLarvae();
+        }
+        _csvStream.finish(_larvaeContainer);
 
         /********* Save Results *********/
+        // the results are moved into a frozen snapshot, which is written by the persistence queue while
+        // the next job is tracked (the scene is serialized now since the ROIs belong to the gui)
+        std::shared_ptr<JobResults> results = std::make_shared<JobResults>();
+        _larvaeContainer.takeResults(results->larvae, results->groupMetrics, results->heatMaps);
+        results->imgPaths = imgPaths;
+        results->movieLength = numProcessed;
+        results->useUndist = undist.isReady();
+        results->sceneYML = OutputGenerator::serializeSceneYML(ROIContainer, nullptr);
+        results->backgroundImage = bs.getBackgroundImage();
+        results->roiMask = createROIMask(results->backgroundImage.size(), ROIContainer);
+
+        std::vector<PersistenceQueue::Writer> writers;
+
         QString tablePath = absPath;
         tablePath.append("/table");
         tablePath.append("_");
@@ -107,7 +197,10 @@ void Tracker::startTrackingSlot(const std::vector<std::vector<std::string>>& mul
         tablePath.append("_");
         tablePath.append(strTime);
         tablePath.append(".csv");
-        OutputGenerator::writeCSVFile(QtOpencvCore::qstr2str(tablePath), _larvaeContainer.getAllLarvae(), numProcessed);
+        addWriter(writers, tablePath, [results](std::string const& path)
+        {
+            return OutputGenerator::writeCSVFile(path, results->larvae, results->movieLength, std::vector<std::string>());
+        });
 
         QString ymlPath = absPath;
         ymlPath.append("/output");
@@ -116,7 +209,13 @@ void Tracker::startTrackingSlot(const std::vector<std::vector<std::string>>& mul
         ymlPath.append("_");
         ymlPath.append(strTime);
         ymlPath.append(".yml");
-        OutputGenerator::writeYMLFile(QtOpencvCore::qstr2str(ymlPath), _larvaeContainer.getAllLarvae(), imgPaths, undist.isReady(), ROIContainer);
+        // the binary results file is loaded by the results viewer instead of the (slow to parse) yml file. The viewer
+        // only uses it if it is not older than the yml file, thus it is written after the yml file is finished
+        addWriter(writers, ymlPath, [results](std::string const& path)
+        {
+            return OutputGenerator::writeYMLFile(path, results->larvae, results->imgPaths, results->useUndist, results->sceneYML)
+                    && OutputGenerator::writeBinaryResultsFile(InputGenerator::getBinaryResultsPath(path), results->larvae, results->imgPaths, results->useUndist, results->sceneYML);
+        });
 
         QString trackImgPath = absPath;
         trackImgPath.append("/tracks");
@@ -125,7 +224,6 @@ void Tracker::startTrackingSlot(const std::vector<std::vector<std::string>>& mul
         trackImgPath.append("_");
         trackImgPath.append(strTime);
         trackImgPath.append(".tif");
-        OutputGenerator::drawTrackingResults(QtOpencvCore::qstr2str(trackImgPath), imgPaths, _larvaeContainer.getAllLarvae());
 
         QString trackImgNoNumbersPath = absPath;
         trackImgNoNumbersPath.append("/tracksNoNumbers");;
@@ -134,17 +232,81 @@ void Tracker::startTrackingSlot(const std::vector<std::vector<std::string>>& mul
         trackImgNoNumbersPath.append("_");
         trackImgNoNumbersPath.append(strTime);
         trackImgNoNumbersPath.append(".tif");
-        OutputGenerator::drawTrackingResultsNoNumbers(QtOpencvCore::qstr2str(trackImgNoNumbersPath), imgPaths, _larvaeContainer.getAllLarvae());
+        // both overview images are drawn in a single pass over the tracks
+        std::string const trackImgNoNumbersStdPath = QtOpencvCore::qstr2str(trackImgNoNumbersPath);
+        addWriter(writers, trackImgPath, [results, trackImgNoNumbersStdPath](std::string const& path)
+        {
+            return OutputGenerator::drawTrackingResults(path, trackImgNoNumbersStdPath, results->backgroundImage.size(), results->larvae);
+        });
 
-		// save distances between all tracked objects in an own file
+        if (GeneralParameters::bSaveOverlayVideo)
+        {
+            QString videoPath = absPath;
+            videoPath.append("/overlay");
+            videoPath.append("_");
+            videoPath.append(strDate);
+            videoPath.append("_");
+            videoPath.append(strTime);
+            videoPath.append(".avi");
+            addWriter(writers, videoPath, [results](std::string const& path)
+            {
+                Backgroundsubtractor background(results->backgroundImage);
+                return OutputGenerator::writeOverlayVideo(path, results->imgPaths, results->larvae, results->movieLength, results->backgroundImage.size(), results->roiMask, &background);
+            });
+        }
+
+		// save distances between the tracked objects in an own file
+		DistanceWriter::Options const distanceOptions = DistanceWriter::getConfiguredOptions();
 		QString distanceTablePath = absPath;
 		distanceTablePath.append("/distances");
 		distanceTablePath.append("_");
 		distanceTablePath.append(strDate);
 		distanceTablePath.append("_");
 		distanceTablePath.append(strTime);
-		distanceTablePath.append(".csv");
-		OutputGenerator::writeDistancesCSVFile(QtOpencvCore::qstr2str(distanceTablePath), _larvaeContainer.getAllLarvae(), numProcessed);
+		distanceTablePath.append(DistanceWriter::getFileExtension(distanceOptions.format));
+		addWriter(writers, distanceTablePath, [results, distanceOptions](std::string const& path)
+		{
+			return OutputGenerator::writeDistancesFile(path, results->larvae, results->movieLength, distanceOptions);
+		});
+
+        // group behaviour values per frame (the values per larva are part of the tables above)
+        if (FeatureParameters::isEnabled(FeatureParameters::GROUP_BEHAVIOUR))
+        {
+            QString groupTablePath = absPath;
+            groupTablePath.append("/group");
+            groupTablePath.append("_");
+            groupTablePath.append(strDate);
+            groupTablePath.append("_");
+            groupTablePath.append(strTime);
+            groupTablePath.append(".csv");
+            addWriter(writers, groupTablePath, [results](std::string const& path)
+            {
+                return results->groupMetrics.writeCSVFile(path);
+            });
+        }
+
+        if (results->heatMaps.isEnabled())
+        {
+            QString heatMapPath = absPath;
+            heatMapPath.append("/heatmaps");
+            heatMapPath.append("_");
+            heatMapPath.append(strDate);
+            heatMapPath.append("_");
+            heatMapPath.append(strTime);
+            addWriter(writers, heatMapPath, [results](std::string const& path)
+            {
+                return results->heatMaps.write(path, results->larvae);
+            });
+        }
+
+        _persistenceQueue.enqueue(absPath, std::move(writers));
+    }
+
+    // all files have to be written when the tracking is reported as done
+    if (!_persistenceQueue.isIdle())
+    {
+        emit logMessageSignal(QString("Waiting for the results to be saved"), INFO);
+        _persistenceQueue.waitForFinished();
     }
 
     emit trackingDoneSignal();
@@ -158,6 +320,34 @@ void Tracker::stopTrackingSlot()
 }
 
 
+cv::Mat Tracker::createROIMask(const cv::Size& imageSize, const RegionOfInterestContainer* ROIContainer)
+{
+    cv::Mat mask;
+    if (ROIContainer == nullptr)
+    {
+        return mask;
+    }
+
+    mask = cv::Mat::zeros(imageSize, CV_8UC1);
+
+    for (int i = 0; i < ROIContainer->getRegionOfInterests().size(); ++i)
+    {
+        switch (ROIContainer->getRegionOfInterests().at(i).getType())
+        {
+            case RegionOfInterest::RECTANGLE:
+                mask(QtOpencvCore::qRect2Rect(ROIContainer->getRegionOfInterests().at(i).getBoundingBox())) = 255;
+                break;
+            case RegionOfInterest::ELLIPSE:
+                cv::Mat ellipseMask = cv::Mat::zeros(mask.size(), mask.type());
+                cv::ellipse(ellipseMask, QtOpencvCore::qRect2RotatedRect(ROIContainer->getRegionOfInterests().at(i).getBoundingBox()), cv::Scalar(255, 255, 255), CV_FILLED);
+                mask |= ellipseMask;
+                break;
+        }
+    }
+
+    return mask;
+}
+
 uint Tracker::track(const std::vector<std::string>& imgPaths,
                     const Backgroundsubtractor& bs,
                     const Undistorter& undist,
@@ -167,25 +357,9 @@ uint Tracker::track(const std::vector<std::string>& imgPaths,
 
     /***** Create ROI Mask ******/
     cv::Mat mask;
-    if (ROIContainer != nullptr && imgPaths.size() > 0)
+    if (imgPaths.size() > 0)
     {
-        cv::Mat firstImg = imread(imgPaths.at(0), CV_LOAD_IMAGE_GRAYSCALE);
-        mask = cv::Mat::zeros(firstImg.size(), firstImg.type());
-
-        for (int i = 0; i < ROIContainer->getRegionOfInterests().size(); ++i)
-        {
-            switch (ROIContainer->getRegionOfInterests().at(i).getType())
-            {
-                case RegionOfInterest::RECTANGLE:
-                    mask(QtOpencvCore::qRect2Rect(ROIContainer->getRegionOfInterests().at(i).getBoundingBox())) = 255;
-                    break;
-                case RegionOfInterest::ELLIPSE:
-                    cv::Mat ellipseMask = cv::Mat::zeros(mask.size(), mask.type());
-                    cv::ellipse(ellipseMask, QtOpencvCore::qRect2RotatedRect(ROIContainer->getRegionOfInterests().at(i).getBoundingBox()), cv::Scalar(255, 255, 255), CV_FILLED);
-                    mask |= ellipseMask;
-                    break;
-            }
-        }
+        mask = createROIMask(bs.getBackgroundImage().size(), ROIContainer);
     }
 
     /******* iterate over all images and track larvae ********/
@@ -204,7 +378,7 @@ uint Tracker::track(const std::vector<std::string>& imgPaths,
         emit logMessageSignal(QString("Process Image: ").append(QtOpencvCore::str2qstr(path)), INFO);
 
         cv::Mat img = imread(path, CV_LOAD_IMAGE_GRAYSCALE);
-        if (ROIContainer != nullptr)
+        if (!mask.empty())
         {
             img &= mask;
         }
@@ -218,6 +392,9 @@ uint Tracker::track(const std::vector<std::string>& imgPaths,
 
         extractRawLarvae(img, bs, &previewImg, false);
 
+        // features of the larvae in the previous frame used by the assignment
+        _larvaeContainer.getTrackSnapshot(timePoint - 1, _lastTracks);
+
         // assignment task
         switch (LarvaeExtractionParameters::AssignmentParameters::eAssignmentMethod)
         {
@@ -227,74 +404,28 @@ uint Tracker::track(const std::vector<std::string>& imgPaths,
             case LarvaeExtractionParameters::AssignmentParameters::GREEDY:
                 assignByGreedy(timePoint);
                 break;
+            case LarvaeExtractionParameters::AssignmentParameters::SPARSE_LAP:
+                assignBySparseLAP(timePoint);
+                break;
         }
 
         // delete latest contour etc. for saving RAM
         _larvaeContainer.processUntrackedLarvae(timePoint);
+        _larvaeContainer.updateGroupMetrics(timePoint);
+        _larvaeContainer.updateOnlinePostProcessing(timePoint);
+        _csvStream.append(_larvaeContainer, timePoint);
+
+        // the footprints of the current raw larvae are the footprints of the larvae in the next frame
+        std::swap(_lastLabels, _curLabels);
+        std::swap(_lastLabelLarvaIDs, _curLabelLarvaIDs);
 
         // show tracking result for current timepoint
         if (_showTrackingProgress)
         {
-            std::vector<Larva> larvae = _larvaeContainer.getAllLarvae();
-            for (auto const& l : larvae)
-            {
-                FIMTypes::spine_t spine;
-                string goText = "";
-                std::stringstream ss;
-                if (l.getSpineAt(timePoint, spine))
-                {
-                    bool isCoiled;
-                    l.getIsCoiledIndicatorAt(timePoint, isCoiled);
-                    Scalar color;
-                    if (isCoiled)
-                    {
-                        color = Scalar(100, 0, 180);
-                    }
-                    else
-                    {
-                        color = Scalar(0, 255, 255);
-                    }
-
-                    for (auto const& spine_point : spine)
-                    {
-                        circle(previewImg, spine_point, 2, color, 2);
-                    }
-                    circle(previewImg, spine.at(0), 3, Scalar(0, 0, 255), 3);
-                    circle(previewImg, spine.at(spine.size() - 1), 3, Scalar(255, 0, 0), 3);
-
-                    int goPhaseIndicator;
-                    if (l.getGoPhaseIndicatorAt(timePoint, goPhaseIndicator))
-                    {
-                        if (goPhaseIndicator == 1)
-                        {
-                            goText = "go";
-                        }
-                        else if (goPhaseIndicator == 0)
-                        {
-                            bool leftBended = false;
-                            bool rightBended = false;
-
-                            l.getLeftBendingIndicatorAt(timePoint, leftBended);
-                            l.getRightBendingIndicatorAt(timePoint, rightBended);
-                            if (leftBended)
-                            {
-                                goText = "stop:left";
-                            }
-                            else if (rightBended)
-                            {
-                                goText = "stop:right";
-                            }
-                            else
-                            {
-                                goText = "stop";
-                            }
-                        }
-                    }
-                    ss << l.getID();
-                    ss << ":" << goText;
-                    putText(previewImg, ss.str(), spine.at(0), cv::FONT_HERSHEY_PLAIN, 2, Scalar(255, 255, 255), 2);
-                }
-            }
+            // only the larvae of the current time point (read-only, no copies of the tracks)
+            std::vector<Larva const*> larvae;
+            _larvaeContainer.getLarvaeAt(timePoint, larvae);
+            TrackRenderer::drawAnnotations(previewImg, larvae, timePoint);
             emit previewTrackingImageSignal(previewImg);
         }
 
@@ -330,46 +461,195 @@ void Tracker::extractRawLarvae(Mat const& img, Backgroundsubtractor const& bs, M
     _curRawLarvae.clear();
     _curRawLarvae.reserve(contours.size());
 
-    for (auto const& c : contours)
+    _curLabels.reset(img.size());
+    for (auto& c : contours)
     {
-        RawLarva rl(c, img);
-        _curRawLarvae.push_back(rl);
+        _curLabels.addContour(c);
+        _curRawLarvae.emplace_back(std::move(c), img);
+    }
+    _curLabelLarvaIDs.assign(_curRawLarvae.size(), 0);
+}
+
+void Tracker::insertRawLarva(size_t const rawLarvaIndex, unsigned int const larvaID, unsigned int const timePoint)
+{
+    _curLabelLarvaIDs.at(rawLarvaIndex) = larvaID;
+    _larvaeContainer.insertRawLarva(larvaID, timePoint, std::move(_curRawLarvae.at(rawLarvaIndex)));
+}
+
+void Tracker::createNewLarva(size_t const rawLarvaIndex, unsigned int const timePoint)
+{
+    _curLabelLarvaIDs.at(rawLarvaIndex) = _larvaID;
+    _larvaeContainer.createNewLarva(timePoint, std::move(_curRawLarvae.at(rawLarvaIndex)), _larvaID);
+    ++_larvaID;
+}
+
+void Tracker::calcOverlaps(std::vector<int> const& larvaeIDs, cv::Mat& overlaps) const
+{
+    cv::Mat labelOverlaps;
+    _curLabels.calcOverlaps(_lastLabels, labelOverlaps);
+
+    std::map<unsigned int, int> lastLabelOfLarva;
+    for (size_t l = 0; l < _lastLabelLarvaIDs.size(); ++l)
+    {
+        lastLabelOfLarva[_lastLabelLarvaIDs.at(l)] = static_cast<int>(l);
+    }
+
+    overlaps = cv::Mat::zeros(_curRawLarvae.size(), larvaeIDs.size(), CV_64F);
+    if (overlaps.empty())
+    {
+        return;
+    }
+
+    for (size_t j = 0; j < larvaeIDs.size(); ++j)
+    {
+        auto it = lastLabelOfLarva.find(static_cast<unsigned int>(larvaeIDs.at(j)));
+        if (it != lastLabelOfLarva.end())
+        {
+            labelOverlaps.col(it->second).copyTo(overlaps.col(static_cast<int>(j)));
+        }
+    }
+}
+
+cv::Point Tracker::getAssignmentPosition(RawLarva const& rawLarva) const
+{
+    if (LarvaeExtractionParameters::AssignmentParameters::eCostMeasure == LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT)
+    {
+        return rawLarva.getMidPoint();
+    }
+    return rawLarva.getMomentum();
+}
+
+double Tracker::getFootprintRadius(RawLarva const& rawLarva) const
+{
+    cv::Point const p = getAssignmentPosition(rawLarva);
+    double radius = 0.0;
+    for (auto const& c : rawLarva.getContour())
+    {
+        radius = std::max(radius, Calc::eucledianDist(p, c));
+    }
+    return radius;
+}
+
+bool Tracker::usesMotionPrediction() const
+{
+    return LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction
+            && LarvaeExtractionParameters::AssignmentParameters::eCostMeasure != LarvaeExtractionParameters::AssignmentParameters::OVERLAP;
+}
+
+void Tracker::buildGatingIndex(double gatingFactor, bool footprintGate)
+{
+    std::vector<cv::Point> positions;
+    positions.reserve(_lastTracks.size());
+    _gatingColumns.clear();
+    _gatingRadii.clear();
+    _gatingCostScales.clear();
+
+    bool const useMidPoint = (LarvaeExtractionParameters::AssignmentParameters::eCostMeasure == LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT);
+    double maxRadius = 0.0;
+
+    for (size_t j = 0; j < _lastTracks.size(); ++j)
+    {
+        // larvae without valid position are never assigned (i.e. cost is maximal)
+        if (useMidPoint && !_lastTracks.hasMidPoint.at(j))
+        {
+            continue;
+        }
+
+        if (useMidPoint)
+        {
+            positions.push_back(cv::Point(static_cast<int>(_lastTracks.midPointX.at(j)), static_cast<int>(_lastTracks.midPointY.at(j))));
+        }
+        else
+        {
+            positions.push_back(cv::Point(static_cast<int>(_lastTracks.momentumX.at(j)), static_cast<int>(_lastTracks.momentumY.at(j))));
+        }
+
+        _gatingColumns.push_back(static_cast<int>(j));
+        _gatingRadii.push_back(gatingFactor * _lastTracks.spineLength.at(j));
+        _gatingCostScales.push_back(1.0);
+
+        // all points of the larva checked against the contour of a raw larva lie within the footprint radius
+        // around the momentum (plus the offset of the mid point and one pixel for the rounding of the position)
+        if (footprintGate)
+        {
+            double footprint = _lastTracks.footprintRadius.at(j) + 1.0;
+            if (useMidPoint)
+            {
+                footprint += std::sqrt(std::pow(_lastTracks.midPointX.at(j) - _lastTracks.momentumX.at(j), 2)
+                                       + std::pow(_lastTracks.midPointY.at(j) - _lastTracks.momentumY.at(j), 2));
+            }
+            _gatingRadii.back() = std::max(_gatingRadii.back(), footprint);
+        }
+
+        // the gate is centered at the predicted position and limited by the uncertainty of the prediction
+        double const stdDev = _lastTracks.predictionStdDev.at(j);
+        if (usesMotionPrediction() && stdDev > 0)
+        {
+            positions.back() += cv::Point(cvRound(_lastTracks.predictedShiftX.at(j)), cvRound(_lastTracks.predictedShiftY.at(j)));
+            _gatingRadii.back() = std::min(_gatingRadii.back(), LarvaeExtractionParameters::AssignmentParameters::dMotionGatingSigma * stdDev);
+            _gatingCostScales.back() = stdDev;
+        }
+
+        maxRadius = std::max(maxRadius, _gatingRadii.back());
+    }
+
+    _maxGatingRadius = maxRadius;
+    _gatingIndex.build(positions, maxRadius);
+}
+
+void Tracker::getGatedCandidates(cv::Point const& p, std::vector<std::pair<int, double> >& candidates, double extraRadius) const
+{
+    candidates.clear();
 
+    std::vector<int> indices;
+    std::vector<float> squaredDistances;
+    _gatingIndex.query(p, _maxGatingRadius + extraRadius, indices, squaredDistances);
+
+    for (size_t n = 0; n < indices.size(); ++n)
+    {
+        // squared distances of integer points are exact
+        double distance = std::sqrt(static_cast<double>(squaredDistances.at(n)));
+        if (distance < _gatingRadii.at(indices.at(n)) + extraRadius)
+        {
+            candidates.push_back(std::make_pair(_gatingColumns.at(indices.at(n)), distance / _gatingCostScales.at(indices.at(n))));
+        }
     }
+
+    // the positions are indexed in column order, thus the candidates are sorted by column
+    std::sort(candidates.begin(), candidates.end());
 }
 
 void Tracker::assignByHungarian(unsigned int timePoint)
 {
     if (_larvaeContainer.isEmpty())
     {
-        for (auto const& rawLarva : _curRawLarvae)
+        for (size_t i = 0; i < _curRawLarvae.size(); ++i)
         {
-            _larvaeContainer.createNewLarva(timePoint, rawLarva, _larvaID);
-            ++_larvaID;
+            createNewLarva(i, timePoint);
         }
     }
     else
     {
-        std::vector<int> validLarvaeIDs = _larvaeContainer.getAllValidLarvaeIDS(timePoint - 1);
+        std::vector<int> validLarvaeIDs = _lastTracks.larvaIDs;
         cv::Mat costMatrix = cv::Mat::zeros(_curRawLarvae.size(), validLarvaeIDs.size(), CV_64F); // init value
 
         // if there are no detections in the last frame
         // inswert current dections as new larvae in larvaecontainer
         if (costMatrix.rows == 0 || costMatrix.cols == 0)
         {
-            for (auto const& rawLarva : _curRawLarvae)
+            for (size_t i = 0; i < _curRawLarvae.size(); ++i)
             {
-                _larvaeContainer.createNewLarva(timePoint, rawLarva, _larvaID);
-                ++_larvaID;
+                createNewLarva(i, timePoint);
             }
         }
         else
         {
 
             Algorithms::MODE optimizingMode = Algorithms::HUNGARIAN_MODE_MINIMIZE_COST;
-            contour_t lastContour, curContour;
-            cv::Point lastMomentum, curMomentum, lastMidPoint, curMidPoint;
+            std::vector<std::pair<int, double> > candidates;
 
+            // pairs which can be assigned (i.e. overlapping or within the gating radius)
+            Algorithms::BipartiteComponents components(costMatrix.rows, costMatrix.cols);
 
             switch (LarvaeExtractionParameters::AssignmentParameters::eCostMeasure)
             {
@@ -377,15 +657,15 @@ void Tracker::assignByHungarian(unsigned int timePoint)
 
                     optimizingMode = Algorithms::HUNGARIAN_MODE_MAXIMIZE_UTIL;
 
-                    for (size_t i = 0; i < _curRawLarvae.size(); ++i)
-                    {
-                        curContour = _curRawLarvae.at(i).getContour();
+                    calcOverlaps(validLarvaeIDs, costMatrix);
 
-                        for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
+                    for (int i = 0; i < costMatrix.rows; ++i)
+                    {
+                        for (int j = 0; j < costMatrix.cols; ++j)
                         {
-                            if (_larvaeContainer.getContour(validLarvaeIDs.at(j), lastContour))
+                            if (costMatrix.at<double>(i, j) > 0)
                             {
-                                costMatrix.at<double>(i, j) = Calc::calcOverlap(lastContour, curContour);
+                                components.addEdge(i, j);
                             }
                         }
                     }
@@ -393,85 +673,209 @@ void Tracker::assignByHungarian(unsigned int timePoint)
                     break;
 
                 case LarvaeExtractionParameters::AssignmentParameters::MOMENTUM:
+                case LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT:
 
                     optimizingMode = Algorithms::HUNGARIAN_MODE_MINIMIZE_COST;
 
+                    // only pairs within the gating radius are evaluated, all other pairs can not be assigned. Without
+                    // motion prediction the gate covers the footprints of both larvae, thus every pair which can pass
+                    // the point-in-contour check is evaluated
+                    costMatrix.setTo(cv::Scalar(std::numeric_limits<double>::max()));
+                    buildGatingIndex(std::max(LarvaeExtractionParameters::AssignmentParameters::dDistanceThreshold, minHungarianGatingFactor), !usesMotionPrediction());
+
                     for (size_t i = 0; i < _curRawLarvae.size(); ++i)
                     {
-                        curMomentum = _curRawLarvae.at(i).getMomentum();
+                        double const extraRadius = usesMotionPrediction() ? 0.0 : getFootprintRadius(_curRawLarvae.at(i));
+                        getGatedCandidates(getAssignmentPosition(_curRawLarvae.at(i)), candidates, extraRadius);
 
-                        for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
+                        for (auto const& c : candidates)
                         {
-                            if (_larvaeContainer.getMomentumAt(validLarvaeIDs.at(j), timePoint - 1, lastMomentum))
-                            {
-                                costMatrix.at<double>(i, j) = Calc::eucledianDist(lastMomentum, curMomentum);
-                            }
-                            else
-                            {
-                                costMatrix.at<double>(i, j) = std::numeric_limits<double>::max();
-                            }
+                            costMatrix.at<double>(static_cast<int>(i), c.first) = c.second;
+                            components.addEdge(static_cast<int>(i), c.first);
                         }
                     }
 
                     break;
+            }
 
-                case LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT:
+            // the components do not share any assignable pair, thus they are solved independently
+            components.compute();
 
-                    optimizingMode = Algorithms::HUNGARIAN_MODE_MINIMIZE_COST;
+            std::vector<int> assignedColumn(costMatrix.rows, -1);
+            std::vector<size_t> hungarianComponents;
+            size_t hungarianCells = 0;
 
-                    for (size_t i = 0; i < _curRawLarvae.size(); ++i)
+            for (size_t k = 0; k < components.getNumberOfComponents(); ++k)
+            {
+                std::vector<int> const& rows = components.getRows(k);
+                std::vector<int> const& cols = components.getCols(k);
+
+                if (cols.empty())
+                {
+                    continue;
+                }
+
+                // a single pair is assigned without solving
+                if (rows.size() == 1 && cols.size() == 1)
+                {
+                    assignedColumn.at(rows.front()) = cols.front();
+                }
+                else
+                {
+                    hungarianComponents.push_back(k);
+                    hungarianCells += rows.size() * cols.size();
+                }
+            }
+
+            auto solveComponent = [&](size_t c)
+            {
+                std::vector<int> const& rows = components.getRows(hungarianComponents.at(c));
+                std::vector<int> const& cols = components.getCols(hungarianComponents.at(c));
+
+                cv::Mat subCostMatrix(static_cast<int>(rows.size()), static_cast<int>(cols.size()), CV_64F);
+                for (size_t r = 0; r < rows.size(); ++r)
+                {
+                    for (size_t q = 0; q < cols.size(); ++q)
                     {
-                        curMidPoint = _curRawLarvae.at(i).getMidPoint();
+                        subCostMatrix.at<double>(static_cast<int>(r), static_cast<int>(q)) = costMatrix.at<double>(rows.at(r), cols.at(q));
+                    }
+                }
 
-                        for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
+                Algorithms::Hungarian hs = Algorithms::Hungarian(subCostMatrix, optimizingMode);
+                cv::Mat assigments = hs.getAssignmentAsMatrix();
+
+                // every row belongs to exactly one component, thus the components write disjoint entries
+                for (int r = 0; r < assigments.rows; ++r)
+                {
+                    for (int q = 0; q < assigments.cols; ++q)
+                    {
+                        if (assigments.at<uchar>(r, q) == 1)
                         {
-                            uint midPointIndex;
-                            if (_larvaeContainer.getSpineMidPointIndex(validLarvaeIDs.at(j), midPointIndex))
-                            {
-                                _larvaeContainer.getSpinePointAt(validLarvaeIDs.at(j), timePoint - 1, midPointIndex, lastMidPoint);
-                                costMatrix.at<double>(i, j) = Calc::eucledianDist(lastMidPoint, curMidPoint);
-                            }
-                            else
-                            {
-                                costMatrix.at<double>(i, j) = std::numeric_limits<double>::max();
-                            }
+                            assignedColumn.at(rows.at(r)) = cols.at(q);
+                            break;
                         }
                     }
+                }
+            };
 
-                    break;
+            if (hungarianComponents.size() > 1 && hungarianCells >= minParallelAssignmentCells)
+            {
+                Parallel::parallelFor(hungarianComponents.size(), solveComponent);
+            }
+            else
+            {
+                for (size_t c = 0; c < hungarianComponents.size(); ++c)
+                {
+                    solveComponent(c);
+                }
             }
 
-            Algorithms::Hungarian hs = Algorithms::Hungarian(costMatrix, optimizingMode);
-            cv::Mat assigments = hs.getAssignmentAsMatrix();
-            bool foundLarvaForRawLarva = false;
+            // with motion prediction the gate replaces the point-in-contour check (fast larvae leave their last footprint)
+            bool const acceptGatedPairs = usesMotionPrediction();
 
-            for (int i = 0; i < assigments.rows; ++i)
+            for (int i = 0; i < costMatrix.rows; ++i)
             {
-
-                foundLarvaForRawLarva = false;
-                for (int j = 0; j < assigments.cols; ++j)
+                int const j = assignedColumn.at(i);
+                if (j >= 0
+                    && (acceptGatedPairs
+                        ? costMatrix.at<double>(i, j) < std::numeric_limits<double>::max()
+                        : _larvaeContainer.larvaHasPointInLabel(timePoint, validLarvaeIDs.at(j), _curLabels, i, _curRawLarvae.at(i).getContour())))
                 {
-                    uint midPointIndex;
-                    cv::Point midPoint;
-                    _larvaeContainer.getSpineMidPointIndex(validLarvaeIDs.at(j), midPointIndex);
-                    _larvaeContainer.getSpinePointAt(validLarvaeIDs.at(j), timePoint - 1, midPointIndex, midPoint);
+                    insertRawLarva(i, validLarvaeIDs.at(j), timePoint);
+                }
+                else
+                {
+                    createNewLarva(i, timePoint);
+                }
+            }
+        }
+    }
+}
+
+void Tracker::assignBySparseLAP(unsigned int timePoint)
+{
+    std::vector<int> validLarvaeIDs;
+    if (!_larvaeContainer.isEmpty())
+    {
+        validLarvaeIDs = _lastTracks.larvaIDs;
+    }
+
+    // if there are no detections in the last frame
+    // insert current dections as new larvae in larvaecontainer
+    if (_curRawLarvae.empty() || validLarvaeIDs.empty())
+    {
+        for (size_t i = 0; i < _curRawLarvae.size(); ++i)
+        {
+            createNewLarva(i, timePoint);
+        }
+        return;
+    }
+
+    int const rows = static_cast<int>(_curRawLarvae.size());
+    int const cols = static_cast<int>(validLarvaeIDs.size());
+    Algorithms::SparseLAP lap(rows, cols);
 
-                    if (assigments.at<uchar>(i, j) == 1
-                        && _larvaeContainer.larvaHasPointInContour(timePoint, validLarvaeIDs.at(j), _curRawLarvae.at(i).getContour()))
+    switch (LarvaeExtractionParameters::AssignmentParameters::eCostMeasure)
+    {
+        case LarvaeExtractionParameters::AssignmentParameters::OVERLAP:
+        {
+            // only overlapping pairs are assignable, the overlap is maximized
+            cv::Mat overlaps = cv::Mat::zeros(rows, cols, CV_64F);
+            calcOverlaps(validLarvaeIDs, overlaps);
+
+            for (int i = 0; i < rows; ++i)
+            {
+                double const* overlapRow = overlaps.ptr<double>(i);
+                for (int j = 0; j < cols; ++j)
+                {
+                    if (overlapRow[j] > 0)
                     {
-                        foundLarvaForRawLarva = true;
-                        _larvaeContainer.insertRawLarva(validLarvaeIDs.at(j), timePoint, _curRawLarvae.at(i));
-                        break;
+                        lap.addEdge(i, j, -overlapRow[j]);
                     }
                 }
+            }
+
+            break;
+        }
 
+        case LarvaeExtractionParameters::AssignmentParameters::MOMENTUM:
+        case LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT:
+        {
+            // only pairs within the gating radius (covering the footprints of both larvae without motion prediction)
+            // are assignable
+            std::vector<std::pair<int, double> > candidates;
+            buildGatingIndex(std::max(LarvaeExtractionParameters::AssignmentParameters::dDistanceThreshold, minHungarianGatingFactor), !usesMotionPrediction());
+
+            for (int i = 0; i < rows; ++i)
+            {
+                double const extraRadius = usesMotionPrediction() ? 0.0 : getFootprintRadius(_curRawLarvae.at(i));
+                getGatedCandidates(getAssignmentPosition(_curRawLarvae.at(i)), candidates, extraRadius);
 
-                if (!foundLarvaForRawLarva)
+                for (auto const& c : candidates)
                 {
-                    _larvaeContainer.createNewLarva(timePoint, _curRawLarvae.at(i), _larvaID);
-                    ++_larvaID;
+                    lap.addEdge(i, c.first, c.second);
                 }
             }
+
+            break;
+        }
+    }
+
+    lap.solve();
+
+    // every assigned pair is gated, with motion prediction the gate replaces the point-in-contour check
+    bool const acceptGatedPairs = usesMotionPrediction();
+
+    for (int i = 0; i < rows; ++i)
+    {
+        int const j = lap.getAssignedColumn(i);
+        if (j >= 0 && (acceptGatedPairs || _larvaeContainer.larvaHasPointInLabel(timePoint, validLarvaeIDs.at(j), _curLabels, i, _curRawLarvae.at(i).getContour())))
+        {
+            insertRawLarva(i, validLarvaeIDs.at(j), timePoint);
+        }
+        else
+        {
+            createNewLarva(i, timePoint);
         }
     }
 }
@@ -480,133 +884,97 @@ void Tracker::assignByGreedy(unsigned int timePoint)
 {
     if (_larvaeContainer.isEmpty())
     {
-        for (auto const& rawLarva : _curRawLarvae)
+        for (size_t i = 0; i < _curRawLarvae.size(); ++i)
         {
-            _larvaeContainer.createNewLarva(timePoint, rawLarva, _larvaID);
-            ++_larvaID;
+            createNewLarva(i, timePoint);
         }
     }
     else
     {
 
-        std::vector<int> validLarvaeIDs = _larvaeContainer.getAllValidLarvaeIDS(timePoint - 1);
+        std::vector<int> validLarvaeIDs = _lastTracks.larvaIDs;
 
         if (validLarvaeIDs.empty())
         {
-            for (auto const& rawLarva : _curRawLarvae)
+            for (size_t i = 0; i < _curRawLarvae.size(); ++i)
             {
-                _larvaeContainer.createNewLarva(timePoint, rawLarva, _larvaID);
-                ++_larvaID;
+                createNewLarva(i, timePoint);
             }
         }
         else
         {
 
-            contour_t lastContour, curContour;
-            cv::Point lastMomentum, curMomentum;
-            cv::Point lastMidPoint, curMidPoint;
-            double overlap, distance, lastArea, lastSpineLength; // changed and used in every iteration
+            cv::Mat overlaps;
+            std::vector<int> overlapColumn;
+            std::vector<std::pair<int, double> > candidates;
+            std::vector<bool> assignedColumn;
+            double overlap, lastArea; // changed and used in every iteration
             double distanceThresh = LarvaeExtractionParameters::AssignmentParameters::dDistanceThreshold;
             double overlapThresh = LarvaeExtractionParameters::AssignmentParameters::dOverlapThreshold;
             bool larvaFound = false;
-            uint midPointIndex;
 
             switch (LarvaeExtractionParameters::AssignmentParameters::eCostMeasure)
             {
                 case LarvaeExtractionParameters::AssignmentParameters::OVERLAP:
 
-                    for (size_t i = 0; i < _curRawLarvae.size(); ++i)
+                    // overlaps of all raw larvae with all larvae (columns follow the original order of validLarvaeIDs)
+                    calcOverlaps(validLarvaeIDs, overlaps);
+                    overlapColumn.resize(validLarvaeIDs.size());
+                    for (size_t j = 0; j < overlapColumn.size(); ++j)
                     {
-                        curContour = _curRawLarvae.at(i).getContour();
-
-                        for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
-                        {
-                            if (_larvaeContainer.getContour(validLarvaeIDs.at(j), lastContour))
-                            {
-                                overlap = Calc::calcOverlap(lastContour, curContour);
-                                _larvaeContainer.getAreaAt(validLarvaeIDs.at(j), timePoint - 1, lastArea);
-
-                                if (overlap > overlapThresh * lastArea)
-                                {
-                                    larvaFound = true;
-                                    _larvaeContainer.insertRawLarva(validLarvaeIDs.at(j), timePoint, _curRawLarvae.at(i));
-                                    validLarvaeIDs.erase(validLarvaeIDs.begin() + j);
-                                    break;
-                                }
-                            }
-
-                        }
-                        if (!larvaFound)
-                        {
-                            _larvaeContainer.createNewLarva(timePoint, _curRawLarvae.at(i), _larvaID);
-                            ++_larvaID;
-                        }
-                        larvaFound = false;
+                        overlapColumn.at(j) = static_cast<int>(j);
                     }
 
-                    break;
-
-                case LarvaeExtractionParameters::AssignmentParameters::MOMENTUM:
-
                     for (size_t i = 0; i < _curRawLarvae.size(); ++i)
                     {
-                        curMomentum = _curRawLarvae.at(i).getMomentum();
-
                         for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
                         {
-                            if (_larvaeContainer.getMomentumAt(validLarvaeIDs.at(j), timePoint - 1, lastMomentum))
+                            overlap = overlaps.at<double>(static_cast<int>(i), overlapColumn.at(j));
+                            lastArea = _lastTracks.area.at(overlapColumn.at(j));
+
+                            if (overlap > overlapThresh * lastArea)
                             {
-                                distance = Calc::eucledianDist(lastMomentum, curMomentum);
-                                _larvaeContainer.getSpineLengthAt(validLarvaeIDs.at(j), timePoint - 1, lastSpineLength);
-
-                                if (distance < distanceThresh * lastSpineLength)
-                                {
-                                    larvaFound = true;
-                                    _larvaeContainer.insertRawLarva(validLarvaeIDs.at(j), timePoint, _curRawLarvae.at(i));
-                                    validLarvaeIDs.erase(validLarvaeIDs.begin() + j);
-                                    break;
-                                }
+                                larvaFound = true;
+                                insertRawLarva(i, validLarvaeIDs.at(j), timePoint);
+                                validLarvaeIDs.erase(validLarvaeIDs.begin() + j);
+                                overlapColumn.erase(overlapColumn.begin() + j);
+                                break;
                             }
-
                         }
                         if (!larvaFound)
                         {
-                            _larvaeContainer.createNewLarva(timePoint, _curRawLarvae.at(i), _larvaID);
-                            ++_larvaID;
+                            createNewLarva(i, timePoint);
                         }
                         larvaFound = false;
                     }
 
                     break;
 
+                case LarvaeExtractionParameters::AssignmentParameters::MOMENTUM:
                 case LarvaeExtractionParameters::AssignmentParameters::MID_SPINE_POINT:
 
+                    // candidates are all larvae with distance < distanceThresh * lastSpineLength
+                    buildGatingIndex(distanceThresh);
+                    assignedColumn.assign(validLarvaeIDs.size(), false);
+
                     for (size_t i = 0; i < _curRawLarvae.size(); ++i)
                     {
-                        curMidPoint = _curRawLarvae.at(i).getMidPoint();
+                        getGatedCandidates(getAssignmentPosition(_curRawLarvae.at(i)), candidates);
 
-                        for (size_t j = 0; j < validLarvaeIDs.size(); ++j)
+                        // select the first (in order of validLarvaeIDs) unassigned candidate
+                        for (auto const& c : candidates)
                         {
-                            if (_larvaeContainer.getSpineMidPointIndex(validLarvaeIDs.at(j), midPointIndex))
+                            if (!assignedColumn.at(c.first))
                             {
-                                _larvaeContainer.getSpinePointAt(validLarvaeIDs.at(j), timePoint - 1, midPointIndex, lastMidPoint);
-                                distance = Calc::eucledianDist(lastMidPoint, curMidPoint);
-                                _larvaeContainer.getSpineLengthAt(validLarvaeIDs.at(j), timePoint - 1, lastSpineLength);
-
-                                if (distance < distanceThresh * lastSpineLength)
-                                {
-                                    larvaFound = true;
-                                    _larvaeContainer.insertRawLarva(validLarvaeIDs.at(j), timePoint, _curRawLarvae.at(i));
-                                    validLarvaeIDs.erase(validLarvaeIDs.begin() + j);
-                                    break;
-                                }
+                                larvaFound = true;
+                                assignedColumn.at(c.first) = true;
+                                insertRawLarva(i, validLarvaeIDs.at(c.first), timePoint);
+                                break;
                             }
-
                         }
                         if (!larvaFound)
                         {
-                            _larvaeContainer.createNewLarva(timePoint, _curRawLarvae.at(i), _larvaID);
-                            ++_larvaID;
+                            createNewLarva(i, timePoint);
                         }
                         larvaFound = false;
                     }
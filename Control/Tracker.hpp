@@ -50,12 +50,19 @@
 #include "Preprocessor.hpp"
 #include "Data/RawLarva.hpp"
 #include "Data/Larva.hpp"
+#include "Data/LabelImage.hpp"
 #include "OutputGenerator.hpp"
 #include "Logger.hpp"
 #include "Undistorter.hpp"
 #include "LarvaeContainer.hpp"
+#include "CSVWriter.hpp"
+#include "PersistenceQueue.hpp"
 #include "GUI/RegionOfInterestContainer.hpp"
 #include "Algorithm/Hungarian.hpp"
+#include "Algorithm/SpatialGrid.hpp"
+#include "Algorithm/SparseLAP.hpp"
+#include "Algorithm/BipartiteComponents.hpp"
+#include "Utility/ParallelFor.hpp"
 
 /**
  * @brief The Tracker class contains all necessary steps for tracking. Tracking is done in two major steps:
@@ -122,6 +129,44 @@ private:
      * @brief larvae stores the larvae objects, which are generated and assigned from the raw larvae objects
      */
     LarvaeContainer _larvaeContainer;
+    /**
+     * @brief csvStream appends the final values to the stream csv file while tracking (only open if GeneralParameters::bStreamCSVOutput)
+     */
+    CSVStreamWriter _csvStream;
+    /**
+     * @brief persistenceQueue writes the results of the finished jobs while the next job is tracked
+     */
+    PersistenceQueue _persistenceQueue;
+    /**
+     * @brief curLabels stores the footprints of the current raw larvae (label i belongs to curRawLarvae[i])
+     */
+    LabelImage _curLabels;
+    /**
+     * @brief curLabelLarvaIDs stores the id of the larva each current raw larva is assigned to
+     */
+    std::vector<unsigned int> _curLabelLarvaIDs;
+    /**
+     * @brief lastLabels stores the footprints of the larvae in the previous frame (label i belongs to the larva lastLabelLarvaIDs[i])
+     */
+    LabelImage _lastLabels;
+    std::vector<unsigned int> _lastLabelLarvaIDs;
+    /**
+     * @brief gatingIndex spatial index of the larvae positions (momentum or mid spine point) in the previous frame
+     */
+    Algorithms::SpatialGrid _gatingIndex;
+    /**
+     * @brief lastTracks snapshot of the larvae in the previous frame (taken once per frame; its ids are the columns of
+     *        the assignment)
+     */
+    TrackSnapshot _lastTracks;
+    /**
+     * @brief gatingColumns, gatingRadii and gatingCostScales store column in the cost matrix, gating radius and the
+     *        scale of the distance cost (standard deviation of the motion prediction, 1 otherwise) of every indexed larva
+     */
+    std::vector<int> _gatingColumns;
+    std::vector<double> _gatingRadii;
+    std::vector<double> _gatingCostScales;
+    double _maxGatingRadius;
 
     unsigned int _larvaID;
 
@@ -152,6 +197,12 @@ private:
      * @param previewImg a pointer to an image for live tracking preview in the main gui
      * @return number of processed images (timepoint)
      */
+    /**
+     * @brief createROIMask creates the mask of all regions of interest (applied to every image before the tracking)
+     * @return empty mask if there is no ROI container
+     */
+    static cv::Mat createROIMask(cv::Size const& imageSize, RegionOfInterestContainer const* ROIContainer);
+
     uint track(std::vector<std::string> const &imgPaths, Backgroundsubtractor const & bs, Undistorter const & undist, const RegionOfInterestContainer *ROIContainer = nullptr);
 
     /**
@@ -171,6 +222,8 @@ private:
     
     /**
      * @brief assignByHungarian assigns larvae by minimizing overall cost (or maximizing overall utility) using the hungarian algorithm.
+     *        The assignable pairs are split into connected components which are solved independently (in parallel for
+     *        large problems); components consisting of a single pair are assigned directly.
      *
      * @param timePoint current timepoint
      */
@@ -182,6 +235,70 @@ private:
      * @param timePoint current timepoint
      */
     void assignByGreedy(unsigned int timePoint);
+
+    /**
+     * @brief assignBySparseLAP assigns larvae by minimizing overall cost (or maximizing overall overlap) using a sparse
+     *        linear assignment solver. Only gated (or overlapping) pairs are assignable.
+     *
+     * @param timePoint current timepoint
+     */
+    void assignBySparseLAP(unsigned int timePoint);
+
+    /**
+     * @brief insertRawLarva moves the raw larva at rawLarvaIndex into the larva with the given id
+     */
+    void insertRawLarva(size_t const rawLarvaIndex, unsigned int const larvaID, unsigned int const timePoint);
+
+    /**
+     * @brief createNewLarva creates a new larva from the raw larva at rawLarvaIndex
+     */
+    void createNewLarva(size_t const rawLarvaIndex, unsigned int const timePoint);
+
+    /**
+     * @brief calcOverlaps calculates the overlap (in pixels) of all current raw larvae with the given larvae in the previous frame
+     *        using a single sweep over the label images
+     * @param larvaeIDs ids of larvae which are valid in the previous frame
+     * @param overlaps matrix (CV_64F) of size curRawLarvae.size() x larvaeIDs.size()
+     */
+    void calcOverlaps(std::vector<int> const& larvaeIDs, cv::Mat& overlaps) const;
+
+    /**
+     * @brief getAssignmentPosition returns the position of the raw larva used by the distance based cost measures
+     *        (momentum or mid spine point)
+     */
+    cv::Point getAssignmentPosition(RawLarva const& rawLarva) const;
+
+    /**
+     * @brief getFootprintRadius returns the maximal distance between the assignment position and the contour points of
+     *        the raw larva, i.e. every point inside the contour lies within this radius around the position
+     */
+    double getFootprintRadius(RawLarva const& rawLarva) const;
+
+    /**
+     * @brief usesMotionPrediction returns true if the distance based cost measures use the predicted positions
+     */
+    bool usesMotionPrediction() const;
+
+    /**
+     * @brief buildGatingIndex indexes the positions of the larvae in the previous frame (taken from lastTracks). A larva is
+     *        a candidate for a raw larva if their distance is below gatingFactor times the spine length of the larva.
+     *        With motion prediction, the predicted positions are indexed and the radius is additionally limited by
+     *        the prediction uncertainty.
+     * @param gatingFactor factor of the spine length giving the gating radius
+     * @param footprintGate if true, the radius is at least the footprint radius of the larva (see TrackSnapshot). Together
+     *        with the footprint radius of the raw larva (extraRadius of getGatedCandidates) no pair is gated out which can
+     *        pass the point-in-contour check.
+     */
+    void buildGatingIndex(double gatingFactor, bool footprintGate = false);
+
+    /**
+     * @brief getGatedCandidates returns all larvae within their gating radius around the given position
+     * @param p position of a raw larva
+     * @param candidates pairs of column (index in lastTracks) and cost (distance, divided by the prediction standard
+     *        deviation with motion prediction), sorted by column
+     * @param extraRadius added to the gating radius of every larva (i.e. the footprint radius of the raw larva)
+     */
+    void getGatedCandidates(cv::Point const& p, std::vector<std::pair<int, double> >& candidates, double extraRadius = 0.0) const;
    
     /// helper for hungarian assignment function
     bool larvaHasPointInRawLarva(unsigned int const timePoint, Larva const & larva, RawLarva const& rawLarva);
@@ -0,0 +1,913 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "YMLResultsReader.hpp"
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <QFile>
+
+#include "QtOpencvCore.hpp"
+#include "Utility/ParallelFor.hpp"
+
+namespace
+{
+    /**
+     * @brief The Range struct references characters of the mapped file
+     */
+    struct Range
+    {
+        char const* begin;
+        char const* end;
+        
+        bool empty() const {return this->begin == this->end;}
+        size_t size() const {return static_cast<size_t>(this->end - this->begin);}
+        
+        bool equals(char const* str) const
+        {
+            size_t const n = std::strlen(str);
+            return this->size() == n && std::memcmp(this->begin, str, n) == 0;
+        }
+        
+        bool startsWith(char const* str) const
+        {
+            size_t const n = std::strlen(str);
+            return this->size() >= n && std::memcmp(this->begin, str, n) == 0;
+        }
+    };
+    
+    struct Line
+    {
+        int     indent;
+        /**
+         * @brief content the line without indentation and trailing white spaces
+         */
+        Range   content;
+        
+        char const* lineBegin() const {return this->content.begin - this->indent;}
+    };
+    
+    class LineCursor
+    {
+    public:
+        LineCursor(char const* begin, char const* end) : mPos(begin), mEnd(end) {}
+        
+        /**
+         * @brief next reads the next non-empty line
+         */
+        bool next(Line& line)
+        {
+            while(this->mPos < this->mEnd)
+            {
+                char const* lineBegin = this->mPos;
+                char const* lineEnd = static_cast<char const*>(std::memchr(this->mPos, '\n', this->mEnd - this->mPos));
+                if(lineEnd == nullptr)
+                {
+                    lineEnd = this->mEnd;
+                }
+                this->mPos = (lineEnd < this->mEnd) ? lineEnd + 1 : this->mEnd;
+                
+                char const* b = lineBegin;
+                while(b < lineEnd && *b == ' ')
+                {
+                    ++b;
+                }
+                char const* e = lineEnd;
+                while(e > b && (e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t'))
+                {
+                    --e;
+                }
+                if(b != e)
+                {
+                    line.indent = static_cast<int>(b - lineBegin);
+                    line.content.begin = b;
+                    line.content.end = e;
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+    private:
+        char const* mPos;
+        char const* mEnd;
+    };
+    
+    /**
+     * @brief stripDash removes the leading "- " of sequence items (the item is treated like a line indented by 2)
+     * @return true if the line only consists of "-" (the content of the item follows in the next lines)
+     */
+    bool stripDash(Line& line)
+    {
+        while(!line.content.empty() && *line.content.begin == '-')
+        {
+            if(line.content.size() == 1)
+            {
+                return true;
+            }
+            if(line.content.begin[1] != ' ')
+            {
+                break;
+            }
+            line.content.begin += 2;
+            line.indent += 2;
+            while(!line.content.empty() && *line.content.begin == ' ')
+            {
+                ++line.content.begin;
+                ++line.indent;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief splitKey splits "key: value" (the value may be empty)
+     */
+    bool splitKey(Range const& content, Range& key, Range& value)
+    {
+        for(char const* p = content.begin; p < content.end; ++p)
+        {
+            if(*p == ':' && (p + 1 == content.end || p[1] == ' '))
+            {
+                key.begin = content.begin;
+                key.end = p;
+                char const* v = p + 1;
+                while(v < content.end && *v == ' ')
+                {
+                    ++v;
+                }
+                value.begin = v;
+                value.end = content.end;
+                return true;
+            }
+            if(*p == '"' || *p == '\'' || *p == '[' || *p == '{')
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief splitFlowSequence splits "[ a, b, ... ]" into its items
+     */
+    bool splitFlowSequence(Range const& value, std::vector<Range>& items)
+    {
+        items.clear();
+        if(value.size() < 2 || value.begin[0] != '[' || value.end[-1] != ']')
+        {
+            return false;
+        }
+        
+        char const* p = value.begin + 1;
+        char const* const end = value.end - 1;
+        while(p < end)
+        {
+            while(p < end && *p == ' ')
+            {
+                ++p;
+            }
+            char const* itemEnd = static_cast<char const*>(std::memchr(p, ',', end - p));
+            if(itemEnd == nullptr)
+            {
+                itemEnd = end;
+            }
+            Range item = {p, itemEnd};
+            while(!item.empty() && item.end[-1] == ' ')
+            {
+                --item.end;
+            }
+            if(!item.empty())
+            {
+                items.push_back(item);
+            }
+            p = itemEnd + 1;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief The NumberParser class parses the numbers as written by cv::FileStorage independent of the C locale
+     */
+    class NumberParser
+    {
+    public:
+        NumberParser() : mDecimalPoint('.')
+        {
+            std::lconv const* lc = std::localeconv();
+            if(lc != nullptr && lc->decimal_point != nullptr && lc->decimal_point[0] != '\0')
+            {
+                this->mDecimalPoint = lc->decimal_point[0];
+            }
+        }
+        
+        bool parseDouble(Range r, double& value) const
+        {
+            bool negative = false;
+            Range unsignedRange = r;
+            if(!unsignedRange.empty() && (*unsignedRange.begin == '-' || *unsignedRange.begin == '+'))
+            {
+                negative = *unsignedRange.begin == '-';
+                ++unsignedRange.begin;
+            }
+            if(unsignedRange.equals(".Inf") || unsignedRange.equals(".inf"))
+            {
+                value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                return true;
+            }
+            if(unsignedRange.equals(".Nan") || unsignedRange.equals(".nan") || unsignedRange.equals(".NaN"))
+            {
+                value = std::numeric_limits<double>::quiet_NaN();
+                return true;
+            }
+            
+            // strtod uses the decimal separator of the C locale
+            char buffer[64];
+            size_t const n = r.size();
+            if(n == 0 || n >= sizeof(buffer))
+            {
+                return false;
+            }
+            for(size_t i = 0; i < n; ++i)
+            {
+                buffer[i] = (r.begin[i] == '.') ? this->mDecimalPoint : r.begin[i];
+            }
+            buffer[n] = '\0';
+            
+            char* end = nullptr;
+            value = std::strtod(buffer, &end);
+            return end == buffer + n;
+        }
+        
+        bool parseInt(Range r, int& value) const
+        {
+            char const* p = r.begin;
+            bool negative = false;
+            if(p < r.end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+            if(p == r.end)
+            {
+                return false;
+            }
+            
+            long long v = 0;
+            for(; p < r.end; ++p)
+            {
+                if(*p < '0' || *p > '9')
+                {
+                    // integers may be stored as real numbers
+                    double d;
+                    if(!this->parseDouble(r, d))
+                    {
+                        return false;
+                    }
+                    value = static_cast<int>(std::floor(d + 0.5));
+                    return true;
+                }
+                v = 10 * v + (*p - '0');
+            }
+            value = static_cast<int>(negative ? -v : v);
+            return true;
+        }
+        
+    private:
+        char mDecimalPoint;
+    };
+    
+    /**
+     * @brief parseString parses plain and quoted strings (with the escape sequences written by cv::FileStorage)
+     */
+    std::string parseString(Range const& r)
+    {
+        if(r.size() >= 2 && r.begin[0] == '\'' && r.end[-1] == '\'')
+        {
+            std::string str;
+            for(char const* p = r.begin + 1; p < r.end - 1; ++p)
+            {
+                str.push_back(*p);
+                if(*p == '\'' && p + 1 < r.end - 1 && p[1] == '\'')
+                {
+                    ++p;
+                }
+            }
+            return str;
+        }
+        if(r.size() < 2 || r.begin[0] != '"' || r.end[-1] != '"')
+        {
+            return std::string(r.begin, r.end);
+        }
+        
+        std::string str;
+        for(char const* p = r.begin + 1; p < r.end - 1; ++p)
+        {
+            if(*p != '\\' || p + 1 >= r.end - 1)
+            {
+                str.push_back(*p);
+                continue;
+            }
+            ++p;
+            switch(*p)
+            {
+                case 'n':   str.push_back('\n'); break;
+                case 'r':   str.push_back('\r'); break;
+                case 't':   str.push_back('\t'); break;
+                case 'x':
+                    if(p + 2 < r.end - 1)
+                    {
+                        char hex[3] = {p[1], p[2], '\0'};
+                        str.push_back(static_cast<char>(std::strtol(hex, nullptr, 16)));
+                        p += 2;
+                    }
+                    break;
+                default:    str.push_back(*p); break;
+            }
+        }
+        return str;
+    }
+    
+    /**
+     * @brief The LandmarkIDCache class caches the registry IDs of the landmark names of a larva block (see LandmarkRegistry)
+     */
+    class LandmarkIDCache
+    {
+    public:
+        int getID(Range const& name)
+        {
+            for(auto const& entry : this->mIDs)
+            {
+                if(entry.first.size() == name.size() && std::memcmp(entry.first.data(), name.begin, name.size()) == 0)
+                {
+                    return entry.second;
+                }
+            }
+            std::string str(name.begin, name.end);
+            int const id = LandmarkRegistry::registerLandmark(str);
+            this->mIDs.push_back(std::make_pair(str, id));
+            return id;
+        }
+        
+    private:
+        std::vector<std::pair<std::string, int> > mIDs;
+    };
+    
+    void resetValues(Larva::ValuesType& values)
+    {
+        values.spine.clear();
+        values.momentum = cv::Point(0, 0);
+        values.area = 0.0;
+        values.spineRadii.clear();
+        values.mainBodyBendingAngle = 0.0;
+        values.spineLength = 0.0;
+        values.perimeter = 0.0;
+        values.isCoiled = false;
+        values.isWellOriented = false;
+        values.distToOrigin = 0.0;
+        values.momentumDist = 0.0;
+        values.accDist = 0.0;
+        values.goPhase = 0;
+        values.isLeftBended = false;
+        values.isRightBended = false;
+        values.movementDirection = 0.0;
+        values.velosity = 0.0;
+        values.acceleration = 0.0;
+        values.nearestNeighbourDist = 0.0;
+        values.neighbourCount = 0;
+    }
+    
+    /**
+     * @brief The LarvaBlockParser class parses the block of a single larva (one item of the data sequence)
+     */
+    class LarvaBlockParser
+    {
+    public:
+        LarvaBlockParser(NumberParser const& numberParser, Larva& larva) : 
+            mNumbers(numberParser),
+            mLarva(larva),
+            mContext(NONE),
+            mContextIndent(0),
+            mHasValues(false),
+            mTimeStep(0),
+            mNSpinePoints(0)
+        {
+            resetValues(this->mValues);
+        }
+        
+        bool parse(Range const& block)
+        {
+            LineCursor cursor(block.begin, block.end);
+            Line line;
+            while(cursor.next(line))
+            {
+                if(stripDash(line))
+                {
+                    continue;
+                }
+                
+                if(this->mContext != NONE)
+                {
+                    if(line.indent > this->mContextIndent)
+                    {
+                        if(!this->parseContextLine(line.content))
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+                    this->mContext = NONE;
+                }
+                
+                Range key, value;
+                if(!splitKey(line.content, key, value) || !this->parseKey(key, value, line.indent))
+                {
+                    return false;
+                }
+            }
+            
+            this->flush();
+            this->mLarva.setNSpinePoints(this->mNSpinePoints);
+            return true;
+        }
+        
+    private:
+        enum Context
+        {
+            NONE,
+            SPINE,
+            SPINE_RADII,
+            DISTANCE_TO_LANDMARK,
+            IS_IN_LANDMARK,
+            BEARING_ANGLE,
+            SKIP
+        };
+        
+        bool parseDouble(Range const& value, double& target) const
+        {
+            return this->mNumbers.parseDouble(value, target);
+        }
+        
+        bool parseBool(Range const& value, bool& target) const
+        {
+            int i;
+            if(!this->mNumbers.parseInt(value, i))
+            {
+                return false;
+            }
+            target = i != 0;
+            return true;
+        }
+        
+        bool parsePoint(Range const& value, cv::Point& p)
+        {
+            int x, y;
+            if(!splitFlowSequence(value, this->mItems) 
+                    || this->mItems.size() != 2
+                    || !this->mNumbers.parseInt(this->mItems[0], x)
+                    || !this->mNumbers.parseInt(this->mItems[1], y))
+            {
+                return false;
+            }
+            p = cv::Point(x, y);
+            return true;
+        }
+        
+        /**
+         * @brief beginContext starts a block collection (value is empty) or parses an empty flow collection
+         */
+        bool beginContext(Context const context, Range const& value, int const indent)
+        {
+            if(value.empty())
+            {
+                this->mContext = context;
+                this->mContextIndent = indent;
+                return true;
+            }
+            return value.equals("[]") || value.equals("{}");
+        }
+        
+        bool parseKey(Range const& key, Range const& value, int const indent)
+        {
+            if(key.equals("larvaID"))
+            {
+                int id;
+                if(!this->mNumbers.parseInt(value, id))
+                {
+                    return false;
+                }
+                this->mLarva.setID(static_cast<uint>(id));
+                return true;
+            }
+            if(key.equals("timeStep"))
+            {
+                int timeStep;
+                if(!this->mNumbers.parseInt(value, timeStep))
+                {
+                    return false;
+                }
+                this->flush();
+                this->mTimeStep = static_cast<unsigned int>(timeStep);
+                this->mHasValues = true;
+                return true;
+            }
+            if(key.equals("parameters") || key.equals("values"))
+            {
+                return value.empty() || value.equals("[]");
+            }
+            
+            Larva::ValuesType& v = this->mValues;
+            switch(key.size() > 0 ? key.begin[0] : '\0')
+            {
+                case 'a':
+                    if(key.equals("area"))              return this->parseDouble(value, v.area);
+                    if(key.equals("accDist"))           return this->parseDouble(value, v.accDist);
+                    if(key.equals("acceleration"))      return this->parseDouble(value, v.acceleration);
+                    break;
+                case 'b':
+                    if(key.equals("bearinAngle"))       return this->beginContext(BEARING_ANGLE, value, indent);
+                    break;
+                case 'd':
+                    if(key.equals("distToOrigin"))      return this->parseDouble(value, v.distToOrigin);
+                    if(key.equals("distanceToLandmark"))return this->beginContext(DISTANCE_TO_LANDMARK, value, indent);
+                    break;
+                case 'g':
+                    if(key.equals("goPhase"))           return this->mNumbers.parseInt(value, v.goPhase);
+                    break;
+                case 'i':
+                    if(key.equals("isCoiled"))          return this->parseBool(value, v.isCoiled);
+                    if(key.equals("isWellOriented"))    return this->parseBool(value, v.isWellOriented);
+                    if(key.equals("isLeftBended"))      return this->parseBool(value, v.isLeftBended);
+                    if(key.equals("isRightBended"))     return this->parseBool(value, v.isRightBended);
+                    if(key.equals("isInLandmark"))      return this->beginContext(IS_IN_LANDMARK, value, indent);
+                    break;
+                case 'n':
+                    if(key.equals("nearestNeighbourDist"))  return this->parseDouble(value, v.nearestNeighbourDist);
+                    if(key.equals("neighbourCount"))    return this->mNumbers.parseInt(value, v.neighbourCount);
+                    break;
+                case 'm':
+                    if(key.equals("momentum"))          return this->parsePoint(value, v.momentum);
+                    if(key.equals("mainBodyBendingAngle")) return this->parseDouble(value, v.mainBodyBendingAngle);
+                    if(key.equals("momentumDist"))      return this->parseDouble(value, v.momentumDist);
+                    if(key.equals("movementDirection")) return this->parseDouble(value, v.movementDirection);
+                    break;
+                case 'p':
+                    if(key.equals("perimeter"))         return this->parseDouble(value, v.perimeter);
+                    break;
+                case 's':
+                    if(key.equals("spine"))
+                    {
+                        v.spine.clear();
+                        if(value.empty() || value.equals("[]"))
+                        {
+                            return this->beginContext(SPINE, value, indent);
+                        }
+                        // flow sequence of coordinates (x0, y0, x1, y1, ...)
+                        int x, y;
+                        if(!splitFlowSequence(value, this->mItems) || this->mItems.size() % 2 != 0)
+                        {
+                            return false;
+                        }
+                        for(size_t i = 0; i < this->mItems.size(); i += 2)
+                        {
+                            if(!this->mNumbers.parseInt(this->mItems[i], x) || !this->mNumbers.parseInt(this->mItems[i + 1], y))
+                            {
+                                return false;
+                            }
+                            v.spine.push_back(cv::Point(x, y));
+                        }
+                        return true;
+                    }
+                    if(key.equals("spineRadii"))
+                    {
+                        v.spineRadii.clear();
+                        if(value.empty() || value.equals("[]"))
+                        {
+                            return this->beginContext(SPINE_RADII, value, indent);
+                        }
+                        double r;
+                        if(!splitFlowSequence(value, this->mItems))
+                        {
+                            return false;
+                        }
+                        for(auto const& item : this->mItems)
+                        {
+                            if(!this->parseDouble(item, r))
+                            {
+                                return false;
+                            }
+                            v.spineRadii.push_back(r);
+                        }
+                        return true;
+                    }
+                    if(key.equals("spineLength"))       return this->parseDouble(value, v.spineLength);
+                    break;
+                case 'v':
+                    if(key.equals("velocity"))          return this->parseDouble(value, v.velosity);
+                    break;
+            }
+            
+            // unknown keys (and their nested collections) are skipped
+            if(value.empty())
+            {
+                this->beginContext(SKIP, value, indent);
+            }
+            return true;
+        }
+        
+        bool parseContextLine(Range const& content)
+        {
+            Range key, value;
+            switch(this->mContext)
+            {
+                case SPINE:
+                {
+                    cv::Point p;
+                    if(!this->parsePoint(content, p))
+                    {
+                        return false;
+                    }
+                    this->mValues.spine.push_back(p);
+                    return true;
+                }
+                case SPINE_RADII:
+                {
+                    double r;
+                    if(!this->parseDouble(content, r))
+                    {
+                        return false;
+                    }
+                    this->mValues.spineRadii.push_back(r);
+                    return true;
+                }
+                case DISTANCE_TO_LANDMARK:
+                case BEARING_ANGLE:
+                {
+                    double d;
+                    if(!splitKey(content, key, value) || !this->parseDouble(value, d))
+                    {
+                        return false;
+                    }
+                    std::vector<std::pair<int, double> >& target = (this->mContext == BEARING_ANGLE) ? this->mBearingAngles : this->mDistances;
+                    target.push_back(std::make_pair(this->mLandmarkIDs.getID(key), d));
+                    return true;
+                }
+                case IS_IN_LANDMARK:
+                {
+                    bool isIn;
+                    if(!splitKey(content, key, value) || !this->parseBool(value, isIn))
+                    {
+                        return false;
+                    }
+                    this->mIsInLandmark.push_back(std::make_pair(this->mLandmarkIDs.getID(key), isIn));
+                    return true;
+                }
+                default:
+                    return true;
+            }
+        }
+        
+        /**
+         * @brief flush stores the values of the current time step
+         */
+        void flush()
+        {
+            if(!this->mHasValues)
+            {
+                return;
+            }
+            
+            this->mNSpinePoints = static_cast<unsigned int>(this->mValues.spine.size());
+            this->mLarva.setValuesAt(this->mTimeStep, this->mValues);
+            
+            for(auto const& distance : this->mDistances)
+            {
+                bool isIn = false;
+                for(auto const& in : this->mIsInLandmark)
+                {
+                    if(in.first == distance.first)
+                    {
+                        isIn = in.second;
+                        break;
+                    }
+                }
+                this->mLarva.setLandmarkDistanceAt(this->mTimeStep, distance.first, distance.second, isIn);
+            }
+            for(auto const& bearingAngle : this->mBearingAngles)
+            {
+                this->mLarva.setLandmarkBearingAngleAt(this->mTimeStep, bearingAngle.first, bearingAngle.second);
+            }
+            
+            this->mDistances.clear();
+            this->mIsInLandmark.clear();
+            this->mBearingAngles.clear();
+            resetValues(this->mValues);
+            this->mHasValues = false;
+        }
+        
+        NumberParser const&                     mNumbers;
+        Larva&                                  mLarva;
+        Context                                 mContext;
+        int                                     mContextIndent;
+        bool                                    mHasValues;
+        unsigned int                            mTimeStep;
+        unsigned int                            mNSpinePoints;
+        Larva::ValuesType                       mValues;
+        std::vector<std::pair<int, double> >    mDistances;
+        std::vector<std::pair<int, bool> >      mIsInLandmark;
+        std::vector<std::pair<int, double> >    mBearingAngles;
+        LandmarkIDCache                         mLandmarkIDs;
+        std::vector<Range>                      mItems;
+    };
+    
+    /**
+     * @brief parseDocument reads the top-level keys and splits the data sequence into the larva blocks
+     */
+    bool parseDocument(char const* begin,
+                       char const* end,
+                       NumberParser const& numberParser,
+                       std::vector<std::string>& imgPaths,
+                       bool& useUndist,
+                       std::vector<Range>& blocks)
+    {
+        LineCursor cursor(begin, end);
+        Line line;
+        if(!cursor.next(line) || !line.content.startsWith("%YAML"))
+        {
+            return false;
+        }
+        
+        bool hasData = false;
+        bool hasLine = cursor.next(line);
+        while(hasLine)
+        {
+            Range key, value;
+            if(line.indent != 0 || line.content.equals("---") || !splitKey(line.content, key, value))
+            {
+                hasLine = cursor.next(line);
+                continue;
+            }
+            
+            if(key.equals("imgNames"))
+            {
+                if(!value.empty() && !value.equals("[]"))
+                {
+                    return false;
+                }
+                while((hasLine = cursor.next(line)) && line.indent > 0)
+                {
+                    if(stripDash(line))
+                    {
+                        return false;
+                    }
+                    imgPaths.push_back(parseString(line.content));
+                }
+                continue;
+            }
+            
+            if(key.equals("useUndist"))
+            {
+                int undist;
+                if(!numberParser.parseInt(value, undist))
+                {
+                    return false;
+                }
+                useUndist = undist != 0;
+            }
+            else if(key.equals("data"))
+            {
+                hasData = true;
+                if(!value.empty() && !value.equals("[]"))
+                {
+                    return false;
+                }
+                
+                // every line of the item indentation starts a new larva block
+                int itemIndent = -1;
+                char const* blockBegin = nullptr;
+                while((hasLine = cursor.next(line)) && line.indent > 0)
+                {
+                    if(itemIndent < 0)
+                    {
+                        itemIndent = line.indent;
+                    }
+                    if(line.indent < itemIndent)
+                    {
+                        return false;
+                    }
+                    if(line.indent == itemIndent)
+                    {
+                        if(*line.content.begin != '-')
+                        {
+                            return false;
+                        }
+                        if(blockBegin != nullptr)
+                        {
+                            Range block = {blockBegin, line.lineBegin()};
+                            blocks.push_back(block);
+                        }
+                        blockBegin = line.lineBegin();
+                    }
+                }
+                if(blockBegin != nullptr)
+                {
+                    Range block = {blockBegin, hasLine ? line.lineBegin() : end};
+                    blocks.push_back(block);
+                }
+                continue;
+            }
+            
+            // all other top-level sections (e.g. ROIContainer) are skipped
+            hasLine = cursor.next(line);
+        }
+        
+        return hasData;
+    }
+}
+
+bool YMLResultsReader::read(const std::string &path,
+                            std::vector<Larva> &larvae,
+                            std::vector<std::string> &imgPaths,
+                            bool &useUndist)
+{
+    QFile file(QtOpencvCore::str2qstr(path));
+    if(!file.open(QIODevice::ReadOnly) || file.size() <= 0)
+    {
+        return false;
+    }
+    uchar* data = file.map(0, file.size());
+    if(data == nullptr)
+    {
+        return false;
+    }
+    char const* begin = reinterpret_cast<char const*>(data);
+    char const* end = begin + file.size();
+    
+    NumberParser numberParser;
+    std::vector<std::string> paths;
+    bool undist = false;
+    std::vector<Range> blocks;
+    bool ok = parseDocument(begin, end, numberParser, paths, undist, blocks);
+    
+    std::vector<Larva> parsed(ok ? blocks.size() : 0);
+    std::vector<char> parsedBlocks(parsed.size(), 0);
+    Parallel::parallelFor(parsed.size(), [&](size_t const i)
+    {
+        LarvaBlockParser parser(numberParser, parsed[i]);
+        parsedBlocks[i] = parser.parse(blocks[i]) ? 1 : 0;
+    });
+    file.unmap(data);
+    
+    for(char parsedBlock : parsedBlocks)
+    {
+        ok = ok && parsedBlock != 0;
+    }
+    if(!ok)
+    {
+        return false;
+    }
+    
+    useUndist = undist;
+    imgPaths = paths;
+    larvae.reserve(larvae.size() + parsed.size());
+    for(auto& l : parsed)
+    {
+        larvae.push_back(std::move(l));
+    }
+    return true;
+}
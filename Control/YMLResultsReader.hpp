@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef YMLRESULTSREADER_HPP
+#define YMLRESULTSREADER_HPP
+
+#include <string>
+#include <vector>
+
+#include "Configuration/FIMTrack.hpp"
+#include "Data/Larva.hpp"
+
+/**
+ * @brief The YMLResultsReader class reads the larvae of a yml results file without cv::FileStorage
+ *
+ * cv::FileStorage builds the whole document tree before the larvae can be read and every value is then looked up
+ * by its key. This reader only understands the schema of the yml results files (as written by writeYMLFile in
+ * block style): it maps the file, splits the data sequence into the blocks of the single larvae in one pass over
+ * the lines and parses the blocks in parallel directly into the larvae. Unknown keys are skipped, missing values
+ * are 0 (like reading a missing node with cv::FileStorage).
+ */
+class YMLResultsReader
+{
+public:
+    /**
+     * @brief read appends the larvae of the yml results file at path to larvae
+     * @return false if the file could not be read or does not follow the expected layout (larvae, imgPaths and
+     *         useUndist are unchanged in this case, so the caller can fall back to cv::FileStorage)
+     */
+    static bool read(std::string const& path,
+                     std::vector<Larva>& larvae,
+                     std::vector<std::string>& imgPaths,
+                     bool& useUndist);
+};
+
+#endif // YMLRESULTSREADER_HPP
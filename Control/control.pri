@@ -8,7 +8,16 @@ HEADERS += \
     Control/InputGenerator.hpp \
     Control/Calc.hpp \
     Control/Backgroundsubtractor.hpp \
-    Control/LarvaeContainer.hpp
+    Control/LarvaeContainer.hpp \
+    Control/CSVWriter.hpp \
+    Control/BinaryResultsFile.hpp \
+    Control/YMLResultsReader.hpp \
+    Control/DistanceWriter.hpp \
+    Control/GroupMetrics.hpp \
+    Control/HeatMapAccumulator.hpp \
+    Control/TrackRenderer.hpp \
+    Control/PersistenceQueue.hpp \
+    Control/FrameCache.hpp
 
 SOURCES += \
     Control/Undistorter.cpp \
@@ -20,4 +29,13 @@ SOURCES += \
     Control/InputGenerator.cpp \
     Control/Calc.cpp \
     Control/Backgroundsubtractor.cpp \
-    Control/LarvaeContainer.cpp
+    Control/LarvaeContainer.cpp \
+    Control/CSVWriter.cpp \
+    Control/BinaryResultsFile.cpp \
+    Control/YMLResultsReader.cpp \
+    Control/DistanceWriter.cpp \
+    Control/GroupMetrics.cpp \
+    Control/HeatMapAccumulator.cpp \
+    Control/TrackRenderer.cpp \
+    Control/PersistenceQueue.cpp \
+    Control/FrameCache.cpp
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "LabelImage.hpp"
+
+LabelImage::LabelImage()
+{
+}
+
+void LabelImage::reset(cv::Size const& size)
+{
+    if(this->mLabels.size() != size || this->mLabels.type() != CV_32SC1)
+    {
+        this->mLabels = cv::Mat::zeros(size, CV_32SC1);
+    }
+    else
+    {
+        // only the previously covered regions have to be cleared
+        for(auto const& r : this->mBoundingBoxes)
+        {
+            this->mLabels(r).setTo(cv::Scalar(0));
+        }
+    }
+    this->mBoundingBoxes.clear();
+}
+
+void LabelImage::clear()
+{
+    this->mLabels.release();
+    this->mBoundingBoxes.clear();
+}
+
+int LabelImage::addContour(FIMTypes::contour_t const& contour)
+{
+    int label = static_cast<int>(this->mBoundingBoxes.size());
+    
+    cv::Rect r;
+    if(!contour.empty())
+    {
+        r = cv::boundingRect(contour) & cv::Rect(0, 0, this->mLabels.cols, this->mLabels.rows);
+        
+        cv::Point const* points = contour.data();
+        int nPoints = static_cast<int>(contour.size());
+        // filled polygon including its border (as drawContours with CV_FILLED)
+        cv::fillPoly(this->mLabels, &points, &nPoints, 1, cv::Scalar(label + 1), 8);
+        cv::polylines(this->mLabels, &points, &nPoints, 1, true, cv::Scalar(label + 1), 1, 8);
+    }
+    this->mBoundingBoxes.push_back(r);
+    
+    return label;
+}
+
+int LabelImage::getLabelAt(cv::Point const& p) const
+{
+    if(p.x < 0 || p.y < 0 || p.x >= this->mLabels.cols || p.y >= this->mLabels.rows)
+    {
+        return -1;
+    }
+    
+    return this->mLabels.at<int>(p) - 1;
+}
+
+void LabelImage::calcOverlaps(LabelImage const& other, cv::Mat& overlaps) const
+{
+    overlaps = cv::Mat::zeros(this->getNumberOfLabels(), other.getNumberOfLabels(), CV_64F);
+    
+    if(overlaps.empty() || this->mLabels.size() != other.mLabels.size())
+    {
+        return;
+    }
+    
+    // every covered pixel is visited once (within the bounding box of its own label)
+    for(int i = 0; i < this->getNumberOfLabels(); ++i)
+    {
+        cv::Rect const& r = this->mBoundingBoxes.at(i);
+        double* overlapRow = overlaps.ptr<double>(i);
+        
+        for(int y = r.y; y < r.y + r.height; ++y)
+        {
+            int const* labelRow = this->mLabels.ptr<int>(y);
+            int const* otherRow = other.mLabels.ptr<int>(y);
+            
+            for(int x = r.x; x < r.x + r.width; ++x)
+            {
+                if(labelRow[x] == i + 1 && otherRow[x] > 0)
+                {
+                    overlapRow[otherRow[x] - 1] += 1.0;
+                }
+            }
+        }
+    }
+}
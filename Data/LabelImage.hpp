@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef LABELIMAGE_HPP
+#define LABELIMAGE_HPP
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "Configuration/TrackerConfig.hpp"
+
+/**
+ * @brief The LabelImage class stores the (filled) footprints of several contours in a single label image.
+ *
+ * Every pixel stores the label (i.e. the insertion index) of the contour covering it. Thus, point-in-contour
+ * tests are simple lookups and the pairwise overlaps of all contours of two label images are calculated in a
+ * single sweep over the covered pixels (instead of rasterizing every pair of contours).
+ *
+ * The contours must not overlap each other (which holds for the detections of one frame). Otherwise, the
+ * pixels are assigned to the contour added last.
+ */
+class LabelImage
+{
+public:
+    LabelImage();
+    
+    /**
+     * @brief reset removes all contours and (re-)allocates the label image if the size changes
+     * @param size image size
+     */
+    void reset(cv::Size const& size);
+    
+    /**
+     * @brief clear removes all contours and releases the label image
+     */
+    void clear();
+    
+    /**
+     * @brief addContour draws the filled contour including its border into the label image (as drawContours with
+     *        CV_FILLED; the border pixels are counted by the overlaps, but strict point-in-contour tests have to
+     *        check covered points against the contour, see LarvaeContainer::larvaHasPointInLabel)
+     * @param contour contour
+     * @return label of the contour (i.e. the number of previously added contours)
+     */
+    int addContour(FIMTypes::contour_t const& contour);
+    
+    /**
+     * @brief getLabelAt returns the label at the given point
+     * @param p point
+     * @return label of the contour covering p, -1 if p is not covered (or outside of the image)
+     */
+    int getLabelAt(cv::Point const& p) const;
+    
+    /**
+     * @brief calcOverlaps calculates the overlap (in pixels) of all contours of this label image with all contours
+     *        of the other label image (which must have the same size)
+     * @param other label image
+     * @param overlaps matrix (CV_64F) of size getNumberOfLabels() x other.getNumberOfLabels(); overlaps(i,j) is the
+     *        overlap of label i of this and label j of the other label image
+     */
+    void calcOverlaps(LabelImage const& other, cv::Mat& overlaps) const;
+    
+    int getNumberOfLabels() const {return static_cast<int>(this->mBoundingBoxes.size());}
+    cv::Size getSize() const {return this->mLabels.size();}
+    
+private:
+    /**
+     * @brief mLabels label image (CV_32S); 0 is background, label i is stored as i+1
+     */
+    cv::Mat mLabels;
+    /**
+     * @brief mBoundingBoxes bounding boxes (clipped to the image) of all contours
+     */
+    std::vector<cv::Rect> mBoundingBoxes;
+};
+
+#endif // LABELIMAGE_HPP
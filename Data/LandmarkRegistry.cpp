@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "LandmarkRegistry.hpp"
+
+std::mutex                              LandmarkRegistry::sMutex;
+std::unordered_map<std::string, int>    LandmarkRegistry::sIDs;
+std::vector<std::string>                LandmarkRegistry::sNames;
+
+int LandmarkRegistry::registerLandmark(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    
+    std::unordered_map<std::string, int>::const_iterator it = sIDs.find(name);
+    if(it != sIDs.end())
+    {
+        return it->second;
+    }
+    
+    int id = static_cast<int>(sNames.size());
+    sNames.push_back(name);
+    sIDs.insert(std::make_pair(name, id));
+    
+    return id;
+}
+
+int LandmarkRegistry::getID(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    
+    std::unordered_map<std::string, int>::const_iterator it = sIDs.find(name);
+    return it != sIDs.end() ? it->second : -1;
+}
+
+std::string LandmarkRegistry::getName(const int id)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    
+    if(id < 0 || static_cast<size_t>(id) >= sNames.size())
+    {
+        return std::string();
+    }
+    
+    return sNames.at(id);
+}
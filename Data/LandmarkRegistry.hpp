@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef LANDMARKREGISTRY_HPP
+#define LANDMARKREGISTRY_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+/**
+ * @brief The LandmarkRegistry class assigns compact integer IDs (0, 1, 2, ...) to landmark names.
+ *
+ * The landmark related features of a larva (see LandmarkSeries) are stored per landmark ID, thus looking up a
+ * feature does not compare strings. The registry is shared by all larvae (and containers) of the process, so
+ * the same name always maps to the same ID. IDs are never reused: removing a landmark only drops its values
+ * from the larvae, the (tiny) name entry stays registered.
+ */
+class LandmarkRegistry
+{
+public:
+    /**
+     * @brief registerLandmark returns the ID of the given landmark name (a new ID is assigned for unknown names)
+     */
+    static int registerLandmark(std::string const& name);
+    
+    /**
+     * @brief getID returns the ID of the given landmark name or -1 if the name is not registered
+     */
+    static int getID(std::string const& name);
+    
+    /**
+     * @brief getName returns the name of the landmark with the given ID (empty for unknown IDs)
+     */
+    static std::string getName(int const id);
+    
+private:
+    static std::mutex                           sMutex;
+    static std::unordered_map<std::string, int> sIDs;
+    static std::vector<std::string>             sNames;
+};
+
+#endif // LANDMARKREGISTRY_HPP
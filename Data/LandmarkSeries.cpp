@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "LandmarkSeries.hpp"
+
+LandmarkSeries::LandmarkSeries() : 
+    mFirstTimePoint(0)
+{
+}
+
+void LandmarkSeries::setDistance(const unsigned int timePoint, const double distance, const bool isInLandmark)
+{
+    size_t i = this->slot(timePoint);
+    this->mDistance[i] = static_cast<float>(distance);
+    this->mFlags[i] |= HAS_DISTANCE;
+    if(isInLandmark)
+    {
+        this->mFlags[i] |= IS_IN_LANDMARK;
+    }
+    else
+    {
+        this->mFlags[i] &= ~IS_IN_LANDMARK;
+    }
+}
+
+void LandmarkSeries::setBearingAngle(const unsigned int timePoint, const double bearingAngle)
+{
+    size_t i = this->slot(timePoint);
+    this->mBearingAngle[i] = static_cast<float>(bearingAngle);
+    this->mFlags[i] |= HAS_BEARING_ANGLE;
+}
+
+bool LandmarkSeries::getDistance(const unsigned int timePoint, double &retDistance) const
+{
+    if(this->getFlags(timePoint) & HAS_DISTANCE)
+    {
+        retDistance = this->mDistance[timePoint - this->mFirstTimePoint];
+        return true;
+    }
+    return false;
+}
+
+bool LandmarkSeries::getIsInLandmark(const unsigned int timePoint, bool &retIsInLandmark) const
+{
+    unsigned char flags = this->getFlags(timePoint);
+    if(flags & HAS_DISTANCE)
+    {
+        retIsInLandmark = (flags & IS_IN_LANDMARK) != 0;
+        return true;
+    }
+    return false;
+}
+
+bool LandmarkSeries::getBearingAngle(const unsigned int timePoint, double &retBearingAngle) const
+{
+    if(this->getFlags(timePoint) & HAS_BEARING_ANGLE)
+    {
+        retBearingAngle = this->mBearingAngle[timePoint - this->mFirstTimePoint];
+        return true;
+    }
+    return false;
+}
+
+void LandmarkSeries::copy(const LandmarkSeries &src, const unsigned int srcTimePoint, const unsigned int dstTimePoint)
+{
+    // read first: slot() may reallocate the arrays if src is this series
+    unsigned char flags = src.getFlags(srcTimePoint);
+    if(flags == 0)
+    {
+        this->erase(dstTimePoint);
+        return;
+    }
+    
+    size_t s = srcTimePoint - src.mFirstTimePoint;
+    float distance      = src.mDistance[s];
+    float bearingAngle  = src.mBearingAngle[s];
+    
+    size_t i = this->slot(dstTimePoint);
+    this->mDistance[i]      = distance;
+    this->mBearingAngle[i]  = bearingAngle;
+    this->mFlags[i]         = flags;
+}
+
+void LandmarkSeries::erase(const unsigned int timePoint)
+{
+    if(this->getFlags(timePoint) != 0)
+    {
+        this->mFlags[timePoint - this->mFirstTimePoint] = 0;
+    }
+}
+
+void LandmarkSeries::clear()
+{
+    this->mFirstTimePoint = 0;
+    std::vector<float>().swap(this->mDistance);
+    std::vector<float>().swap(this->mBearingAngle);
+    std::vector<unsigned char>().swap(this->mFlags);
+}
+
+unsigned char LandmarkSeries::getFlags(const unsigned int timePoint) const
+{
+    if(timePoint < this->mFirstTimePoint || timePoint - this->mFirstTimePoint >= this->mFlags.size())
+    {
+        return 0;
+    }
+    return this->mFlags[timePoint - this->mFirstTimePoint];
+}
+
+size_t LandmarkSeries::slot(const unsigned int timePoint)
+{
+    if(this->mFlags.empty())
+    {
+        this->mFirstTimePoint = timePoint;
+    }
+    else if(timePoint < this->mFirstTimePoint)
+    {
+        size_t n = this->mFirstTimePoint - timePoint;
+        this->mDistance.insert(this->mDistance.begin(), n, 0.0f);
+        this->mBearingAngle.insert(this->mBearingAngle.begin(), n, 0.0f);
+        this->mFlags.insert(this->mFlags.begin(), n, 0);
+        this->mFirstTimePoint = timePoint;
+    }
+    
+    size_t i = timePoint - this->mFirstTimePoint;
+    if(i >= this->mFlags.size())
+    {
+        this->mDistance.resize(i + 1, 0.0f);
+        this->mBearingAngle.resize(i + 1, 0.0f);
+        this->mFlags.resize(i + 1, 0);
+    }
+    
+    return i;
+}
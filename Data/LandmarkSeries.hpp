@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef LANDMARKSERIES_HPP
+#define LANDMARKSERIES_HPP
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief The LandmarkSeries class stores the landmark related features (distance, in-landmark indicator and
+ *        bearing angle) of one larva with respect to one landmark.
+ *
+ * The values are stored densely over the covered time span (one float per feature and one flag byte per time
+ * point), so access by time point is O(1) and a sample needs 9 bytes. Every feature has its own flag, thus the
+ * distance and the bearing angle can exist independently (e.g. the bearing angle needs a tail point).
+ */
+class LandmarkSeries
+{
+public:
+    LandmarkSeries();
+    
+    void setDistance(unsigned int const timePoint, double const distance, bool const isInLandmark);
+    void setBearingAngle(unsigned int const timePoint, double const bearingAngle);
+    
+    bool getDistance(unsigned int const timePoint, double& retDistance) const;
+    bool getIsInLandmark(unsigned int const timePoint, bool& retIsInLandmark) const;
+    bool getBearingAngle(unsigned int const timePoint, double& retBearingAngle) const;
+    
+    /**
+     * @brief copy copies all values of src at srcTimePoint to dstTimePoint (values missing in src are removed)
+     * @param src series to copy from (may be this series)
+     */
+    void copy(LandmarkSeries const& src, unsigned int const srcTimePoint, unsigned int const dstTimePoint);
+    
+    void erase(unsigned int const timePoint);
+    void clear();
+    bool empty() const {return this->mFlags.empty();}
+    
+private:
+    enum Flags
+    {
+        HAS_DISTANCE        = 1,
+        IS_IN_LANDMARK      = 2,
+        HAS_BEARING_ANGLE   = 4
+    };
+    
+    unsigned char getFlags(unsigned int const timePoint) const;
+    
+    /**
+     * @brief slot returns the index of the given time point and extends the covered time span if necessary
+     */
+    size_t slot(unsigned int const timePoint);
+    
+    unsigned int                mFirstTimePoint;
+    std::vector<float>          mDistance;
+    std::vector<float>          mBearingAngle;
+    std::vector<unsigned char>  mFlags;
+};
+
+#endif // LANDMARKSERIES_HPP
@@ -42,32 +42,140 @@ Larva::Larva()
 {
 }
 
-void Larva::setParameters(const std::map<unsigned int, ValuesType> &parameters)
+void Larva::setParameters(ParameterMap const& parameters)
 {
     this->parameters = parameters;
 }
 
 bool Larva::setSpineAt(const unsigned int timePoint, FIMTypes::spine_t const& spine)
 {
-    map<unsigned int, ValuesType>::iterator it;
     bool exists = false;
     
-    it = parameters.find(timePoint);
-    if(it != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        it->second.spine = spine;
+        parameters.setSpine(timePoint, spine);
         exists = true;
     }
     
     return exists;
 }
 
+void Larva::setLandmarkDistanceAt(const unsigned int timePoint, const int landmarkID, const double distance, const bool isInLandmark)
+{
+    if(static_cast<size_t>(landmarkID) >= landmarks.size())
+    {
+        landmarks.resize(landmarkID + 1);
+    }
+    landmarks[landmarkID].setDistance(timePoint, distance, isInLandmark);
+}
+
+void Larva::setLandmarkBearingAngleAt(const unsigned int timePoint, const int landmarkID, const double bearingAngle)
+{
+    if(static_cast<size_t>(landmarkID) >= landmarks.size())
+    {
+        landmarks.resize(landmarkID + 1);
+    }
+    landmarks[landmarkID].setBearingAngle(timePoint, bearingAngle);
+}
+
+void Larva::copyLandmarkValues(const Larva &src, const unsigned int srcTimePoint, const unsigned int dstTimePoint)
+{
+    if(src.landmarks.size() > landmarks.size())
+    {
+        landmarks.resize(src.landmarks.size());
+    }
+    
+    // index based: src may be this larva
+    for(size_t i = 0; i < landmarks.size(); ++i)
+    {
+        if(i < src.landmarks.size())
+        {
+            landmarks[i].copy(src.landmarks[i], srcTimePoint, dstTimePoint);
+        }
+        else
+        {
+            landmarks[i].erase(dstTimePoint);
+        }
+    }
+}
+
+void Larva::eraseLandmarkValuesAt(const unsigned int timePoint)
+{
+    for(size_t i = 0; i < landmarks.size(); ++i)
+    {
+        landmarks[i].erase(timePoint);
+    }
+}
+
+void Larva::removeLandmark(const int landmarkID)
+{
+    if(landmarkID >= 0 && static_cast<size_t>(landmarkID) < landmarks.size())
+    {
+        landmarks[landmarkID].clear();
+    }
+}
+
+bool Larva::getValuesAt(const unsigned int timePoint, ValuesType &retValues) const
+{
+    if(parameters.count(timePoint) == 0)
+    {
+        return false;
+    }
+    
+    retValues.spine                 = parameters.getSpine(timePoint);
+    retValues.momentum              = parameters.getMomentum(timePoint);
+    retValues.area                  = parameters.getValue(TrackColumns::AREA, timePoint);
+    retValues.spineRadii            = parameters.getSpineRadii(timePoint);
+    retValues.mainBodyBendingAngle  = parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, timePoint);
+    retValues.spineLength           = parameters.getValue(TrackColumns::SPINE_LENGTH, timePoint);
+    retValues.perimeter             = parameters.getValue(TrackColumns::PERIMETER, timePoint);
+    retValues.isCoiled              = parameters.getIndicator(TrackColumns::IS_COILED, timePoint);
+    retValues.isWellOriented        = parameters.getIndicator(TrackColumns::IS_WELL_ORIENTED, timePoint);
+    retValues.distToOrigin          = parameters.getValue(TrackColumns::DIST_TO_ORIGIN, timePoint);
+    retValues.momentumDist          = parameters.getValue(TrackColumns::MOMENTUM_DIST, timePoint);
+    retValues.accDist               = parameters.getValue(TrackColumns::ACC_DIST, timePoint);
+    retValues.goPhase               = parameters.getGoPhase(timePoint);
+    retValues.isLeftBended          = parameters.getIndicator(TrackColumns::IS_LEFT_BENDED, timePoint);
+    retValues.isRightBended         = parameters.getIndicator(TrackColumns::IS_RIGHT_BENDED, timePoint);
+    retValues.movementDirection     = parameters.getValue(TrackColumns::MOVEMENT_DIRECTION, timePoint);
+    retValues.velosity              = parameters.getValue(TrackColumns::VELOSITY, timePoint);
+    retValues.acceleration          = parameters.getValue(TrackColumns::ACCELERATION, timePoint);
+    retValues.nearestNeighbourDist  = parameters.getValue(TrackColumns::NEAREST_NEIGHBOUR_DIST, timePoint);
+    retValues.neighbourCount        = parameters.getNeighbourCount(timePoint);
+    
+    return true;
+}
+
+void Larva::setValuesAt(const unsigned int timePoint, const ValuesType &values)
+{
+    parameters.setSpine(timePoint, values.spine);
+    parameters.setMomentum(timePoint, values.momentum);
+    parameters.setValue(TrackColumns::AREA, timePoint, values.area);
+    parameters.setSpineRadii(timePoint, values.spineRadii);
+    parameters.setValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, timePoint, values.mainBodyBendingAngle);
+    parameters.setValue(TrackColumns::SPINE_LENGTH, timePoint, values.spineLength);
+    parameters.setValue(TrackColumns::PERIMETER, timePoint, values.perimeter);
+    parameters.setIndicator(TrackColumns::IS_COILED, timePoint, values.isCoiled);
+    parameters.setIndicator(TrackColumns::IS_WELL_ORIENTED, timePoint, values.isWellOriented);
+    parameters.setValue(TrackColumns::DIST_TO_ORIGIN, timePoint, values.distToOrigin);
+    parameters.setValue(TrackColumns::MOMENTUM_DIST, timePoint, values.momentumDist);
+    parameters.setValue(TrackColumns::ACC_DIST, timePoint, values.accDist);
+    parameters.setGoPhase(timePoint, values.goPhase);
+    parameters.setIndicator(TrackColumns::IS_LEFT_BENDED, timePoint, values.isLeftBended);
+    parameters.setIndicator(TrackColumns::IS_RIGHT_BENDED, timePoint, values.isRightBended);
+    parameters.setValue(TrackColumns::MOVEMENT_DIRECTION, timePoint, values.movementDirection);
+    parameters.setValue(TrackColumns::VELOSITY, timePoint, values.velosity);
+    parameters.setValue(TrackColumns::ACCELERATION, timePoint, values.acceleration);
+    parameters.setValue(TrackColumns::NEAREST_NEIGHBOUR_DIST, timePoint, values.nearestNeighbourDist);
+    parameters.setNeighbourCount(timePoint, values.neighbourCount);
+}
+
 std::vector<cv::Point> Larva::getAllMidPoints() const
 {
     std::vector<cv::Point> midPoints;
-    for (std::map<unsigned int, ValuesType>::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
+    for (ParameterMap::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
     {
-        midPoints.push_back(it->second.spine.at(this->getSpineMidPointIndex()));
+        midPoints.push_back(parameters.getSpinePoint(*it, this->getSpineMidPointIndex()));
     }
     
     return midPoints;
@@ -76,9 +184,9 @@ std::vector<cv::Point> Larva::getAllMidPoints() const
 std::vector<cv::Point> Larva::getAllHeadPoints() const
 {
     std::vector<cv::Point> headPoints;
-    for (std::map<unsigned int, ValuesType>::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
+    for (ParameterMap::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
     {
-        headPoints.push_back(it->second.spine.at(0));
+        headPoints.push_back(parameters.getSpinePoint(*it, 0));
     }
     
     return headPoints;
@@ -87,9 +195,9 @@ std::vector<cv::Point> Larva::getAllHeadPoints() const
 std::vector<cv::Point> Larva::getAllTailPoints() const
 {
     std::vector<cv::Point> tailPoints;
-    for (std::map<unsigned int, ValuesType>::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
+    for (ParameterMap::const_iterator it = parameters.begin(); it!=parameters.end(); ++it)
     {
-        tailPoints.push_back(it->second.spine.at(this->nSpinePoints-1));
+        tailPoints.push_back(parameters.getSpinePoint(*it, this->nSpinePoints-1));
     }
     
     return tailPoints;
@@ -98,9 +206,9 @@ std::vector<cv::Point> Larva::getAllTailPoints() const
 std::vector<unsigned int> Larva::getAllTimeSteps() const
 {
     std::vector<unsigned int> allTimeSteps;
-    for (std::map<unsigned int,ValuesType>::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
+    for (ParameterMap::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
     {
-        allTimeSteps.push_back(it->first);
+        allTimeSteps.push_back(*it);
     }
     
     return allTimeSteps;
@@ -108,23 +216,7 @@ std::vector<unsigned int> Larva::getAllTimeSteps() const
 
 void Larva::invert(uint time)
 {
-    if(this->parameters.find(time) != this->parameters.end())
-    {
-        cv::Point p1;
-        cv::Point p2;
-        FIMTypes::spine_t spine = this->parameters[time].spine;
-        
-        for(size_t i = 0; i < spine.size() / 2; ++i)
-        {
-            p1 = spine.at(i);
-            p2 = spine.at(spine.size() - 1 - i);
-            
-            spine[i] = p2;
-            spine[spine.size() - 1 - i] = p1;
-        }
-        
-        this->parameters[time].spine = spine;
-    }
+    this->parameters.reverseSpine(time, false);
 }
 
 int Larva::getXorY(const Point &pt, unsigned int dimension) const
@@ -141,13 +233,11 @@ int Larva::getXorY(const Point &pt, unsigned int dimension) const
 // getter methods
 bool Larva::getSpineAt(unsigned int const timePoint, FIMTypes::spine_t & retSpine) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retSpine = cIt->second.spine;
+        retSpine = parameters.getSpine(timePoint);
         exists = true;
     }
     
@@ -168,13 +258,11 @@ bool Larva::getSpineMidPointAt(const unsigned int timePoint, Point& retSpineMidP
 
 bool Larva::getMomentumAt(const unsigned int timePoint, Point & retMomentum) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retMomentum = cIt->second.momentum;
+        retMomentum = parameters.getMomentum(timePoint);
         exists = true;
     }
     
@@ -183,13 +271,11 @@ bool Larva::getMomentumAt(const unsigned int timePoint, Point & retMomentum) con
 
 bool Larva::getHeadAt(const unsigned int timePoint, Point& retHead) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retHead = cIt->second.spine.front();
+        retHead = parameters.getSpinePoint(timePoint, 0);
         exists = true;
     }
     
@@ -198,13 +284,11 @@ bool Larva::getHeadAt(const unsigned int timePoint, Point& retHead) const
 
 bool Larva::getTailAt(const unsigned int timePoint, Point& retTail) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retTail = cIt->second.spine.back();
+        retTail = parameters.getSpinePoint(timePoint, parameters.getSpineSize(timePoint) - 1);
         exists = true;
     }
     
@@ -213,13 +297,11 @@ bool Larva::getTailAt(const unsigned int timePoint, Point& retTail) const
 
 bool Larva::getAreaAt(const unsigned int timePoint, double &retArea) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retArea = cIt->second.area;
+        retArea = parameters.getValue(TrackColumns::AREA, timePoint);
         exists = true;
     }
     
@@ -228,13 +310,11 @@ bool Larva::getAreaAt(const unsigned int timePoint, double &retArea) const
 
 bool Larva::getVelosityAt(const unsigned int timePoint, double &retVelosity) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retVelosity = cIt->second.velosity;
+        retVelosity = parameters.getValue(TrackColumns::VELOSITY, timePoint);
         exists = true;
     }
     
@@ -243,28 +323,24 @@ bool Larva::getVelosityAt(const unsigned int timePoint, double &retVelosity) con
 
 bool Larva::getAccelerationAt(const unsigned int timePoint, double &retAcceleration) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end() /*&& cIt->second.acceleration != std::numeric_limits<double>::min()*/)
+    if(parameters.count(timePoint) > 0 /*&& parameters.getValue(TrackColumns::ACCELERATION, timePoint) != std::numeric_limits<double>::min()*/)
     {
-        retAcceleration = cIt->second.acceleration;
+        retAcceleration = parameters.getValue(TrackColumns::ACCELERATION, timePoint);
         exists = true;
     }
     
     return exists;
 }
 
-bool Larva::getSpineRadiiAt(const unsigned int timePoint, vector<double> & retSpineRadii) const
+bool Larva::getSpineRadiiAt(const unsigned int timePoint, FIMTypes::radii_t & retSpineRadii) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retSpineRadii = cIt->second.spineRadii;
+        retSpineRadii = parameters.getSpineRadii(timePoint);
         exists = true;
     }
     
@@ -273,13 +349,11 @@ bool Larva::getSpineRadiiAt(const unsigned int timePoint, vector<double> & retSp
 
 bool Larva::getMainBodyBendingAngleAt(const unsigned int timePoint, double &retMainBodyBendingAngle) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retMainBodyBendingAngle = cIt->second.mainBodyBendingAngle;
+        retMainBodyBendingAngle = parameters.getValue(TrackColumns::MAIN_BODY_BENDING_ANGLE, timePoint);
         exists = true;
     }
     
@@ -288,13 +362,11 @@ bool Larva::getMainBodyBendingAngleAt(const unsigned int timePoint, double &retM
 
 bool Larva::getIsCoiledIndicatorAt(const unsigned int timePoint, bool &retIsCoiledIndicator) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retIsCoiledIndicator = cIt->second.isCoiled;
+        retIsCoiledIndicator = parameters.getIndicator(TrackColumns::IS_COILED, timePoint);
         exists = true;
     }
     
@@ -303,13 +375,11 @@ bool Larva::getIsCoiledIndicatorAt(const unsigned int timePoint, bool &retIsCoil
 
 bool Larva::getIsWellOrientedAt(const unsigned int timePoint, bool &retIsWellOriented) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retIsWellOriented = cIt->second.isWellOriented;
+        retIsWellOriented = parameters.getIndicator(TrackColumns::IS_WELL_ORIENTED, timePoint);
         exists = true;
     }
     
@@ -318,13 +388,11 @@ bool Larva::getIsWellOrientedAt(const unsigned int timePoint, bool &retIsWellOri
 
 bool Larva::getSpineLengthAt(unsigned int const timePoint, double &retSpineLength) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retSpineLength = cIt->second.spineLength;
+        retSpineLength = parameters.getValue(TrackColumns::SPINE_LENGTH, timePoint);
         exists = true;
     }
     return exists;
@@ -332,13 +400,11 @@ bool Larva::getSpineLengthAt(unsigned int const timePoint, double &retSpineLengt
 
 bool Larva::getPerimeterAt(const unsigned int timePoint, double &retPerimeter) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retPerimeter = cIt->second.perimeter;
+        retPerimeter = parameters.getValue(TrackColumns::PERIMETER, timePoint);
         exists = true;
     }
     return exists;
@@ -346,13 +412,11 @@ bool Larva::getPerimeterAt(const unsigned int timePoint, double &retPerimeter) c
 
 bool Larva::getMomentumDistAt(const unsigned int timePoint, double &retMomentumDist) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retMomentumDist = cIt->second.momentumDist;
+        retMomentumDist = parameters.getValue(TrackColumns::MOMENTUM_DIST, timePoint);
         exists = true;
     }
     return exists;
@@ -360,13 +424,11 @@ bool Larva::getMomentumDistAt(const unsigned int timePoint, double &retMomentumD
 
 bool Larva::getDistToOriginAt(const unsigned int timePoint, double &retDistToOrigin) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retDistToOrigin = cIt->second.distToOrigin;
+        retDistToOrigin = parameters.getValue(TrackColumns::DIST_TO_ORIGIN, timePoint);
         exists = true;
     }
     return exists;
@@ -374,13 +436,11 @@ bool Larva::getDistToOriginAt(const unsigned int timePoint, double &retDistToOri
 
 bool Larva::getGoPhaseIndicatorAt(const unsigned int timePoint, int &retGoPhaseIndicator) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        int tmpGoPhaseIndicator = cIt->second.goPhase;
+        int tmpGoPhaseIndicator = parameters.getGoPhase(timePoint);
         if (tmpGoPhaseIndicator != -1)
         {
             retGoPhaseIndicator = tmpGoPhaseIndicator;
@@ -392,13 +452,11 @@ bool Larva::getGoPhaseIndicatorAt(const unsigned int timePoint, int &retGoPhaseI
 
 bool Larva::getLeftBendingIndicatorAt(const unsigned int timePoint, bool &retLeftBended) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retLeftBended = cIt->second.isLeftBended;
+        retLeftBended = parameters.getIndicator(TrackColumns::IS_LEFT_BENDED, timePoint);
         exists = true;
     }
     
@@ -407,13 +465,11 @@ bool Larva::getLeftBendingIndicatorAt(const unsigned int timePoint, bool &retLef
 
 bool Larva::getRightBendingIndicatorAt(const unsigned int timePoint, bool &retRightBended) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retRightBended = cIt->second.isRightBended;
+        retRightBended = parameters.getIndicator(TrackColumns::IS_RIGHT_BENDED, timePoint);
         exists = true;
     }
     
@@ -422,13 +478,11 @@ bool Larva::getRightBendingIndicatorAt(const unsigned int timePoint, bool &retRi
 
 bool Larva::getMovementDirectionAt(const unsigned int timePoint, double &retMovementDirection) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        double tmpMovementDirection = cIt->second.movementDirection;
+        double tmpMovementDirection = parameters.getValue(TrackColumns::MOVEMENT_DIRECTION, timePoint);
         if(tmpMovementDirection != -1)
         {
             retMovementDirection = tmpMovementDirection;
@@ -441,70 +495,56 @@ bool Larva::getMovementDirectionAt(const unsigned int timePoint, double &retMove
 
 bool Larva::getDistanceToLandmark(const unsigned int timePoint, std::string landmarkName, double &retDistanceToLandmark) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
-    bool exists = false;
-    
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    return this->getDistanceToLandmark(timePoint, LandmarkRegistry::getID(landmarkName), retDistanceToLandmark);
+}
+
+bool Larva::getBearingAngleToLandmark(const unsigned int timePoint, std::string landmarkName, double &retBearingAngleToLandmark) const
+{
+    return this->getBearingAngleToLandmark(timePoint, LandmarkRegistry::getID(landmarkName), retBearingAngleToLandmark);
+}
+
+bool Larva::getIsInLandmarkIndicator(const unsigned int timePoint, std::string landmarkName, bool &retIsInLandmark) const
+{
+    return this->getIsInLandmarkIndicator(timePoint, LandmarkRegistry::getID(landmarkName), retIsInLandmark);
+}
+
+bool Larva::getDistanceToLandmark(const unsigned int timePoint, const int landmarkID, double &retDistanceToLandmark) const
+{
+    if(landmarkID < 0 || static_cast<size_t>(landmarkID) >= landmarks.size() || parameters.count(timePoint) == 0)
     {
-        std::map<std::string, double> tmpMovementDirection = cIt->second.distanceToLandmark;
-        if(tmpMovementDirection.find(landmarkName) != tmpMovementDirection.end())
-        {
-            retDistanceToLandmark = tmpMovementDirection[landmarkName];
-            exists = true;
-        }
+        return false;
     }
     
-    return exists;
+    return landmarks[landmarkID].getDistance(timePoint, retDistanceToLandmark);
 }
 
-bool Larva::getBearingAngleToLandmark(const unsigned int timePoint, std::string landmarkName, double &retBearingAngleToLandmark) const
+bool Larva::getBearingAngleToLandmark(const unsigned int timePoint, const int landmarkID, double &retBearingAngleToLandmark) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
-    bool exists = false;
-    
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(landmarkID < 0 || static_cast<size_t>(landmarkID) >= landmarks.size() || parameters.count(timePoint) == 0)
     {
-        std::map<std::string, double> tmpBearingAngle = cIt->second.bearinAngle;
-        if(tmpBearingAngle.find(landmarkName) != tmpBearingAngle.end())
-        {
-            retBearingAngleToLandmark = tmpBearingAngle[landmarkName];
-            exists = true;
-        }
+        return false;
     }
     
-    return exists;
+    return landmarks[landmarkID].getBearingAngle(timePoint, retBearingAngleToLandmark);
 }
 
-bool Larva::getIsInLandmarkIndicator(const unsigned int timePoint, std::string landmarkName, bool &retIsInLandmark) const
+bool Larva::getIsInLandmarkIndicator(const unsigned int timePoint, const int landmarkID, bool &retIsInLandmark) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
-    bool exists = false;
-    
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(landmarkID < 0 || static_cast<size_t>(landmarkID) >= landmarks.size() || parameters.count(timePoint) == 0)
     {
-        std::map<std::string, bool> tmpIsInLandmark = cIt->second.isInLandmark;
-        if(tmpIsInLandmark.find(landmarkName) != tmpIsInLandmark.end())
-        {
-            retIsInLandmark = tmpIsInLandmark[landmarkName];
-            exists = true;
-        }
+        return false;
     }
     
-    return exists;
+    return landmarks[landmarkID].getIsInLandmark(timePoint, retIsInLandmark);
 }
 
 bool Larva::getSpinePointAt(const unsigned int timePoint, const unsigned int index, Point &spinePoint) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end() && cIt->second.spine.size() > index)
+    if(parameters.count(timePoint) > 0 && parameters.getSpineSize(timePoint) > index)
     {
-        spinePoint = cIt->second.spine.at(index);
+        spinePoint = parameters.getSpinePoint(timePoint, index);
         exists = true;
     }
     return exists;
@@ -512,13 +552,11 @@ bool Larva::getSpinePointAt(const unsigned int timePoint, const unsigned int ind
 
 bool Larva::getAccDistAt(const unsigned int timePoint, double &retAccDist) const
 {
-    map<unsigned int, ValuesType>::const_iterator cIt;
     bool exists = false;
     
-    cIt = parameters.find(timePoint);
-    if(cIt != parameters.end())
+    if(parameters.count(timePoint) > 0)
     {
-        retAccDist = cIt->second.accDist;
+        retAccDist = parameters.getValue(TrackColumns::ACC_DIST, timePoint);
         exists = true;
     }
     return exists;
@@ -584,7 +622,7 @@ string Larva::getStrSpine(const unsigned int timePoint, const unsigned int index
 string Larva::getStrSpineRadius(const unsigned int timePoint, const unsigned int index) const
 {
     std::stringstream ss;
-    vector<double> radii;
+    FIMTypes::radii_t radii;
     if(getSpineRadiiAt(timePoint,radii))
     {
         ss << radii.at(index);
@@ -768,3 +806,36 @@ std::string Larva::getStrBearingAngleToLandmark(const unsigned int timePoint, st
     }
     return ss.str();
 }
+
+std::string Larva::getStrDistanceToLandmark(const unsigned int timePoint, const int landmarkID) const
+{
+    std::stringstream ss;
+    double distanceToLandmark;
+    if(getDistanceToLandmark(timePoint, landmarkID, distanceToLandmark))
+    {
+        ss << distanceToLandmark;
+    }
+    return ss.str();
+}
+
+std::string Larva::getStrIsInLandmark(const unsigned int timePoint, const int landmarkID) const
+{
+    std::stringstream ss;
+    bool isInLandmark;
+    if(getIsInLandmarkIndicator(timePoint, landmarkID, isInLandmark))
+    {
+        ss << isInLandmark;
+    }
+    return ss.str();
+}
+
+std::string Larva::getStrBearingAngleToLandmark(const unsigned int timePoint, const int landmarkID) const
+{
+    std::stringstream ss;
+    double bearingAngle;
+    if(getBearingAngleToLandmark(timePoint, landmarkID, bearingAngle))
+    {
+        ss << bearingAngle;
+    }
+    return ss.str();
+}
@@ -42,6 +42,10 @@
 #include <cmath>
 
 #include "RawLarva.hpp"
+#include "MotionModel.hpp"
+#include "TrackColumns.hpp"
+#include "LandmarkRegistry.hpp"
+#include "LandmarkSeries.hpp"
 
 
 /**
@@ -60,7 +64,8 @@
  *
  * Basic structure of the Larva class:
  * The main parameter is the parameters map. This map associates time points with measurements with values
- * (i.e. features). All values are collected in the ValuesStruct, thus the paremeters map is defined by:
+ * (i.e. features) and stores every feature in its own column (see TrackColumns). All values of a time point are
+ * collected in the ValuesType struct (see getValuesAt and setValuesAt), thus the paremeters map is defined by:
  * parameters: (time point) -> (values)
  *
  * To avoid access to values at time points where the larva do not exists, getter methods are used for access.
@@ -103,7 +108,7 @@ public:
         /**
          * @brief spineRadii radii of all spine points (specifying the thickness of the larva)
          */
-        std::vector<double> spineRadii;
+        FIMTypes::radii_t spineRadii;
         /**
          * @brief mainBodyBendingAngle the main body bending angle (calculated on the first, middle and last spine point)
          */
@@ -170,22 +175,21 @@ public:
          */
         double acceleration;
         /**
-         * @brief distanceToLandmark
+         * @brief nearestNeighbourDist distance to the nearest other larva of the same frame (-1 if there is none; see GroupMetrics)
          */
-        std::map<std::string, double>   distanceToLandmark;
-        
-        /**
-         * @brief isInLandmark
-         */
-        std::map<std::string, bool>     isInLandmark;
-        
+        double nearestNeighbourDist;
         /**
-         * @brief isInLandmark
+         * @brief neighbourCount number of other larvae within GeneralParameters::dGroupNeighbourRadius (see GroupMetrics)
          */
-        std::map<std::string, double>     bearinAngle;
+        int neighbourCount;
         
     } values;
     
+    /**
+     * @brief ParameterMap stores the values of all time points column by column (see TrackColumns)
+     */
+    typedef TrackColumns ParameterMap;
+    
     // Parameters:
     
     /**
@@ -195,13 +199,78 @@ public:
      * to catch access to features at time points in which the larva do not exist (see getter
      * methods below).
      */
-    std::map<unsigned int, ValuesType> parameters;
+    ParameterMap parameters;
+    
+    /**
+     * @brief landmarks stores the landmark related features (distance, in-landmark indicator and bearing angle)
+     *        indexed by the landmark ID (see LandmarkRegistry); the series of unknown or removed landmarks are empty
+     */
+    std::vector<LandmarkSeries> landmarks;
     
     /**
      * @brief contour is the last detected contour of this larva
      */
     FIMTypes::contour_t contour;
     
+    /**
+     * @brief deferredContours stores the contours of all time points for which the spine calculation
+     *        was deferred (see LarvaeExtractionParameters::bUseLazySpineCalculation). The contours
+     *        are removed as soon as the spines are calculated.
+     */
+    std::map<unsigned int, FIMTypes::contour_t> deferredContours;
+    
+    /**
+     * @brief motion constant velocity model of the momentum used to predict the position in the next frame
+     *        (only updated if LarvaeExtractionParameters::AssignmentParameters::bUseMotionPrediction is set)
+     */
+    MotionModel motion;
+    
+    /**
+     * @brief The PostProcessingState struct stores the progress of the online post-processing of this larva
+     *        (see LarvaeContainer::updateOnlinePostProcessing)
+     */
+    struct PostProcessingState
+    {
+        PostProcessingState() : 
+            isOnline(false), 
+            isClosed(false), 
+            firstOpenTimePoint(0), 
+            firstUnorientedTimePoint(0), 
+            runOpen(false), 
+            runFrom(0), 
+            runCounter(0), 
+            runIndicator(0), 
+            runApplied(false)
+        {}
+        
+        /**
+         * @brief isOnline the larva is post-processed online, isClosed the track ended and all time points are final
+         */
+        bool            isOnline;
+        bool            isClosed;
+        
+        /**
+         * @brief firstOpenTimePoint all time points before are final
+         */
+        unsigned int    firstOpenTimePoint;
+        
+        /**
+         * @brief firstUnorientedTimePoint all time points before have their final head/tail orientation
+         */
+        unsigned int    firstUnorientedTimePoint;
+        
+        /**
+         * @brief runOpen, runFrom current sequence of non-coiled time points (starting at runFrom); runCounter and
+         *        runIndicator are the state of the movement based head/tail recognition over this sequence
+         *        (runIndicator is 0 as long as it is undecided), runApplied is set as soon as the indicator is final
+         */
+        bool            runOpen;
+        unsigned int    runFrom;
+        unsigned int    runCounter;
+        int             runIndicator;
+        bool            runApplied;
+    } postProcessing;
+    
     /**
      * @brief operator << is overloaded to store larva into files (i.e. fs << larva)
      * @param fs the file storage in which the (whole larva object) should be stored
@@ -244,7 +313,7 @@ public:
      * @brief setParameters sets the parameters map for this larva (used for loading larvae from files)
      * @param parameters the parameters map
      */
-    void setParameters(std::map<unsigned int, ValuesType> const & parameters);
+    void setParameters(ParameterMap const & parameters);
     /**
      * @brief setNSpinePoints sets the number of spine points parameter (used for loading larvae form files)
      * @param nSpinePoints the number of spine poits used for the discretized spine
@@ -255,6 +324,24 @@ public:
     
     bool setSpineAt(unsigned int const timePoint, FIMTypes::spine_t const& spine);
     
+    /**
+     * @brief setLandmarkDistanceAt sets the distance to the landmark with the given ID (see LandmarkRegistry)
+     */
+    void setLandmarkDistanceAt(unsigned int const timePoint, int const landmarkID, double const distance, bool const isInLandmark);
+    void setLandmarkBearingAngleAt(unsigned int const timePoint, int const landmarkID, double const bearingAngle);
+    
+    /**
+     * @brief copyLandmarkValues copies the landmark related features of src at srcTimePoint to dstTimePoint
+     * @param src larva to copy from (may be this larva)
+     */
+    void copyLandmarkValues(Larva const& src, unsigned int const srcTimePoint, unsigned int const dstTimePoint);
+    void eraseLandmarkValuesAt(unsigned int const timePoint);
+    
+    /**
+     * @brief removeLandmark drops all features related to the landmark with the given ID
+     */
+    void removeLandmark(int const landmarkID);
+    
     // getter methods
     unsigned int getNSpinePoints() const {return nSpinePoints;}
     
@@ -268,6 +355,32 @@ public:
     
     std::vector<unsigned int> getAllTimeSteps(void) const;
     
+    /**
+     * @brief getValuesAt collects all values of a time point from the columns of the parameters map
+     * @return false if the larva does not exist at timePoint
+     */
+    bool getValuesAt(unsigned int const timePoint, ValuesType & retValues) const;
+    
+    /**
+     * @brief setValuesAt stores all values of a time point (the time point is inserted if necessary)
+     */
+    void setValuesAt(unsigned int const timePoint, ValuesType const& values);
+    
+    /**
+     * @brief isFinalAt returns true if the values of the time point are not changed by the post-processing anymore
+     *        (always true for larvae which are not post-processed online)
+     */
+    bool isFinalAt(unsigned int const timePoint) const
+    {
+        return !this->postProcessing.isOnline || this->postProcessing.isClosed || timePoint < this->postProcessing.firstOpenTimePoint;
+    }
+    
+    /**
+     * @brief getFirstTimePoint, getLastTimePoint time span of the larva (only meaningful if the larva has parameters)
+     */
+    unsigned int getFirstTimePoint() const {return this->parameters.getFirstTimePoint();}
+    unsigned int getLastTimePoint() const {return this->parameters.getFirstTimePoint() + static_cast<unsigned int>(this->parameters.getSpan()) - 1;}
+    
     void invert(uint time);
     
     cv::Point getOrigin() const {return this->origin;}
@@ -279,7 +392,7 @@ public:
     bool getAreaAt(unsigned int const timePoint, double & retArea) const;
     bool getVelosityAt(unsigned int const timePoint, double & retVelosity) const;
     bool getAccelerationAt(unsigned int const timePoint, double & retAcceleration) const;
-    bool getSpineRadiiAt(unsigned int const timePoint, std::vector<double> & retSpineRadii) const;
+    bool getSpineRadiiAt(unsigned int const timePoint, FIMTypes::radii_t & retSpineRadii) const;
     bool getMainBodyBendingAngleAt(unsigned int const timePoint, double & retMainBodyBendingAngle) const;
     bool getIsCoiledIndicatorAt(unsigned int const timePoint, bool & retIsCoiledIndicator) const;
     bool getIsWellOrientedAt(unsigned int const timePoint, bool & retIsWellOriented) const;
@@ -295,6 +408,9 @@ public:
     bool getDistanceToLandmark(unsigned int const timePoint, std::string landmarkName, double & retDistanceToLandmark) const;
     bool getBearingAngleToLandmark(unsigned int const timePoint, std::string landmarkName, double & retBearingAngleToLandmark) const;
     bool getIsInLandmarkIndicator(unsigned int const timePoint, std::string landmarkName, bool & retIsInLandmark) const;
+    bool getDistanceToLandmark(unsigned int const timePoint, int const landmarkID, double & retDistanceToLandmark) const;
+    bool getBearingAngleToLandmark(unsigned int const timePoint, int const landmarkID, double & retBearingAngleToLandmark) const;
+    bool getIsInLandmarkIndicator(unsigned int const timePoint, int const landmarkID, bool & retIsInLandmark) const;
     bool getSpinePointAt(unsigned int const timePoint, unsigned int const index, cv::Point & spinePoint) const;
     
     // string getter methods
@@ -319,6 +435,9 @@ public:
     std::string getStrDistanceToLandmark(unsigned int const timePoint, std::string landmarkName) const;
     std::string getStrIsInLandmark(unsigned int const timePoint, std::string landmarkName) const;
     std::string getStrBearingAngleToLandmark(unsigned int const timePoint, std::string landmarkName) const;
+    std::string getStrDistanceToLandmark(unsigned int const timePoint, int const landmarkID) const;
+    std::string getStrIsInLandmark(unsigned int const timePoint, int const landmarkID) const;
+    std::string getStrBearingAngleToLandmark(unsigned int const timePoint, int const landmarkID) const;
     
 private:
     int getXorY(cv::Point const & pt, unsigned int dimension) const;
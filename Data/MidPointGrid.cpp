@@ -0,0 +1,223 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "MidPointGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    bool compareByDistance(MidPointGrid::Neighbour const& a, MidPointGrid::Neighbour const& b)
+    {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    }
+    
+    bool compareByIndex(MidPointGrid::Neighbour const& a, MidPointGrid::Neighbour const& b)
+    {
+        return a.index < b.index;
+    }
+}
+
+MidPointGrid::MidPointGrid() : 
+    mOrigin(0, 0),
+    mCellSize(1.0),
+    mCols(0),
+    mRows(0)
+{
+}
+
+void MidPointGrid::build(const std::vector<cv::Point> &points, const double cellSize)
+{
+    this->mPoints = points;
+    this->mCellStart.clear();
+    this->mCellPoints.clear();
+    this->mCols = 0;
+    this->mRows = 0;
+    if(points.empty())
+    {
+        return;
+    }
+    
+    cv::Rect const bounds = cv::boundingRect(points);
+    this->mOrigin = bounds.tl();
+    
+    // limit the number of (mostly empty) cells to a few per point
+    double const maxCells = 4.0 * points.size() + 16.0;
+    this->mCellSize = std::max(1.0, cellSize);
+    while((std::floor(bounds.width / this->mCellSize) + 1) * (std::floor(bounds.height / this->mCellSize) + 1) > maxCells)
+    {
+        this->mCellSize *= 2.0;
+    }
+    this->mCols = static_cast<int>(bounds.width / this->mCellSize) + 1;
+    this->mRows = static_cast<int>(bounds.height / this->mCellSize) + 1;
+    
+    // counting sort of the points into the cells
+    std::vector<unsigned int> cells(points.size());
+    this->mCellStart.assign(static_cast<size_t>(this->mCols) * this->mRows + 1, 0);
+    for(size_t i = 0; i < points.size(); ++i)
+    {
+        cells[i] = static_cast<unsigned int>(this->getCellY(points[i].y) * this->mCols + this->getCellX(points[i].x));
+        ++this->mCellStart[cells[i] + 1];
+    }
+    for(size_t c = 1; c < this->mCellStart.size(); ++c)
+    {
+        this->mCellStart[c] += this->mCellStart[c - 1];
+    }
+    
+    std::vector<unsigned int> next(this->mCellStart.begin(), this->mCellStart.end() - 1);
+    this->mCellPoints.resize(points.size());
+    for(size_t i = 0; i < points.size(); ++i)
+    {
+        this->mCellPoints[next[cells[i]]++] = static_cast<unsigned int>(i);
+    }
+}
+
+double MidPointGrid::getCellSize(const std::vector<cv::Point> &points, const unsigned int nPointsPerCell)
+{
+    if(points.size() < 2)
+    {
+        return 1.0;
+    }
+    cv::Rect const bounds = cv::boundingRect(points);
+    double const area = static_cast<double>(bounds.width + 1) * (bounds.height + 1);
+    return std::sqrt(area * std::max(1u, nPointsPerCell) / points.size());
+}
+
+void MidPointGrid::findInRadius(const unsigned int i, const double radius, std::vector<Neighbour> &neighbours) const
+{
+    neighbours.clear();
+    if(i >= this->mPoints.size() || radius < 0.0)
+    {
+        return;
+    }
+    
+    cv::Point const& p = this->mPoints[i];
+    double const r = std::min(radius, 1e9);
+    this->addCellRange(i,
+                       this->getCellX(static_cast<int>(std::floor(p.x - r))),
+                       this->getCellY(static_cast<int>(std::floor(p.y - r))),
+                       this->getCellX(static_cast<int>(std::ceil(p.x + r))),
+                       this->getCellY(static_cast<int>(std::ceil(p.y + r))),
+                       neighbours);
+    
+    neighbours.erase(std::remove_if(neighbours.begin(), neighbours.end(),
+                                    [radius](Neighbour const& n) {return n.distance > radius;}),
+                     neighbours.end());
+    std::sort(neighbours.begin(), neighbours.end(), compareByIndex);
+}
+
+void MidPointGrid::findKNearest(const unsigned int i, const unsigned int k, std::vector<Neighbour> &neighbours) const
+{
+    neighbours.clear();
+    if(i >= this->mPoints.size() || k == 0)
+    {
+        return;
+    }
+    
+    // search rings of cells around the cell of the point until the k-th distance lies within the visited area
+    int const cx = this->getCellX(this->mPoints[i].x);
+    int const cy = this->getCellY(this->mPoints[i].y);
+    int const maxRing = std::max(std::max(cx, this->mCols - 1 - cx), std::max(cy, this->mRows - 1 - cy));
+    for(int ring = 0; ring <= maxRing; ++ring)
+    {
+        if(ring == 0)
+        {
+            this->addCellRange(i, cx, cy, cx, cy, neighbours);
+        }
+        else
+        {
+            this->addCellRange(i, cx - ring, cy - ring, cx + ring, cy - ring, neighbours);
+            this->addCellRange(i, cx - ring, cy + ring, cx + ring, cy + ring, neighbours);
+            this->addCellRange(i, cx - ring, cy - ring + 1, cx - ring, cy + ring - 1, neighbours);
+            this->addCellRange(i, cx + ring, cy - ring + 1, cx + ring, cy + ring - 1, neighbours);
+        }
+        
+        // all points outside of the visited rings are farther away than ring cell sizes
+        if(neighbours.size() >= k)
+        {
+            std::nth_element(neighbours.begin(), neighbours.begin() + (k - 1), neighbours.end(), compareByDistance);
+            if(neighbours[k - 1].distance < ring * this->mCellSize)
+            {
+                break;
+            }
+        }
+    }
+    
+    if(neighbours.size() > k)
+    {
+        std::nth_element(neighbours.begin(), neighbours.begin() + (k - 1), neighbours.end(), compareByDistance);
+        neighbours.resize(k);
+    }
+    std::sort(neighbours.begin(), neighbours.end(), compareByDistance);
+}
+
+int MidPointGrid::getCellX(const int x) const
+{
+    int const c = static_cast<int>(std::floor((x - this->mOrigin.x) / this->mCellSize));
+    return std::min(std::max(c, 0), this->mCols - 1);
+}
+
+int MidPointGrid::getCellY(const int y) const
+{
+    int const c = static_cast<int>(std::floor((y - this->mOrigin.y) / this->mCellSize));
+    return std::min(std::max(c, 0), this->mRows - 1);
+}
+
+void MidPointGrid::addCellRange(const unsigned int i, int x0, int y0, int x1, int y1, std::vector<Neighbour> &neighbours) const
+{
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, this->mCols - 1);
+    y1 = std::min(y1, this->mRows - 1);
+    
+    cv::Point const& p = this->mPoints[i];
+    for(int y = y0; y <= y1; ++y)
+    {
+        for(int x = x0; x <= x1; ++x)
+        {
+            size_t const c = static_cast<size_t>(y) * this->mCols + x;
+            for(unsigned int n = this->mCellStart[c]; n < this->mCellStart[c + 1]; ++n)
+            {
+                unsigned int const j = this->mCellPoints[n];
+                if(j != i)
+                {
+                    double const dx = static_cast<double>(p.x - this->mPoints[j].x);
+                    double const dy = static_cast<double>(p.y - this->mPoints[j].y);
+                    Neighbour neighbour = {j, std::sqrt(dx * dx + dy * dy)};
+                    neighbours.push_back(neighbour);
+                }
+            }
+        }
+    }
+}
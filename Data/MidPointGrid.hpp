@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef MIDPOINTGRID_HPP
+#define MIDPOINTGRID_HPP
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief The MidPointGrid class is a uniform grid index over the (spine mid) points of one frame.
+ *
+ * The points are bucketed into square cells, thus radius and nearest neighbour queries only visit the cells
+ * around the query point instead of all points. The grid is rebuilt for every frame; the buffers are reused.
+ */
+class MidPointGrid
+{
+public:
+    /**
+     * @brief The Neighbour struct result of a query (index of the point passed to build)
+     */
+    struct Neighbour
+    {
+        unsigned int index;
+        double distance;
+    };
+    
+    MidPointGrid();
+    
+    /**
+     * @brief build indexes the points
+     * @param points points of the frame (the query results refer to their indices)
+     * @param cellSize edge length of the cells in pixels (enlarged if the grid would have far more cells than points)
+     */
+    void build(std::vector<cv::Point> const& points, double const cellSize);
+    
+    /**
+     * @brief getCellSize returns a cell size for which the cells hold about nPointsPerCell points on average
+     */
+    static double getCellSize(std::vector<cv::Point> const& points, unsigned int const nPointsPerCell);
+    
+    /**
+     * @brief findInRadius finds all points within radius (inclusive) around the point with index i (excluding i)
+     * @param neighbours result sorted by index
+     */
+    void findInRadius(unsigned int const i, double const radius, std::vector<Neighbour>& neighbours) const;
+    
+    /**
+     * @brief findKNearest finds the k nearest points of the point with index i (excluding i)
+     * @param neighbours result sorted by distance (equal distances by index)
+     */
+    void findKNearest(unsigned int const i, unsigned int const k, std::vector<Neighbour>& neighbours) const;
+    
+    size_t size() const {return this->mPoints.size();}
+    
+private:
+    int getCellX(int const x) const;
+    int getCellY(int const y) const;
+    
+    /**
+     * @brief addCellRange adds the points of the cells [x0,x1]x[y0,y1] (clipped to the grid) except i to neighbours
+     */
+    void addCellRange(unsigned int const i, int x0, int y0, int x1, int y1, std::vector<Neighbour>& neighbours) const;
+    
+    std::vector<cv::Point> mPoints;
+    cv::Point mOrigin;
+    double mCellSize;
+    int mCols;
+    int mRows;
+    /**
+     * @brief mCellStart the points of cell c are mCellPoints[mCellStart[c]] ... mCellPoints[mCellStart[c+1]-1]
+     */
+    std::vector<unsigned int> mCellStart;
+    std::vector<unsigned int> mCellPoints;
+};
+
+#endif // MIDPOINTGRID_HPP
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#include "MotionModel.hpp"
+
+#include "Configuration/TrackerConfig.hpp"
+
+MotionModel::MotionModel() : 
+    mInitialized(false), 
+    mTimePoint(0), 
+    mPosition(0, 0), 
+    mVelocity(0, 0), 
+    mP00(0), 
+    mP01(0), 
+    mP11(0)
+{
+}
+
+void MotionModel::init(cv::Point2d const& position, unsigned int const timePoint, double const velocityStdDev)
+{
+    double measurementNoise = LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise;
+    
+    this->mInitialized  = true;
+    this->mTimePoint    = timePoint;
+    this->mPosition     = position;
+    this->mVelocity     = cv::Point2d(0, 0);
+    this->mP00          = measurementNoise * measurementNoise;
+    this->mP01          = 0;
+    this->mP11          = velocityStdDev * velocityStdDev;
+}
+
+void MotionModel::update(cv::Point2d const& position, unsigned int const timePoint, double const velocityStdDev)
+{
+    if(!this->mInitialized || timePoint <= this->mTimePoint)
+    {
+        this->init(position, timePoint, velocityStdDev);
+        return;
+    }
+    
+    // prediction
+    double dt = static_cast<double>(timePoint - this->mTimePoint);
+    cv::Point2d predicted = this->mPosition + this->mVelocity * dt;
+    double p00, p01, p11;
+    this->predictCovariance(dt, p00, p01, p11);
+    
+    // correction (the measurement is the position only)
+    double measurementNoise = LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise;
+    double s = p00 + measurementNoise * measurementNoise;
+    double k0 = p00 / s;
+    double k1 = p01 / s;
+    cv::Point2d innovation = position - predicted;
+    
+    this->mPosition = predicted + innovation * k0;
+    this->mVelocity = this->mVelocity + innovation * k1;
+    this->mP00      = (1 - k0) * p00;
+    this->mP01      = (1 - k0) * p01;
+    this->mP11      = p11 - k1 * p01;
+    this->mTimePoint = timePoint;
+}
+
+bool MotionModel::predict(unsigned int const timePoint, cv::Point2d& position, double& stdDev) const
+{
+    if(!this->mInitialized)
+    {
+        return false;
+    }
+    
+    double dt = (timePoint > this->mTimePoint) ? static_cast<double>(timePoint - this->mTimePoint) : 0.0;
+    double p00, p01, p11;
+    this->predictCovariance(dt, p00, p01, p11);
+    
+    double measurementNoise = LarvaeExtractionParameters::AssignmentParameters::dMotionMeasurementNoise;
+    position = this->mPosition + this->mVelocity * dt;
+    stdDev = std::sqrt(p00 + measurementNoise * measurementNoise);
+    
+    return true;
+}
+
+void MotionModel::predictCovariance(double const dt, double& p00, double& p01, double& p11) const
+{
+    // P' = F P F^T + Q with F = [1 dt; 0 1] and Q = q^2 [dt^4/4 dt^3/2; dt^3/2 dt^2]
+    double q2 = LarvaeExtractionParameters::AssignmentParameters::dMotionProcessNoise 
+            * LarvaeExtractionParameters::AssignmentParameters::dMotionProcessNoise;
+    double dt2 = dt * dt;
+    
+    p00 = this->mP00 + 2 * dt * this->mP01 + dt2 * this->mP11 + q2 * dt2 * dt2 / 4;
+    p01 = this->mP01 + dt * this->mP11 + q2 * dt2 * dt / 2;
+    p11 = this->mP11 + q2 * dt2;
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef MOTIONMODEL_HPP
+#define MOTIONMODEL_HPP
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief The MotionModel class is a constant velocity kalman filter of the position (momentum) of a single track.
+ *
+ * Both coordinates are filtered independently with the state (position, velocity) and share the same covariance
+ * (since they share the noise model). The process noise is a white acceleration with standard deviation
+ * processNoise (pixel per frame^2), the measurement noise has the standard deviation measurementNoise (pixel).
+ */
+class MotionModel
+{
+public:
+    MotionModel();
+    
+    /**
+     * @brief init starts the filter at the given position with zero velocity
+     * @param position first measured position
+     * @param timePoint time point of the measurement
+     * @param velocityStdDev standard deviation of the (unknown) initial velocity in pixel per frame
+     */
+    void init(cv::Point2d const& position, unsigned int const timePoint, double const velocityStdDev);
+    
+    /**
+     * @brief update predicts the state to timePoint and corrects it with the measured position (initializes the filter
+     *        if necessary)
+     */
+    void update(cv::Point2d const& position, unsigned int const timePoint, double const velocityStdDev);
+    
+    /**
+     * @brief predict extrapolates the position to the given time point
+     * @param timePoint time point (not before the last update)
+     * @param position predicted position
+     * @param stdDev standard deviation of the predicted measurement (i.e. including the measurement noise)
+     * @return false if the filter is not initialized
+     */
+    bool predict(unsigned int const timePoint, cv::Point2d& position, double& stdDev) const;
+    
+    bool isInitialized() const {return this->mInitialized;}
+    
+private:
+    void predictCovariance(double const dt, double& p00, double& p01, double& p11) const;
+    
+    bool                mInitialized;
+    unsigned int        mTimePoint;
+    cv::Point2d         mPosition;
+    cv::Point2d         mVelocity;
+    
+    /**
+     * @brief mP00, mP01, mP11 covariance of (position, velocity) of a single coordinate
+     */
+    double              mP00;
+    double              mP01;
+    double              mP11;
+};
+
+#endif // MOTIONMODEL_HPP
@@ -37,15 +37,43 @@ using namespace cv;
 using namespace FIMTypes;
 using std::vector;
 
-RawLarva::RawLarva(const contour_t& _contour, Mat const & img)
+RawLarva::RawLarva(const contour_t& _contour, Mat const & img) : contour(_contour)
 {
+    calcParameters(img);
+}
+
+RawLarva::RawLarva(contour_t&& _contour, Mat const & img) : contour(std::move(_contour))
+{
+    calcParameters(img);
+}
 
+void RawLarva::calcParameters(Mat const & img)
+{
     Q_UNUSED(img);
-    contour=_contour;
 
     // set the contour area value
     area = contourArea(contour);
 
+    // set the contour perimeter value
+    perimeter = arcLength(contour, true);
+
+    // set the momentum
+    calcMomentum();
+
+	// ############################## TODO ############################################
+	// decide if the coiled indicator is useful for fish; if so, the calculation needs to be changed as well as the GUI of the preferences!
+	isCoiled = false;
+
+    // the spine is calculated now or on first access (see ensureSpine)
+    spineCalculated = false;
+    if(!LarvaeExtractionParameters::bUseLazySpineCalculation)
+    {
+        calcSpineParameters();
+    }
+}
+
+void RawLarva::calcSpineParameters() const
+{
     // number of discrete spine points
     int nPoints = 9;
 
@@ -95,13 +123,8 @@ RawLarva::RawLarva(const contour_t& _contour, Mat const & img)
                                   distToMax,
                                   nPoints);
 
+    spineCalculated = true;
 
-    // set the momentum
-    calcMomentum();
-
-	// ############################## TODO ############################################
-	// decide if the coiled indicator is useful for fish; if so, the calculation needs to be changed as well as the GUI of the preferences!
-	isCoiled = false;
 	//calcIsCoiledIndicator(peri2spineLengthThresh,midCirclePeri2PeriThresh,max2meanRadiusThresh);
 }
 
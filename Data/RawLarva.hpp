@@ -36,6 +36,7 @@
 
 #include <vector>
 #include <iterator>
+#include <utility>
 #include <cmath>
 
 #include <QTime>
@@ -67,36 +68,58 @@ public:
      */
     RawLarva(contour_t const& _contour, cv::Mat const & img);
 
+    /**
+     * @brief RawLarva constructor which takes over the given contour without copying it
+     *        (see RawLarva(contour_t const&, cv::Mat const&))
+     *
+     * @param _contour the contour defining the RawLarva (is moved into the raw larva)
+     * @param img  the image to calculate the head position based on brightness information
+     */
+    RawLarva(contour_t&& _contour, cv::Mat const & img);
+
     /** GETTER METHODS **/
 
-    contour_t getContour(void) const {return contour;}
-    spineF_t getSpine(void) const {return spine;}
-    spine_t getDiscreteSpine(void) const {return discreteSpine;}
-    cv::Point getMidPoint(void) const {return discreteSpine.at((discreteSpine.size() + 1 ) / 2);}
+    contour_t const& getContour(void) const {return contour;}
+    spineF_t const& getSpine(void) const {ensureSpine(); return spine;}
+    spine_t const& getDiscreteSpine(void) const {ensureSpine(); return discreteSpine;}
+    cv::Point getMidPoint(void) const {ensureSpine(); return discreteSpine.at((discreteSpine.size() + 1 ) / 2);}
     cv::Point getMomentum(void) const {return momentum;}
     double getArea(void) const {return area;}
-    std::vector<double> getLarvalRadii(void) const {return larvalRadii;}
-	std::vector<double> getLarvaThicknessVector(void) const { return larvaThicknessVector; }
-    double getSpineLength(void) const {return spineLength;}
-    double getContourPerimeter(void) const {return arcLength(contour,true);}
+    radii_t const& getLarvalRadii(void) const {ensureSpine(); return larvalRadii;}
+	std::vector<double> const& getLarvaThicknessVector(void) const {ensureSpine(); return larvaThicknessVector; }
+    double getSpineLength(void) const {ensureSpine(); return spineLength;}
+    double getContourPerimeter(void) const {return perimeter;}
     bool getIsBezierSpine(void) const{return bezierSpine;}
     bool getIsCoiledIndicator(void) const {return isCoiled;}
 
+    /**
+     * @brief isSpineCalculated returns true if the spine (and all values depending on it) is already calculated.
+     *        If LarvaeExtractionParameters::bUseLazySpineCalculation is set, the spine is calculated on first
+     *        access of a spine related getter; otherwise it is calculated in the constructor.
+     */
+    bool isSpineCalculated(void) const {return spineCalculated;}
+
+    /** TAKE METHODS (the raw larva must not be used for the respective value afterwards) **/
+
+    contour_t takeContour(void) {return std::move(contour);}
+    spine_t takeDiscreteSpine(void) {ensureSpine(); return std::move(discreteSpine);}
+    radii_t takeLarvalRadii(void) {ensureSpine(); return std::move(larvalRadii);}
+
 private:
 
     /**
      * @brief contour of the raw larva. The first point (with index 0) contains the contour point with highest curvature
      */
-    contour_t contour;
+    mutable contour_t contour;
     /**
      * @brief spine contains the central spine points with floating precision
      */
-    spineF_t spine;
+    mutable spineF_t spine;
     /**
      * @brief discreteSpine contains fraction of the spine (e.g. 5 points to describe the larva), whereas all of these points
      *        have discrete coordinates.
      */
-    spine_t discreteSpine;
+    mutable spine_t discreteSpine;
     /**
      * @brief bezierSpine indicates if discreteSpine was calculated based on a bezier-spline fitted
      * through the spine (true) or if it was calculated in spineIPAN based on chord lenghts of the spine (false).
@@ -111,27 +134,56 @@ private:
      * @brief area is the area of the contour
      */
     double area;
+    /**
+     * @brief perimeter is the arc length of the (closed) contour
+     */
+    double perimeter;
     /**
      * @brief spineLength arclength of the spine
      */
-    double spineLength;
+    mutable double spineLength;
     /**
      * @brief larvalRadii stores the radii of the discrete spine points. First (head) and last (tail) radii are 0;
      *          radii inbetween are >0.
      */
-	std::vector<double> larvalRadii;
+	mutable radii_t larvalRadii;
 	/**
 	* @brief larvaThicknessVector stores the thickness of the larva for each spine point in "spine"
 	*/
-	std::vector<double> larvaThicknessVector;
+	mutable std::vector<double> larvaThicknessVector;
     /**
      * @brief tailIndex index of contour point, that represents the tail
      *        Annotation: head index is always 0
      */
-    uint tailIndex;
+    mutable uint tailIndex;
 
     bool isCoiled;
 
+    /**
+     * @brief spineCalculated indicates if the spine related members are already calculated
+     */
+    mutable bool spineCalculated;
+
+    /**
+     * @brief calcParameters calculates all raw larva parameters (i.e. area, perimeter, spine, momentum, ...)
+     *        based on the contour member. It is called by the constructors after the contour is set.
+     *
+     * @param img  the image to calculate the head position based on brightness information
+     */
+    void calcParameters(cv::Mat const & img);
+
+    /**
+     * @brief calcSpineParameters calculates the spine, discrete spine, radii and spine length
+     *        using SpineIPAN. Note, that the contour is reordered (the head becomes the first point).
+     */
+    void calcSpineParameters(void) const;
+
+    /**
+     * @brief ensureSpine calculates the spine parameters if this is not done yet. The lazy calculation
+     *        is not thread-safe, i.e. a single raw larva must not be accessed concurrently.
+     */
+    void ensureSpine(void) const {if(!spineCalculated) calcSpineParameters();}
+
     /**
      * @brief calcMomentum calculates the momentum of the contour
      *
@@ -0,0 +1,435 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef TIMESERIES_HPP
+#define TIMESERIES_HPP
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief The TimeSeries class stores one value per time point in blocks of consecutive time points.
+ *
+ * Block k holds the time points [k * BlockSize, (k + 1) * BlockSize) contiguously with a validity flag per time
+ * point, and it is only allocated if it holds a value. Thus, access by time point is a bounds check instead of a
+ * tree search, iterating a track is a linear scan over its blocks and a gap costs at most one block per end
+ * (longer gaps only cost a null pointer per block). The interface follows std::map<unsigned int, T> (find, count,
+ * operator[], insert, erase and bidirectional iterators in time order), so it can be used as drop-in replacement.
+ *
+ * As for std::map, inserting does not move any value: references and iterators stay valid until their time point
+ * is erased (i.e. a[x] = a[y] is safe even if one of the time points is inserted).
+ */
+template<class T>
+class TimeSeries
+{
+public:
+    typedef unsigned int                        key_type;
+    typedef T                                   mapped_type;
+    typedef std::pair<unsigned int, T>          value_type;
+    
+    /**
+     * @brief BlockSize number of consecutive time points allocated at once
+     */
+    static const unsigned int BlockSize = 16;
+    
+private:
+    /**
+     * @brief EndTimePoint time point of the end iterator (never a valid time point)
+     */
+    static const unsigned int EndTimePoint = ~0u;
+    
+    struct Block
+    {
+        explicit Block(unsigned int const firstTimePoint) : count(0)
+        {
+            for(unsigned int i = 0; i < BlockSize; ++i)
+            {
+                // the time point is stored with the value for map-like iteration (it->first)
+                this->entries[i].first = firstTimePoint + i;
+                this->valid[i] = false;
+            }
+        }
+        
+        value_type      entries[BlockSize];
+        bool            valid[BlockSize];
+        unsigned int    count;
+    };
+    
+    template<bool IsConst>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename TimeSeries::value_type value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef typename std::conditional<IsConst, value_type const*, value_type*>::type pointer;
+        typedef typename std::conditional<IsConst, value_type const&, value_type&>::type reference;
+        typedef typename std::conditional<IsConst, TimeSeries const*, TimeSeries*>::type container_pointer;
+        
+        Iterator() : mSeries(nullptr), mTimePoint(EndTimePoint) {}
+        Iterator(container_pointer series, unsigned int timePoint) : mSeries(series), mTimePoint(timePoint) {}
+        
+        // iterators convert to const iterators
+        operator Iterator<true>() const {return Iterator<true>(this->mSeries, this->mTimePoint);}
+        
+        reference operator*() const {return *this->mSeries->entryAt(this->mTimePoint);}
+        pointer operator->() const {return this->mSeries->entryAt(this->mTimePoint);}
+        
+        Iterator& operator++() {this->mTimePoint = this->mSeries->nextTimePoint(this->mTimePoint); return *this;}
+        Iterator& operator--() {this->mTimePoint = this->mSeries->prevTimePoint(this->mTimePoint); return *this;}
+        
+        Iterator operator++(int) {Iterator tmp = *this; ++(*this); return tmp;}
+        Iterator operator--(int) {Iterator tmp = *this; --(*this); return tmp;}
+        
+        friend bool operator==(Iterator const& a, Iterator const& b) {return a.mTimePoint == b.mTimePoint && a.mSeries == b.mSeries;}
+        friend bool operator!=(Iterator const& a, Iterator const& b) {return !(a == b);}
+        
+    private:
+        container_pointer   mSeries;
+        
+        /**
+         * @brief mTimePoint the iterator refers to (EndTimePoint for the end iterator), thus inserting and erasing
+         *        other time points does not invalidate it
+         */
+        unsigned int        mTimePoint;
+    };
+    
+public:
+    typedef Iterator<false>                     iterator;
+    typedef Iterator<true>                      const_iterator;
+    
+    TimeSeries() : mFirstBlock(0), mFirstTimePoint(0), mLastTimePoint(0), mSize(0) {}
+    
+    TimeSeries(TimeSeries const& other) : 
+        mFirstBlock(other.mFirstBlock), 
+        mFirstTimePoint(other.mFirstTimePoint), 
+        mLastTimePoint(other.mLastTimePoint), 
+        mSize(other.mSize)
+    {
+        this->mBlocks.reserve(other.mBlocks.size());
+        for(size_t b = 0; b < other.mBlocks.size(); ++b)
+        {
+            this->mBlocks.push_back(std::unique_ptr<Block>(other.mBlocks[b] ? new Block(*other.mBlocks[b]) : nullptr));
+        }
+    }
+    
+    TimeSeries(TimeSeries&& other) : mFirstBlock(0), mFirstTimePoint(0), mLastTimePoint(0), mSize(0)
+    {
+        this->swap(other);
+    }
+    
+    TimeSeries& operator=(TimeSeries other)
+    {
+        this->swap(other);
+        return *this;
+    }
+    
+    void swap(TimeSeries& other)
+    {
+        this->mBlocks.swap(other.mBlocks);
+        std::swap(this->mFirstBlock, other.mFirstBlock);
+        std::swap(this->mFirstTimePoint, other.mFirstTimePoint);
+        std::swap(this->mLastTimePoint, other.mLastTimePoint);
+        std::swap(this->mSize, other.mSize);
+    }
+    
+    iterator begin() {return iterator(this, this->empty() ? EndTimePoint : this->mFirstTimePoint);}
+    iterator end() {return iterator(this, EndTimePoint);}
+    const_iterator begin() const {return const_iterator(this, this->empty() ? EndTimePoint : this->mFirstTimePoint);}
+    const_iterator end() const {return const_iterator(this, EndTimePoint);}
+    
+    size_t size() const {return this->mSize;}
+    bool empty() const {return this->mSize == 0;}
+    
+    /**
+     * @brief getFirstTimePoint first time point with a value (only meaningful if not empty)
+     */
+    unsigned int getFirstTimePoint() const {return this->mFirstTimePoint;}
+    
+    /**
+     * @brief getSpan number of time points between the first and the last value (including gaps)
+     */
+    size_t getSpan() const {return this->empty() ? 0 : this->mLastTimePoint - this->mFirstTimePoint + 1;}
+    
+    void clear()
+    {
+        this->mBlocks.clear();
+        this->mFirstBlock = 0;
+        this->mFirstTimePoint = 0;
+        this->mLastTimePoint = 0;
+        this->mSize = 0;
+    }
+    
+    iterator find(unsigned int const timePoint)
+    {
+        return this->count(timePoint) ? iterator(this, timePoint) : this->end();
+    }
+    
+    const_iterator find(unsigned int const timePoint) const
+    {
+        return this->count(timePoint) ? const_iterator(this, timePoint) : this->end();
+    }
+    
+    size_t count(unsigned int const timePoint) const
+    {
+        Block const* block = this->blockOf(timePoint);
+        return (block && block->valid[timePoint % BlockSize]) ? 1 : 0;
+    }
+    
+    /**
+     * @brief insert inserts the value if there is no value at its time point yet (like std::map::insert)
+     */
+    std::pair<iterator, bool> insert(value_type const& value)
+    {
+        if(this->count(value.first))
+        {
+            return std::make_pair(iterator(this, value.first), false);
+        }
+        
+        this->makeSlot(value.first).second = value.second;
+        return std::make_pair(iterator(this, value.first), true);
+    }
+    
+    T& operator[](unsigned int const timePoint)
+    {
+        if(this->count(timePoint))
+        {
+            return this->entryAt(timePoint)->second;
+        }
+        return this->makeSlot(timePoint).second;
+    }
+    
+    size_t erase(unsigned int const timePoint)
+    {
+        if(!this->count(timePoint))
+        {
+            return 0;
+        }
+        
+        std::unique_ptr<Block>& block = this->mBlocks[timePoint / BlockSize - this->mFirstBlock];
+        block->valid[timePoint % BlockSize] = false;
+        block->entries[timePoint % BlockSize].second = T();
+        --block->count;
+        --this->mSize;
+        
+        if(this->mSize == 0)
+        {
+            this->clear();
+            return 1;
+        }
+        
+        if(block->count == 0)
+        {
+            block.reset();
+        }
+        
+        // shrink the span to the remaining values (the other blocks do not move)
+        if(timePoint == this->mFirstTimePoint)
+        {
+            this->mFirstTimePoint = this->nextTimePoint(timePoint);
+        }
+        if(timePoint == this->mLastTimePoint)
+        {
+            this->mLastTimePoint = this->prevTimePoint(timePoint);
+        }
+        
+        size_t leadingGaps = 0;
+        while(!this->mBlocks[leadingGaps])
+        {
+            ++leadingGaps;
+        }
+        this->mBlocks.erase(this->mBlocks.begin(), this->mBlocks.begin() + leadingGaps);
+        this->mFirstBlock += static_cast<unsigned int>(leadingGaps);
+        
+        while(!this->mBlocks.back())
+        {
+            this->mBlocks.pop_back();
+        }
+        
+        return 1;
+    }
+    
+private:
+    Block const* blockOf(unsigned int const timePoint) const
+    {
+        unsigned int const b = timePoint / BlockSize;
+        if(b < this->mFirstBlock || b - this->mFirstBlock >= this->mBlocks.size())
+        {
+            return nullptr;
+        }
+        return this->mBlocks[b - this->mFirstBlock].get();
+    }
+    
+    value_type* entryAt(unsigned int const timePoint)
+    {
+        return &this->mBlocks[timePoint / BlockSize - this->mFirstBlock]->entries[timePoint % BlockSize];
+    }
+    
+    value_type const* entryAt(unsigned int const timePoint) const
+    {
+        return &this->mBlocks[timePoint / BlockSize - this->mFirstBlock]->entries[timePoint % BlockSize];
+    }
+    
+    /**
+     * @brief nextTimePoint returns the first time point with a value after timePoint (EndTimePoint if there is none)
+     */
+    unsigned int nextTimePoint(unsigned int timePoint) const
+    {
+        if(this->empty() || timePoint >= this->mLastTimePoint)
+        {
+            return EndTimePoint;
+        }
+        
+        // the last time point has a value, thus the search stops there at the latest
+        ++timePoint;
+        for(;;)
+        {
+            Block const* block = this->blockOf(timePoint);
+            if(!block)
+            {
+                timePoint = (timePoint / BlockSize + 1) * BlockSize;
+            }
+            else if(block->valid[timePoint % BlockSize])
+            {
+                return timePoint;
+            }
+            else
+            {
+                ++timePoint;
+            }
+        }
+    }
+    
+    /**
+     * @brief prevTimePoint returns the last time point with a value before timePoint (the last time point for EndTimePoint)
+     */
+    unsigned int prevTimePoint(unsigned int timePoint) const
+    {
+        if(timePoint == EndTimePoint)
+        {
+            return this->mLastTimePoint;
+        }
+        
+        // the first time point has a value, thus the search stops there at the latest
+        --timePoint;
+        for(;;)
+        {
+            Block const* block = this->blockOf(timePoint);
+            if(!block)
+            {
+                timePoint = (timePoint / BlockSize) * BlockSize - 1;
+            }
+            else if(block->valid[timePoint % BlockSize])
+            {
+                return timePoint;
+            }
+            else
+            {
+                --timePoint;
+            }
+        }
+    }
+    
+    /**
+     * @brief makeSlot allocates the block of the (unused) time point if necessary and marks the time point valid
+     * @return entry of the time point
+     */
+    value_type& makeSlot(unsigned int const timePoint)
+    {
+        unsigned int const b = timePoint / BlockSize;
+        if(this->mBlocks.empty())
+        {
+            this->mFirstBlock = b;
+            this->mBlocks.resize(1);
+        }
+        else if(b < this->mFirstBlock)
+        {
+            // only the block pointers move
+            size_t const shift = this->mFirstBlock - b;
+            std::vector<std::unique_ptr<Block> > blocks(shift + this->mBlocks.size());
+            for(size_t i = 0; i < this->mBlocks.size(); ++i)
+            {
+                blocks[shift + i] = std::move(this->mBlocks[i]);
+            }
+            this->mBlocks.swap(blocks);
+            this->mFirstBlock = b;
+        }
+        else if(b - this->mFirstBlock >= this->mBlocks.size())
+        {
+            this->mBlocks.resize(b - this->mFirstBlock + 1);
+        }
+        
+        std::unique_ptr<Block>& block = this->mBlocks[b - this->mFirstBlock];
+        if(!block)
+        {
+            block.reset(new Block(b * BlockSize));
+        }
+        
+        block->valid[timePoint % BlockSize] = true;
+        ++block->count;
+        
+        if(this->mSize == 0)
+        {
+            this->mFirstTimePoint = timePoint;
+            this->mLastTimePoint = timePoint;
+        }
+        else
+        {
+            this->mFirstTimePoint = std::min(this->mFirstTimePoint, timePoint);
+            this->mLastTimePoint = std::max(this->mLastTimePoint, timePoint);
+        }
+        ++this->mSize;
+        
+        return block->entries[timePoint % BlockSize];
+    }
+    
+    /**
+     * @brief mBlocks blocks mFirstBlock, mFirstBlock + 1, ... (nullptr for blocks without values; the first and the
+     *        last block always hold values)
+     */
+    std::vector<std::unique_ptr<Block> >    mBlocks;
+    unsigned int                            mFirstBlock;
+    unsigned int                            mFirstTimePoint;
+    unsigned int                            mLastTimePoint;
+    size_t                                  mSize;
+};
+
+template<class T> const unsigned int TimeSeries<T>::BlockSize;
+template<class T> const unsigned int TimeSeries<T>::EndTimePoint;
+
+#endif // TIMESERIES_HPP
@@ -0,0 +1,471 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+#include "TrackColumns.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    template<class T>
+    void insertColumnRows(std::vector<T>& column, size_t const i, size_t const n, size_t const width)
+    {
+        column.insert(column.begin() + i * width, n * width, T());
+    }
+    
+    template<class T>
+    void eraseColumnRows(std::vector<T>& column, size_t const i, size_t const n, size_t const width)
+    {
+        column.erase(column.begin() + i * width, column.begin() + (i + n) * width);
+    }
+}
+
+TrackColumns::const_iterator::const_iterator(const TrackColumns *columns, const size_t index) : 
+    mColumns(columns), 
+    mIndex(index)
+{
+    this->skipInvalid();
+}
+
+TrackColumns::const_iterator &TrackColumns::const_iterator::operator++()
+{
+    ++this->mIndex;
+    this->skipInvalid();
+    return *this;
+}
+
+void TrackColumns::const_iterator::skipInvalid()
+{
+    std::vector<bool> const& valid = this->mColumns->mValid;
+    while(this->mIndex < valid.size() && !valid[this->mIndex])
+    {
+        ++this->mIndex;
+    }
+}
+
+TrackColumns::TrackColumns() : 
+    mFirstTimePoint(0), 
+    mSize(0), 
+    mStride(0)
+{
+}
+
+void TrackColumns::copy(const TrackColumns &src, const unsigned int srcTimePoint, const unsigned int dstTimePoint)
+{
+    size_t s = src.index(srcTimePoint);
+    if(s == src.mValid.size())
+    {
+        this->erase(dstTimePoint);
+        return;
+    }
+    if(&src == this && srcTimePoint == dstTimePoint)
+    {
+        return;
+    }
+    
+    // slot() and reserveStride() may move the rows if src are these columns
+    this->reserveStride(src.mStride);
+    size_t i = this->slot(dstTimePoint);
+    s = srcTimePoint - src.mFirstTimePoint;
+    
+    for(int f = 0; f < FirstDoubleFeature; ++f)
+    {
+        this->mFloatValues[f][i] = src.mFloatValues[f][s];
+    }
+    for(int f = 0; f < NumberOfFeatures - FirstDoubleFeature; ++f)
+    {
+        this->mDoubleValues[f][i] = src.mDoubleValues[f][s];
+    }
+    this->mIndicators[i]        = src.mIndicators[s];
+    this->mGoPhase[i]           = src.mGoPhase[s];
+    this->mNeighbourCount[i]    = src.mNeighbourCount[s];
+    this->mMomentum[i]          = src.mMomentum[s];
+    this->mSpineSize[i]         = src.mSpineSize[s];
+    this->mRadiiSize[i]         = src.mRadiiSize[s];
+    std::copy(src.mSpine.begin() + s * src.mStride, src.mSpine.begin() + s * src.mStride + src.mSpineSize[s], this->mSpine.begin() + i * this->mStride);
+    std::copy(src.mRadii.begin() + s * src.mStride, src.mRadii.begin() + s * src.mStride + src.mRadiiSize[s], this->mRadii.begin() + i * this->mStride);
+}
+
+void TrackColumns::erase(const unsigned int timePoint)
+{
+    size_t i = this->index(timePoint);
+    if(i == this->mValid.size())
+    {
+        return;
+    }
+    
+    if(--this->mSize == 0)
+    {
+        this->clear();
+        return;
+    }
+    
+    this->resetRow(i);
+    this->mValid[i] = false;
+    
+    // keep the span tight (see Larva::getFirstTimePoint and Larva::getLastTimePoint)
+    size_t first = 0;
+    while(!this->mValid[first])
+    {
+        ++first;
+    }
+    size_t last = this->mValid.size() - 1;
+    while(!this->mValid[last])
+    {
+        --last;
+    }
+    
+    if(last + 1 < this->mValid.size())
+    {
+        this->eraseRows(last + 1, this->mValid.size() - last - 1);
+    }
+    if(first > 0)
+    {
+        this->eraseRows(0, first);
+        this->mFirstTimePoint += static_cast<unsigned int>(first);
+    }
+}
+
+void TrackColumns::clear()
+{
+    this->mFirstTimePoint = 0;
+    this->mSize = 0;
+    this->mStride = 0;
+    std::vector<bool>().swap(this->mValid);
+    for(int f = 0; f < FirstDoubleFeature; ++f)
+    {
+        std::vector<float>().swap(this->mFloatValues[f]);
+    }
+    for(int f = 0; f < NumberOfFeatures - FirstDoubleFeature; ++f)
+    {
+        std::vector<double>().swap(this->mDoubleValues[f]);
+    }
+    std::vector<unsigned char>().swap(this->mIndicators);
+    std::vector<signed char>().swap(this->mGoPhase);
+    std::vector<int>().swap(this->mNeighbourCount);
+    std::vector<cv::Point>().swap(this->mMomentum);
+    std::vector<unsigned short>().swap(this->mSpineSize);
+    std::vector<unsigned short>().swap(this->mRadiiSize);
+    std::vector<cv::Point>().swap(this->mSpine);
+    std::vector<float>().swap(this->mRadii);
+}
+
+double TrackColumns::getValue(const Feature feature, const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    if(i == this->mValid.size())
+    {
+        return 0.0;
+    }
+    if(feature < FirstDoubleFeature)
+    {
+        return this->mFloatValues[feature][i];
+    }
+    return this->mDoubleValues[feature - FirstDoubleFeature][i];
+}
+
+void TrackColumns::setValue(const Feature feature, const unsigned int timePoint, const double value)
+{
+    size_t i = this->slot(timePoint);
+    if(feature < FirstDoubleFeature)
+    {
+        this->mFloatValues[feature][i] = static_cast<float>(value);
+    }
+    else
+    {
+        this->mDoubleValues[feature - FirstDoubleFeature][i] = value;
+    }
+}
+
+bool TrackColumns::getIndicator(const Indicator indicator, const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() && (this->mIndicators[i] & indicator) != 0;
+}
+
+void TrackColumns::setIndicator(const Indicator indicator, const unsigned int timePoint, const bool value)
+{
+    size_t i = this->slot(timePoint);
+    if(value)
+    {
+        this->mIndicators[i] |= indicator;
+    }
+    else
+    {
+        this->mIndicators[i] &= static_cast<unsigned char>(~indicator);
+    }
+}
+
+int TrackColumns::getGoPhase(const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() ? this->mGoPhase[i] : 0;
+}
+
+void TrackColumns::setGoPhase(const unsigned int timePoint, const int goPhase)
+{
+    this->mGoPhase[this->slot(timePoint)] = static_cast<signed char>(goPhase);
+}
+
+int TrackColumns::getNeighbourCount(const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() ? this->mNeighbourCount[i] : 0;
+}
+
+void TrackColumns::setNeighbourCount(const unsigned int timePoint, const int neighbourCount)
+{
+    this->mNeighbourCount[this->slot(timePoint)] = neighbourCount;
+}
+
+cv::Point TrackColumns::getMomentum(const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() ? this->mMomentum[i] : cv::Point();
+}
+
+void TrackColumns::setMomentum(const unsigned int timePoint, const cv::Point &momentum)
+{
+    this->mMomentum[this->slot(timePoint)] = momentum;
+}
+
+size_t TrackColumns::getSpineSize(const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() ? this->mSpineSize[i] : 0;
+}
+
+cv::Point TrackColumns::getSpinePoint(const unsigned int timePoint, const size_t i) const
+{
+    size_t r = this->index(timePoint);
+    if(r == this->mValid.size() || i >= this->mSpineSize[r])
+    {
+        throw std::out_of_range("TrackColumns::getSpinePoint");
+    }
+    return this->mSpine[r * this->mStride + i];
+}
+
+FIMTypes::spine_t TrackColumns::getSpine(const unsigned int timePoint) const
+{
+    FIMTypes::spine_t spine;
+    size_t i = this->index(timePoint);
+    if(i < this->mValid.size())
+    {
+        std::vector<cv::Point>::const_iterator first = this->mSpine.begin() + i * this->mStride;
+        spine.assign(first, first + this->mSpineSize[i]);
+    }
+    return spine;
+}
+
+void TrackColumns::setSpine(const unsigned int timePoint, const FIMTypes::spine_t &spine)
+{
+    this->reserveStride(spine.size());
+    size_t i = this->slot(timePoint);
+    std::copy(spine.begin(), spine.end(), this->mSpine.begin() + i * this->mStride);
+    this->mSpineSize[i] = static_cast<unsigned short>(spine.size());
+}
+
+size_t TrackColumns::getSpineRadiiSize(const unsigned int timePoint) const
+{
+    size_t i = this->index(timePoint);
+    return i < this->mValid.size() ? this->mRadiiSize[i] : 0;
+}
+
+double TrackColumns::getSpineRadius(const unsigned int timePoint, const size_t i) const
+{
+    size_t r = this->index(timePoint);
+    if(r == this->mValid.size() || i >= this->mRadiiSize[r])
+    {
+        throw std::out_of_range("TrackColumns::getSpineRadius");
+    }
+    return this->mRadii[r * this->mStride + i];
+}
+
+FIMTypes::radii_t TrackColumns::getSpineRadii(const unsigned int timePoint) const
+{
+    FIMTypes::radii_t radii;
+    size_t i = this->index(timePoint);
+    if(i < this->mValid.size())
+    {
+        std::vector<float>::const_iterator first = this->mRadii.begin() + i * this->mStride;
+        radii.assign(first, first + this->mRadiiSize[i]);
+    }
+    return radii;
+}
+
+void TrackColumns::setSpineRadii(const unsigned int timePoint, const FIMTypes::radii_t &radii)
+{
+    this->reserveStride(radii.size());
+    size_t i = this->slot(timePoint);
+    std::vector<float>::iterator out = this->mRadii.begin() + i * this->mStride;
+    for(FIMTypes::radii_t::const_iterator it = radii.begin(); it != radii.end(); ++it, ++out)
+    {
+        *out = static_cast<float>(*it);
+    }
+    this->mRadiiSize[i] = static_cast<unsigned short>(radii.size());
+}
+
+void TrackColumns::reverseSpine(const unsigned int timePoint, const bool withRadii)
+{
+    size_t i = this->index(timePoint);
+    if(i == this->mValid.size())
+    {
+        return;
+    }
+    
+    std::vector<cv::Point>::iterator spine = this->mSpine.begin() + i * this->mStride;
+    std::reverse(spine, spine + this->mSpineSize[i]);
+    if(withRadii)
+    {
+        std::vector<float>::iterator radii = this->mRadii.begin() + i * this->mStride;
+        std::reverse(radii, radii + this->mRadiiSize[i]);
+    }
+}
+
+size_t TrackColumns::index(const unsigned int timePoint) const
+{
+    size_t i = timePoint - this->mFirstTimePoint;
+    if(timePoint < this->mFirstTimePoint || i >= this->mValid.size() || !this->mValid[i])
+    {
+        return this->mValid.size();
+    }
+    return i;
+}
+
+size_t TrackColumns::slot(const unsigned int timePoint)
+{
+    if(this->mValid.empty())
+    {
+        this->mFirstTimePoint = timePoint;
+    }
+    else if(timePoint < this->mFirstTimePoint)
+    {
+        this->insertRows(0, this->mFirstTimePoint - timePoint);
+        this->mFirstTimePoint = timePoint;
+    }
+    
+    size_t i = timePoint - this->mFirstTimePoint;
+    if(i >= this->mValid.size())
+    {
+        this->insertRows(this->mValid.size(), i + 1 - this->mValid.size());
+    }
+    
+    if(!this->mValid[i])
+    {
+        this->mValid[i] = true;
+        ++this->mSize;
+    }
+    return i;
+}
+
+void TrackColumns::insertRows(const size_t i, const size_t n)
+{
+    insertColumnRows(this->mValid, i, n, 1);
+    for(int f = 0; f < FirstDoubleFeature; ++f)
+    {
+        insertColumnRows(this->mFloatValues[f], i, n, 1);
+    }
+    for(int f = 0; f < NumberOfFeatures - FirstDoubleFeature; ++f)
+    {
+        insertColumnRows(this->mDoubleValues[f], i, n, 1);
+    }
+    insertColumnRows(this->mIndicators, i, n, 1);
+    insertColumnRows(this->mGoPhase, i, n, 1);
+    insertColumnRows(this->mNeighbourCount, i, n, 1);
+    insertColumnRows(this->mMomentum, i, n, 1);
+    insertColumnRows(this->mSpineSize, i, n, 1);
+    insertColumnRows(this->mRadiiSize, i, n, 1);
+    insertColumnRows(this->mSpine, i, n, this->mStride);
+    insertColumnRows(this->mRadii, i, n, this->mStride);
+}
+
+void TrackColumns::eraseRows(const size_t i, const size_t n)
+{
+    eraseColumnRows(this->mValid, i, n, 1);
+    for(int f = 0; f < FirstDoubleFeature; ++f)
+    {
+        eraseColumnRows(this->mFloatValues[f], i, n, 1);
+    }
+    for(int f = 0; f < NumberOfFeatures - FirstDoubleFeature; ++f)
+    {
+        eraseColumnRows(this->mDoubleValues[f], i, n, 1);
+    }
+    eraseColumnRows(this->mIndicators, i, n, 1);
+    eraseColumnRows(this->mGoPhase, i, n, 1);
+    eraseColumnRows(this->mNeighbourCount, i, n, 1);
+    eraseColumnRows(this->mMomentum, i, n, 1);
+    eraseColumnRows(this->mSpineSize, i, n, 1);
+    eraseColumnRows(this->mRadiiSize, i, n, 1);
+    eraseColumnRows(this->mSpine, i, n, this->mStride);
+    eraseColumnRows(this->mRadii, i, n, this->mStride);
+}
+
+void TrackColumns::resetRow(const size_t i)
+{
+    for(int f = 0; f < FirstDoubleFeature; ++f)
+    {
+        this->mFloatValues[f][i] = 0.0f;
+    }
+    for(int f = 0; f < NumberOfFeatures - FirstDoubleFeature; ++f)
+    {
+        this->mDoubleValues[f][i] = 0.0;
+    }
+    this->mIndicators[i]        = 0;
+    this->mGoPhase[i]           = 0;
+    this->mNeighbourCount[i]    = 0;
+    this->mMomentum[i]          = cv::Point();
+    this->mSpineSize[i]         = 0;
+    this->mRadiiSize[i]         = 0;
+    std::fill(this->mSpine.begin() + i * this->mStride, this->mSpine.begin() + (i + 1) * this->mStride, cv::Point());
+    std::fill(this->mRadii.begin() + i * this->mStride, this->mRadii.begin() + (i + 1) * this->mStride, 0.0f);
+}
+
+void TrackColumns::reserveStride(const size_t stride)
+{
+    if(stride <= this->mStride)
+    {
+        return;
+    }
+    
+    size_t rows = this->mValid.size();
+    std::vector<cv::Point> spine(rows * stride);
+    std::vector<float> radii(rows * stride);
+    for(size_t i = 0; i < rows; ++i)
+    {
+        std::copy(this->mSpine.begin() + i * this->mStride, this->mSpine.begin() + i * this->mStride + this->mSpineSize[i], spine.begin() + i * stride);
+        std::copy(this->mRadii.begin() + i * this->mStride, this->mRadii.begin() + i * this->mStride + this->mRadiiSize[i], radii.begin() + i * stride);
+    }
+    this->mSpine.swap(spine);
+    this->mRadii.swap(radii);
+    this->mStride = stride;
+}
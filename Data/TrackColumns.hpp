@@ -0,0 +1,241 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+#ifndef TRACKCOLUMNS_HPP
+#define TRACKCOLUMNS_HPP
+
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+#include "Configuration/TrackerConfig.hpp"
+
+/**
+ * @brief The TrackColumns class stores the features of one larva (see Larva::ValuesType) column by column.
+ *
+ * Every feature has its own array which is dense over the covered time span, and a validity bitmap marks the time
+ * points with values. Thus, access by time point is O(1), a scan over one feature (e.g. all momenta) only touches
+ * that feature, and a gap costs one bit plus the (zero) values of the gap. Continuous features are stored as float
+ * except for the accumulated distance (which is summed up over the whole track) and velocity and acceleration
+ * (which use std::numeric_limits<double>::min() to mark missing values). Spine points and radii are stored in
+ * rows of a common stride, so a time point needs about 180 bytes for 9 spine points.
+ *
+ * The getters return zero values for time points without values (see count). As operator[] of the former
+ * parameters map, the setters insert the time point with zero values if it does not exist.
+ */
+class TrackColumns
+{
+public:
+    /**
+     * @brief The Feature enum lists the scalar features (the features from FirstDoubleFeature on are stored as double)
+     */
+    enum Feature
+    {
+        AREA,
+        MAIN_BODY_BENDING_ANGLE,
+        SPINE_LENGTH,
+        PERIMETER,
+        DIST_TO_ORIGIN,
+        MOMENTUM_DIST,
+        MOVEMENT_DIRECTION,
+        NEAREST_NEIGHBOUR_DIST,
+        ACC_DIST,
+        VELOSITY,
+        ACCELERATION,
+        NumberOfFeatures,
+        FirstDoubleFeature = ACC_DIST
+    };
+    
+    /**
+     * @brief The Indicator enum lists the boolean features (bits of the indicator column)
+     */
+    enum Indicator
+    {
+        IS_COILED           = 1,
+        IS_WELL_ORIENTED    = 2,
+        IS_LEFT_BENDED      = 4,
+        IS_RIGHT_BENDED     = 8
+    };
+    
+    /**
+     * @brief The const_iterator class iterates the time points with values in ascending order
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef unsigned int                value_type;
+        typedef std::ptrdiff_t              difference_type;
+        typedef unsigned int const*         pointer;
+        typedef unsigned int                reference;
+        
+        const_iterator() : mColumns(nullptr), mIndex(0) {}
+        const_iterator(TrackColumns const* columns, size_t const index);
+        
+        unsigned int operator*() const {return this->mColumns->mFirstTimePoint + static_cast<unsigned int>(this->mIndex);}
+        
+        const_iterator& operator++();
+        const_iterator operator++(int) {const_iterator tmp = *this; ++(*this); return tmp;}
+        
+        friend bool operator==(const_iterator const& a, const_iterator const& b) {return a.mIndex == b.mIndex && a.mColumns == b.mColumns;}
+        friend bool operator!=(const_iterator const& a, const_iterator const& b) {return !(a == b);}
+        
+    private:
+        /**
+         * @brief skipInvalid moves the iterator to the next valid time point (or to the end)
+         */
+        void skipInvalid();
+        
+        TrackColumns const* mColumns;
+        size_t              mIndex;
+    };
+    
+    TrackColumns();
+    
+    const_iterator begin() const {return const_iterator(this, 0);}
+    const_iterator end() const {return const_iterator(this, this->mValid.size());}
+    
+    size_t size() const {return this->mSize;}
+    bool empty() const {return this->mSize == 0;}
+    size_t count(unsigned int const timePoint) const {return this->index(timePoint) < this->mValid.size() ? 1 : 0;}
+    
+    /**
+     * @brief getFirstTimePoint first time point with a value (only meaningful if not empty)
+     */
+    unsigned int getFirstTimePoint() const {return this->mFirstTimePoint;}
+    
+    /**
+     * @brief getSpan number of time points between the first and the last value (including gaps)
+     */
+    size_t getSpan() const {return this->mValid.size();}
+    
+    /**
+     * @brief insert adds the time point with zero values if it does not exist
+     */
+    void insert(unsigned int const timePoint) {this->slot(timePoint);}
+    
+    /**
+     * @brief copy copies all values of srcTimePoint to dstTimePoint (dstTimePoint is erased if srcTimePoint has no values)
+     * @param src columns to copy from (may be these columns)
+     */
+    void copy(TrackColumns const& src, unsigned int const srcTimePoint, unsigned int const dstTimePoint);
+    
+    void erase(unsigned int const timePoint);
+    void clear();
+    
+    double getValue(Feature const feature, unsigned int const timePoint) const;
+    void setValue(Feature const feature, unsigned int const timePoint, double const value);
+    
+    bool getIndicator(Indicator const indicator, unsigned int const timePoint) const;
+    void setIndicator(Indicator const indicator, unsigned int const timePoint, bool const value);
+    
+    int getGoPhase(unsigned int const timePoint) const;
+    void setGoPhase(unsigned int const timePoint, int const goPhase);
+    
+    int getNeighbourCount(unsigned int const timePoint) const;
+    void setNeighbourCount(unsigned int const timePoint, int const neighbourCount);
+    
+    cv::Point getMomentum(unsigned int const timePoint) const;
+    void setMomentum(unsigned int const timePoint, cv::Point const& momentum);
+    
+    size_t getSpineSize(unsigned int const timePoint) const;
+    
+    /**
+     * @brief getSpinePoint returns the spine point with the given index (throws std::out_of_range like spine_t::at)
+     */
+    cv::Point getSpinePoint(unsigned int const timePoint, size_t const i) const;
+    FIMTypes::spine_t getSpine(unsigned int const timePoint) const;
+    void setSpine(unsigned int const timePoint, FIMTypes::spine_t const& spine);
+    
+    size_t getSpineRadiiSize(unsigned int const timePoint) const;
+    
+    /**
+     * @brief getSpineRadius returns the radius with the given index (throws std::out_of_range like radii_t::at)
+     */
+    double getSpineRadius(unsigned int const timePoint, size_t const i) const;
+    FIMTypes::radii_t getSpineRadii(unsigned int const timePoint) const;
+    void setSpineRadii(unsigned int const timePoint, FIMTypes::radii_t const& radii);
+    
+    /**
+     * @brief reverseSpine reverses the order of the spine points (and of the radii if withRadii is set)
+     */
+    void reverseSpine(unsigned int const timePoint, bool const withRadii);
+    
+private:
+    /**
+     * @brief index returns the index of the given time point or getSpan() if it has no values
+     */
+    size_t index(unsigned int const timePoint) const;
+    
+    /**
+     * @brief slot returns the index of the given time point and inserts it (and extends the covered time span) if necessary
+     */
+    size_t slot(unsigned int const timePoint);
+    
+    /**
+     * @brief insertRows inserts n rows with zero values (and without values) before index i
+     */
+    void insertRows(size_t const i, size_t const n);
+    void eraseRows(size_t const i, size_t const n);
+    
+    /**
+     * @brief resetRow sets all values of the row at index i to zero
+     */
+    void resetRow(size_t const i);
+    
+    /**
+     * @brief reserveStride changes the number of spine points (and radii) per row to at least stride
+     */
+    void reserveStride(size_t const stride);
+    
+    unsigned int                mFirstTimePoint;
+    size_t                      mSize;
+    std::vector<bool>           mValid;
+    
+    std::vector<float>          mFloatValues[FirstDoubleFeature];
+    std::vector<double>         mDoubleValues[NumberOfFeatures - FirstDoubleFeature];
+    std::vector<unsigned char>  mIndicators;
+    std::vector<signed char>    mGoPhase;
+    std::vector<int>            mNeighbourCount;
+    std::vector<cv::Point>      mMomentum;
+    
+    /**
+     * @brief mStride number of spine points (and radii) per row of mSpine (and mRadii)
+     */
+    size_t                      mStride;
+    std::vector<unsigned short> mSpineSize;
+    std::vector<unsigned short> mRadiiSize;
+    std::vector<cv::Point>      mSpine;
+    std::vector<float>          mRadii;
+};
+
+#endif // TRACKCOLUMNS_HPP
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef TRACKSNAPSHOT_HPP
+#define TRACKSNAPSHOT_HPP
+
+#include <vector>
+
+/**
+ * @brief The TrackSnapshot struct stores the features of all larvae assigned at one time point in contiguous
+ *        arrays (structure of arrays), one entry per larva in the order of the larvae container.
+ *
+ * The tracker takes the snapshot of the previous frame once per frame, thus the cost calculations do not need to
+ * look up the larvae (and their parameter maps) for every pair of larva and raw larva.
+ */
+struct TrackSnapshot
+{
+    /**
+     * @brief larvaIDs ids of the larvae
+     */
+    std::vector<int> larvaIDs;
+    
+    /**
+     * @brief momentumX, momentumY momentum (center of mass) of the larvae
+     */
+    std::vector<float> momentumX;
+    std::vector<float> momentumY;
+    
+    /**
+     * @brief midPointX, midPointY mid spine point of the larvae (only valid if hasMidPoint is set)
+     */
+    std::vector<float> midPointX;
+    std::vector<float> midPointY;
+    std::vector<unsigned char> hasMidPoint;
+    
+    std::vector<double> spineLength;
+    std::vector<double> area;
+    
+    /**
+     * @brief footprintRadius maximal distance between the momentum and the spine points of the larvae, i.e. all
+     *        points checked against the contour of a raw larva lie within this radius around the momentum
+     */
+    std::vector<double> footprintRadius;
+    
+    /**
+     * @brief predictedShiftX, predictedShiftY predicted displacement until the next frame and standard deviation of
+     *        the predicted position (negative if there is no prediction; see MotionModel)
+     */
+    std::vector<float> predictedShiftX;
+    std::vector<float> predictedShiftY;
+    std::vector<double> predictionStdDev;
+    
+    size_t size() const {return larvaIDs.size();}
+    bool empty() const {return larvaIDs.empty();}
+    
+    void clear()
+    {
+        larvaIDs.clear();
+        momentumX.clear();
+        momentumY.clear();
+        midPointX.clear();
+        midPointY.clear();
+        hasMidPoint.clear();
+        spineLength.clear();
+        area.clear();
+        footprintRadius.clear();
+        predictedShiftX.clear();
+        predictedShiftY.clear();
+        predictionStdDev.clear();
+    }
+    
+    void reserve(size_t const n)
+    {
+        larvaIDs.reserve(n);
+        momentumX.reserve(n);
+        momentumY.reserve(n);
+        midPointX.reserve(n);
+        midPointY.reserve(n);
+        hasMidPoint.reserve(n);
+        spineLength.reserve(n);
+        area.reserve(n);
+        footprintRadius.reserve(n);
+        predictedShiftX.reserve(n);
+        predictedShiftY.reserve(n);
+        predictionStdDev.reserve(n);
+    }
+};
+
+#endif // TRACKSNAPSHOT_HPP
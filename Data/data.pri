@@ -1,8 +1,22 @@
 HEADERS += \
     Data/RawLarva.hpp \
-    Data/Larva.hpp
+    Data/Larva.hpp \
+    Data/LabelImage.hpp \
+    Data/LandmarkRegistry.hpp \
+    Data/LandmarkSeries.hpp \
+    Data/MotionModel.hpp \
+    Data/TimeSeries.hpp \
+    Data/TrackColumns.hpp \
+    Data/TrackSnapshot.hpp \
+    Data/MidPointGrid.hpp
 
 SOURCES += \
     Data/RawLarva.cpp \
-    Data/Larva.cpp
+    Data/Larva.cpp \
+    Data/LabelImage.cpp \
+    Data/LandmarkRegistry.cpp \
+    Data/LandmarkSeries.cpp \
+    Data/MotionModel.cpp \
+    Data/TrackColumns.cpp \
+    Data/MidPointGrid.cpp
 
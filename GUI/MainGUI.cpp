@@ -292,9 +292,9 @@ void MainGUI::showImage(QString path)
         RawLarva rawLarva(c,grayImg);
         
         // get the discrete spine
-        vector<Point> discreteSpine = rawLarva.getDiscreteSpine();
+        FIMTypes::spine_t discreteSpine = rawLarva.getDiscreteSpine();
         
-        vector<double> larvalRadii = rawLarva.getLarvalRadii();
+        FIMTypes::radii_t larvalRadii = rawLarva.getLarvalRadii();
         
         bool isCoiled = rawLarva.getIsCoiledIndicator();
         Scalar color;
@@ -67,6 +67,7 @@ ResultsViewer::ResultsViewer(QWidget *parent) :
     
     mPlottingTabVisible = false;
     mLarvaIDForCropping = 0;
+    mLastFrameIndex     = 0;
     
     ui->tab_3->setLarvaeContainerPointer(&mLarvaeContainer);
     
@@ -81,29 +82,32 @@ ResultsViewer::~ResultsViewer()
     delete ui;
 }
 
+cv::Mat ResultsViewer::getFrame(int const index)
+{
+    cv::Mat frame = mFrameCache.get(index);
+    
+    // decode the following frames in the direction of the playback or scrubbing in the background
+    int const lastIndex = mLastFrameIndex;
+    bool const wrappedForward = (lastIndex == mNumberOfImages - 1 && index == 0);
+    mFrameCache.prefetch(index, (index < lastIndex && !wrappedForward) ? -1 : 1);
+    mLastFrameIndex = index;
+    
+    return frame;
+}
+
 void ResultsViewer::showImage(int const index)
 {
     if (!mFileNames.empty())
     {
-        /* get the selected image fileNames list */
-        cv::Mat img = cv::imread(QtOpencvCore::qstr2str(mFileNames.at(index)), 0);
+        /* the display-ready (undistorted RGB) frame is shared with the cache and must not be modified */
+        cv::Mat frame = getFrame(index);
         
-        mImageSize.setWidth(img.size().width);
-        mImageSize.setHeight(img.size().height);
+        mImageSize.setWidth(frame.size().width);
+        mImageSize.setHeight(frame.size().height);
         
         emit sendNewImageSize(mImageSize);
         
-        if(mUndistorer.isReady())
-        {
-            cv::Mat tmpImg;
-            mUndistorer.getUndistortImage(img,tmpImg);
-            tmpImg.copyTo(img);
-        }
-        
-        cv::Mat cImg = cv::Mat::zeros(img.size(), CV_8UC3);
-        cv::cvtColor(img,cImg,CV_GRAY2BGR);
-        
-        QImage qimg = QtOpencvCore::img2qimg(cImg);
+        QImage qimg((uchar*) frame.data, frame.cols, frame.rows, frame.step, QImage::Format_RGB888);
         
         /* convert the opencv image to a QPixmap (to show in a QLabel) */
         QPixmap pixMap = QPixmap::fromImage(qimg);
@@ -119,7 +123,6 @@ void ResultsViewer::showTable(const int index)
         if(mLarvaeContainer.hasLoadedLarvae())
         {
             unsigned int nLarvae = mLarvaeContainer.getNumberOfLarvae();
-            Larva l;
             int nLandmarks = 0;
             QStringList landmarkNames;
             if( mScene->hasLandmarkContainer())
@@ -134,8 +137,10 @@ void ResultsViewer::showTable(const int index)
             QStandardItemModel *tableModel = new QStandardItemModel(nParameters,nLarvae,this);
             for (unsigned int cols = 0; cols < nLarvae; ++cols)
             {
-                if(mLarvaeContainer.getLarva(cols, l))
+                Larva const* larva = mLarvaeContainer.getLarvaAt(cols);
+                if(larva != nullptr)
                 {
+                    Larva const& l = *larva;
                     QString hHeader("fish(");
                     hHeader.append(QString::number(l.getID()));
                     hHeader.append(")");
@@ -196,8 +201,10 @@ void ResultsViewer::showTable(const int index)
             
             for (unsigned int cols = 0; cols < nLarvae; ++cols)
             {
-                if(mLarvaeContainer.getLarva(cols, l))
+                Larva const* larva = mLarvaeContainer.getLarvaAt(cols);
+                if(larva != nullptr)
                 {
+                    Larva const& l = *larva;
                     if (l.getMomentumAt(index,mom))
                     {
                         l.getAreaAt(index,area);
@@ -352,6 +359,8 @@ void ResultsViewer::resetAndClear()
     mPlayingModeOn = false;
     mTimer->stop();
     
+    // the background threads of the cache use the undistorter
+    mFrameCache.clear();
     mUndistorer.reset();
     
     loadAllResults();
@@ -459,6 +468,7 @@ void ResultsViewer::resetView()
 void ResultsViewer::loadAllResults()
 {
     resetView();
+    mFrameCache.clear();
     
     if(loadImageFiles()) 
     {
@@ -469,6 +479,12 @@ void ResultsViewer::loadAllResults()
             mScene->loadROIContainer(mYmlFileName);
             mScene->loadLandmarkContainer(mYmlFileName);
             initUndistorer();
+            
+            std::vector<std::string> framePaths;
+            QtOpencvCore::qstrList2strList(mFileNames, framePaths);
+            mFrameCache.reset(framePaths, &mUndistorer);
+            mLastFrameIndex = 0;
+            
             setupBaseGUIElements();
             setupLarvaeTabs();
             
@@ -499,14 +515,43 @@ bool ResultsViewer::loadImageFiles()
 
 bool ResultsViewer::loadYmlFile()
 {
-    mYmlFileName = QFileDialog::getOpenFileName(this, tr("Open Output File"), "", tr("YML File (*.yml)"));
+    mYmlFileName = QFileDialog::getOpenFileName(this, tr("Open Output File"), "", tr("Tracking Results (*.yml *.fimb);;YML File (*.yml);;Binary Results File (*.fimb)"));
     
     if (!mYmlFileName.isEmpty())
     {
+        // prefer an up-to-date binary results file next to the yml file; otherwise offer to create it for the next time
+        std::string resultsPath = QtOpencvCore::qstr2str(mYmlFileName);
+        std::string binaryPath;
+        if (!BinaryResultsReader::isBinaryResultsFile(resultsPath))
+        {
+            binaryPath = InputGenerator::getBinaryResultsPath(resultsPath);
+            QFileInfo binaryInfo(QtOpencvCore::str2qstr(binaryPath));
+            if (binaryInfo.exists() 
+                    && binaryInfo.lastModified() >= QFileInfo(mYmlFileName).lastModified()
+                    && BinaryResultsReader::isBinaryResultsFile(binaryPath))
+            {
+                mYmlFileName = binaryInfo.filePath();
+                binaryPath.clear();
+            }
+        }
+        
         mLarvaeContainer.readLarvae(mYmlFileName,
                                           mImgPaths,
                                           mUseUndist);
         
+        if (!binaryPath.empty() && !mImgPaths.empty() && mFileNames.size() == mImgPaths.size())
+        {
+            QMessageBox::StandardButton answer = QMessageBox::question(this, 
+                                                                       "Binary Results File", 
+                                                                       QString("Create the binary results file %1 for faster loading of these results?").arg(QtOpencvCore::str2qstr(binaryPath)),
+                                                                       QMessageBox::Yes | QMessageBox::No, 
+                                                                       QMessageBox::No);
+            if (answer == QMessageBox::Yes)
+            {
+                mLarvaeContainer.saveBinaryResults(resultsPath, binaryPath, mImgPaths, mUseUndist);
+            }
+        }
+        
         if(mFileNames.size() != mImgPaths.size())
         {
             QMessageBox messageBox;
@@ -738,18 +783,12 @@ void ResultsViewer::goOneTimeStepNext()
 
 void ResultsViewer::cropImage(uint larvaID)
 {
-    Larva l;
-    if (!mFileNames.empty() && mCurrentTimestep < mFileNames.size() && mLarvaeContainer.getLarvaByID(larvaID, l))
+    Larva const* larva = mLarvaeContainer.findLarva(larvaID);
+    if (!mFileNames.empty() && mCurrentTimestep < mFileNames.size() && larva != nullptr)
     {
-        /* get the selected image fileNames list */
-        cv::Mat img = cv::imread(QtOpencvCore::qstr2str(mFileNames.at(mCurrentTimestep)), 0);
-        
-        if(mUndistorer.isReady())
-        {
-            cv::Mat tmpImg;
-            mUndistorer.getUndistortImage(img,tmpImg);
-            tmpImg.copyTo(img);
-        }
+        Larva const& l = *larva;
+        /* the display-ready (undistorted RGB) frame is shared with the cache and must not be modified */
+        cv::Mat img = getFrame(mCurrentTimestep);
         
         mImageSize.setWidth(img.size().width);
         mImageSize.setHeight(img.size().height);
@@ -757,7 +796,7 @@ void ResultsViewer::cropImage(uint larvaID)
         
         cv::Point mom;        
         double spineLength = mLarvaeContainer.getMaxSpineLength();
-        if(spineLength > 0.0 && l.getMomentumAt(mCurrentTimestep, mom))
+        if(!img.empty() && spineLength > 0.0 && l.getMomentumAt(mCurrentTimestep, mom))
         {
             cv::Rect box;
             
@@ -777,12 +816,9 @@ void ResultsViewer::cropImage(uint larvaID)
             if(box.y + box.height > img.rows)
                 box.height = img.rows - box.y -1;
             
-            cv::Mat cImg = cv::Mat::zeros(img.size(), CV_8UC3);
-            cv::cvtColor(img,cImg,CV_GRAY2BGR);
-            
-            cImg = cImg(box);
+            cv::Mat cImg = img(box);
             
-            QImage qimg = QtOpencvCore::img2qimg(cImg);
+            QImage qimg((uchar*) cImg.data, cImg.cols, cImg.rows, cImg.step, QImage::Format_RGB888);
             emit sendCroppedImage(qimg);
         }   
     }
@@ -40,6 +40,7 @@
 
 #include "Configuration/FIMTrack.hpp"
 #include "Control/Undistorter.hpp"
+#include "Control/FrameCache.hpp"
 #include "Control/InputGenerator.hpp"
 #include "Control/LarvaeContainer.hpp"
 
@@ -126,6 +127,10 @@ private slots:
     void adjustPlottingValues(QString larvaID, int currentTimeStep);
     
 private:
+    /**
+     * @brief getFrame returns the display-ready frame at index from the cache and prefetches the following frames
+     */
+    cv::Mat getFrame(int const index);
     
     QSize                                   mImageSize;
     
@@ -152,6 +157,12 @@ private:
     QTimer*                                 mTimer;
     int                                     mZoomFactor;
     Undistorter                             mUndistorer;
+    /**
+     * @brief mFrameCache display-ready frames shared by showImage and cropImage (declared after mUndistorer,
+     *        since its background threads use the undistorter)
+     */
+    FrameCache                              mFrameCache;
+    int                                     mLastFrameIndex;
     LarvaeContainer                         mLarvaeContainer;
     
     bool                                    mPlottingTabVisible;
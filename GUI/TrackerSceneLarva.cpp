@@ -236,7 +236,7 @@ void TrackerSceneLarva::initLarvaDrawing()
 {
     this->mCurrentTime = 0;
     FIMTypes::spine_t spine;
-    std::vector<double> radii;
+    FIMTypes::radii_t radii;
     std::vector<unsigned int> timeSteps = this->mLarva->getAllTimeSteps();
     
     if(timeSteps.size() < 1)
@@ -275,7 +275,7 @@ void TrackerSceneLarva::updateLarvaDrawing(unsigned int time)
 {    
     this->mCurrentTime = time;
     FIMTypes::spine_t spine;
-    std::vector<double> radii;
+    FIMTypes::radii_t radii;
     
     if(!this->mLarva->getSpineAt(time, spine) || !this->mLarva->getSpineRadiiAt(time, radii))
     {
@@ -326,12 +326,12 @@ void TrackerSceneLarva::adjustCircles()
 }
 
 void TrackerSceneLarva::adjustLarvaContourAndSpine(FIMTypes::spine_t const& spine, 
-                                                   std::vector<double> const& radii)
+                                                   FIMTypes::radii_t const& radii)
 {
     /* Iterators */
     FIMTypes::spine_t::const_iterator                 spineIt         = spine.begin();
     FIMTypes::spine_t::const_iterator                 spineItEnd		= spine.end();	
-    std::vector<double>::const_iterator                 radiiIt         = radii.begin();
+    FIMTypes::radii_t::const_iterator                   radiiIt         = radii.begin();
     
     QPainterPath spinePath;    
     spinePath.moveTo(qreal(spineIt->x), qreal(spineIt->y));
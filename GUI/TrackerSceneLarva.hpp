@@ -110,9 +110,9 @@ public slots:
     
     QPolygonF getPoligon() const {return this->mSilhouette->polygon();}
     QPainterPath getSpine() const {return this->mSpine->path();}
-    std::vector<double> getSpineRadii() const 
+    FIMTypes::radii_t getSpineRadii() const 
     {
-        std::vector<double> radii;
+        FIMTypes::radii_t radii;
         for(unsigned int i = 0; i < this->mCircles.size(); ++i)
         {
             radii.push_back(this->mCircles.at(i)->rect().width() / 2);
@@ -133,7 +133,7 @@ private slots:
     void initLarvaDrawing();
     void updateLarvaDrawing(unsigned int time);
     void adjustCircles();
-    void adjustLarvaContourAndSpine(FIMTypes::spine_t const& spine, std::vector<double> const& radii);
+    void adjustLarvaContourAndSpine(FIMTypes::spine_t const& spine, FIMTypes::radii_t const& radii);
     void adjustSilhouette();
     void restoreVisibility();
     
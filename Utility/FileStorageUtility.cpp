@@ -78,9 +78,23 @@ void operator>>(cv::FileNode const& n, std::vector<cv::Point>& v)
         v.push_back(p);
     }
 }
+void operator>>(cv::FileNode const& n, FIMTypes::spine_t& s)
+{
+    for (cv::FileNodeIterator it = n.begin(); it != n.end(); ++it)
+    {
+        cv::Point p;
+        (*it) >> p;
+        s.push_back(p);
+    }
+}
+void operator>>(cv::FileNode const& n, FIMTypes::radii_t& r)
+{
+    std::vector<double> v;
+    n >> v;
+    r.assign(v.begin(), v.end());
+}
 void operator>>(cv::FileNode const & n, Larva & larva)
 {
-    std::map<unsigned int, Larva::ValuesType> parametersMap;
     int id;
     n["larvaID"] >> id;
     
@@ -118,16 +132,33 @@ void operator>>(cv::FileNode const & n, Larva & larva)
         (*vIt)["isLeftBended"] >> values.isLeftBended;
         (*vIt)["isRightBended"] >> values.isRightBended;
         (*vIt)["movementDirection"] >> values.movementDirection;
-        (*vIt)["distanceToLandmark"] >> values.distanceToLandmark;
-        (*vIt)["isInLandmark"] >> values.isInLandmark;
-        (*vIt)["bearinAngle"] >> values.bearinAngle;
+        
+        std::map<std::string, double> distanceToLandmark;
+        std::map<std::string, bool> isInLandmark;
+        std::map<std::string, double> bearinAngle;
+        (*vIt)["distanceToLandmark"] >> distanceToLandmark;
+        (*vIt)["isInLandmark"] >> isInLandmark;
+        (*vIt)["bearinAngle"] >> bearinAngle;
+        
+        for(std::map<std::string, double>::const_iterator it = distanceToLandmark.begin(); it != distanceToLandmark.end(); ++it)
+        {
+            std::map<std::string, bool>::const_iterator inIt = isInLandmark.find(it->first);
+            larva.setLandmarkDistanceAt(timeStep, LandmarkRegistry::registerLandmark(it->first), it->second, 
+                                        inIt != isInLandmark.end() && inIt->second);
+        }
+        for(std::map<std::string, double>::const_iterator it = bearinAngle.begin(); it != bearinAngle.end(); ++it)
+        {
+            larva.setLandmarkBearingAngleAt(timeStep, LandmarkRegistry::registerLandmark(it->first), it->second);
+        }
+        
         (*vIt)["velocity"] >> values.velosity;
         (*vIt)["acceleration"] >> values.acceleration;
+        (*vIt)["nearestNeighbourDist"] >> values.nearestNeighbourDist;
+        (*vIt)["neighbourCount"] >> values.neighbourCount;
         
-        parametersMap.insert(std::pair<unsigned int, Larva::ValuesType>(timeStep,values));
+        larva.setValuesAt(timeStep, values);
     }
     
-    larva.setParameters(parametersMap);
     larva.setNSpinePoints(nSpinePoints);
     
 }
@@ -144,6 +175,14 @@ cv::FileStorage& operator<<(cv::FileStorage& fs, std::vector<T> const& v)
     
     return fs;
 }
+cv::FileStorage& operator<<(cv::FileStorage& fs, FIMTypes::spine_t const& s)
+{
+    return fs << s.toStdVector();
+}
+cv::FileStorage& operator<<(cv::FileStorage& fs, FIMTypes::radii_t const& r)
+{
+    return fs << r.toStdVector();
+}
 template <typename K, typename V>
 cv::FileStorage& operator<<(cv::FileStorage& fs, std::map<K, V> const& m)
 {
@@ -160,44 +199,91 @@ cv::FileStorage& operator<<(cv::FileStorage& fs, std::map<K, V> const& m)
 }
 cv::FileStorage& operator<<(cv::FileStorage& fs, Larva const& larva)
 {
-    typedef std::map<unsigned int, Larva::ValuesType>::const_iterator mapIterType;
+    typedef Larva::ParameterMap::const_iterator mapIterType;
     
     int id = (int) larva.id;
     fs << "{" << "larvaID" << id;
     
     fs << "parameters" << "[";
+    Larva::ValuesType values;
     for (mapIterType it = larva.parameters.begin(); it != larva.parameters.end(); ++it)
     {
         fs << "{";
-        int timeStep = (int) it->first;
+        int timeStep = (int) *it;
         fs << "timeStep" << timeStep;
         fs << "values" << "[";
-        Larva::ValuesType values = it->second;
+        larva.getValuesAt(*it, values);
         fs << "{";
-        fs << "area" << values.area;
+        // spine, radii and momentum are always written (required by the results viewer)
+        if(FeatureParameters::isEnabled(FeatureParameters::AREA))
+            fs << "area" << values.area;
         fs << "spine" << values.spine;
         fs << "momentum" << values.momentum;
         fs << "spineRadii" << values.spineRadii;
-        fs << "mainBodyBendingAngle" << values.mainBodyBendingAngle;
-        fs << "spineLength" << values.spineLength;
-        fs << "perimeter" << values.perimeter;
-        fs << "isCoiled" << values.isCoiled;
-        fs << "isWellOriented" << values.isWellOriented;
-        fs << "distToOrigin" << values.distToOrigin;
-        fs << "momentumDist" << values.momentumDist;
-        fs << "accDist" << values.accDist;
-        fs << "goPhase" << values.goPhase;
-        fs << "isLeftBended" << values.isLeftBended;
-        fs << "isRightBended" << values.isRightBended;
-        fs << "movementDirection" << values.movementDirection;
-        fs << "velocity" << values.velosity;
-        fs << "acceleration" << values.acceleration;
-        if(!values.distanceToLandmark.empty())
-            fs << "distanceToLandmark" << values.distanceToLandmark;
-        if(!values.isInLandmark.empty())
-            fs << "isInLandmark" << values.isInLandmark;
-        if(!values.bearinAngle.empty())
-            fs << "bearinAngle" << values.bearinAngle;
+        if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+            fs << "mainBodyBendingAngle" << values.mainBodyBendingAngle;
+        if(FeatureParameters::isEnabled(FeatureParameters::SPINE))
+            fs << "spineLength" << values.spineLength;
+        if(FeatureParameters::isEnabled(FeatureParameters::PERIMETER))
+            fs << "perimeter" << values.perimeter;
+        if(FeatureParameters::isEnabled(FeatureParameters::COILED))
+            fs << "isCoiled" << values.isCoiled;
+        if(FeatureParameters::isEnabled(FeatureParameters::ORIENTATION))
+            fs << "isWellOriented" << values.isWellOriented;
+        if(FeatureParameters::isEnabled(FeatureParameters::DISTANCE_TO_ORIGIN))
+            fs << "distToOrigin" << values.distToOrigin;
+        if(FeatureParameters::isEnabled(FeatureParameters::MOMENTUM_DISTANCE))
+        {
+            fs << "momentumDist" << values.momentumDist;
+            fs << "accDist" << values.accDist;
+        }
+        if(FeatureParameters::isEnabled(FeatureParameters::GO_PHASE))
+            fs << "goPhase" << values.goPhase;
+        if(FeatureParameters::isEnabled(FeatureParameters::BENDING))
+        {
+            fs << "isLeftBended" << values.isLeftBended;
+            fs << "isRightBended" << values.isRightBended;
+        }
+        if(FeatureParameters::isEnabled(FeatureParameters::MOVEMENT_DIRECTION))
+            fs << "movementDirection" << values.movementDirection;
+        if(FeatureParameters::isEnabled(FeatureParameters::VELOCITY))
+        {
+            fs << "velocity" << values.velosity;
+            fs << "acceleration" << values.acceleration;
+        }
+        if(FeatureParameters::isEnabled(FeatureParameters::GROUP_BEHAVIOUR))
+        {
+            fs << "nearestNeighbourDist" << values.nearestNeighbourDist;
+            fs << "neighbourCount" << values.neighbourCount;
+        }
+        
+        // landmark related features are stored per landmark ID and written by name (as before)
+        std::map<std::string, double> distanceToLandmark;
+        std::map<std::string, bool> isInLandmark;
+        std::map<std::string, double> bearinAngle;
+        for(size_t landmarkID = 0; landmarkID < larva.landmarks.size(); ++landmarkID)
+        {
+            LandmarkSeries const& series = larva.landmarks.at(landmarkID);
+            if(series.empty())
+                continue;
+            
+            double value;
+            bool isIn;
+            std::string name = LandmarkRegistry::getName(static_cast<int>(landmarkID));
+            if(series.getDistance(timeStep, value) && series.getIsInLandmark(timeStep, isIn))
+            {
+                distanceToLandmark[name] = value;
+                isInLandmark[name] = isIn;
+            }
+            if(series.getBearingAngle(timeStep, value))
+                bearinAngle[name] = value;
+        }
+        if(!distanceToLandmark.empty())
+            fs << "distanceToLandmark" << distanceToLandmark;
+        if(!isInLandmark.empty())
+            fs << "isInLandmark" << isInLandmark;
+        if(!bearinAngle.empty())
+            fs << "bearinAngle" << bearinAngle;
         fs << "}";
         
         fs << "]";
@@ -41,8 +41,12 @@
 
 /// LARVA IN/OUTPUT
 cv::FileStorage& operator<<(cv::FileStorage& fs, Larva const& larva);
+cv::FileStorage& operator<<(cv::FileStorage& fs, FIMTypes::spine_t const& s);
+cv::FileStorage& operator<<(cv::FileStorage& fs, FIMTypes::radii_t const& r);
 
 void operator>>(cv::FileNode const& n, std::vector<cv::Point>& v);
+void operator>>(cv::FileNode const& n, FIMTypes::spine_t& s);
+void operator>>(cv::FileNode const& n, FIMTypes::radii_t& r);
 void operator>>(cv::FileNode const& n, cv::Point& p);
 void operator>>(cv::FileNode const & n, Larva & larva);
 
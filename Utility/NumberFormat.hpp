@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef NUMBERFORMAT_HPP
+#define NUMBERFORMAT_HPP
+
+#include <cstdio>
+#include <cmath>
+
+/**
+ * @brief Allocation-free number formatting for the text exports
+ *
+ * All functions write into a caller provided buffer of at least NumberFormat::maxLength characters
+ * and return the pointer behind the last written character (no terminating zero is written).
+ * The output equals the default formatting of std::ostream (i.e. %g with 6 significant digits)
+ * but never depends on the C locale, thus the decimal separator is always a point.
+ */
+namespace NumberFormat
+{
+    /**
+     * @brief maxLength minimal size of the buffers passed to the format functions
+     */
+    enum {maxLength = 32};
+
+    /**
+     * @brief formatInt writes the decimal representation of value to out
+     */
+    inline char* formatInt(long long const value, char* out)
+    {
+        unsigned long long v = (value < 0) ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+        char digits[24];
+        int n = 0;
+        do
+        {
+            digits[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while(v != 0);
+
+        if(value < 0)
+        {
+            *out++ = '-';
+        }
+        while(n > 0)
+        {
+            *out++ = digits[--n];
+        }
+        return out;
+    }
+
+    /**
+     * @brief formatBool writes 1 or 0 to out
+     */
+    inline char* formatBool(bool const value, char* out)
+    {
+        *out++ = value ? '1' : '0';
+        return out;
+    }
+
+    /**
+     * @brief formatDouble writes value to out like std::ostream does by default (%g, 6 significant digits)
+     */
+    inline char* formatDouble(double const value, char* out)
+    {
+        // integral values below 1e6 are printed without exponent and fraction by %g
+        double const absValue = std::fabs(value);
+        if(absValue < 1e6 && value == std::floor(value) && !(value == 0.0 && std::signbit(value)))
+        {
+            return formatInt(static_cast<long long>(value), out);
+        }
+
+        // %g never needs more than 16 characters (e.g. -1.23457e+308)
+        char buffer[maxLength];
+        int const n = std::sprintf(buffer, "%g", value);
+
+        // replace the (possibly multi-byte) locale dependent decimal separator by a point
+        bool inSeparator = false;
+        for(int i = 0; i < n; ++i)
+        {
+            char const c = buffer[i];
+            bool const isNumberChar = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                    || c == '-' || c == '+' || c == '#';
+            if(isNumberChar)
+            {
+                *out++ = c;
+                inSeparator = false;
+            }
+            else if(!inSeparator)
+            {
+                *out++ = '.';
+                inSeparator = true;
+            }
+        }
+        return out;
+    }
+}
+
+#endif // NUMBERFORMAT_HPP
@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * Copyright (c) 2011-2016 The FIMTrack Team as listed in CREDITS.txt        *
+ * http://fim.uni-muenster.de                                             	 *
+ *                                                                           *
+ * This file is part of FIMTrack.                                            *
+ * FIMTrack is available under multiple licenses.                            *
+ * The different licenses are subject to terms and condition as provided     *
+ * in the files specifying the license. See "LICENSE.txt" for details        *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * FIMTrack is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by      *
+ * the Free Software Foundation, either version 3 of the License, or         *
+ * (at your option) any later version. See "LICENSE-gpl.txt" for details.    *
+ *                                                                           *
+ * FIMTrack is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the              *
+ * GNU General Public License for more details.                              *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * For non-commercial academic use see the license specified in the file     *
+ * "LICENSE-academic.txt".                                                   *
+ *                                                                           *
+ *****************************************************************************
+ *                                                                           *
+ * If you are interested in other licensing models, including a commercial-  *
+ * license, please contact the author at fim@uni-muenster.de      			 *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef PARALLELFOR_HPP
+#define PARALLELFOR_HPP
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+
+namespace Parallel
+{
+    /**
+     * @brief numberOfThreads returns the number of threads used by parallelFor (at least 1)
+     */
+    inline unsigned int numberOfThreads()
+    {
+        unsigned int n = std::thread::hardware_concurrency();
+        return (n > 0) ? n : 1;
+    }
+
+    /**
+     * @brief parallelFor calls f(i) for every i in [0, n) distributed over all available cores.
+     *        Indices are handed out dynamically, thus f must only modify data belonging to index i.
+     *        The first exception thrown by f is rethrown in the calling thread after all workers finished.
+     *
+     * @param n number of indices
+     * @param f functor with signature void(size_t)
+     */
+    template<class Func>
+    void parallelFor(size_t const n, Func f)
+    {
+        size_t nThreads = std::min<size_t>(numberOfThreads(), n);
+        if(nThreads <= 1)
+        {
+            for(size_t i = 0; i < n; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto worker = [&]()
+        {
+            try
+            {
+                for(size_t i = next++; i < n; i = next++)
+                {
+                    f(i);
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if(!error)
+                {
+                    error = std::current_exception();
+                }
+                // stop handing out further indices
+                next = n;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for(size_t t = 1; t < nThreads; ++t)
+        {
+            threads.push_back(std::thread(worker));
+        }
+        worker();
+        for(size_t t = 0; t < threads.size(); ++t)
+        {
+            threads[t].join();
+        }
+
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif // PARALLELFOR_HPP
@@ -5,5 +5,7 @@ SOURCES += \
 
 HEADERS += \
     Utility/FileStorageUtility.hpp \
+    Utility/ParallelFor.hpp \
+    Utility/NumberFormat.hpp \
     Utility/qcustomplot.h \
     Utility/Plotter.hpp